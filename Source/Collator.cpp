@@ -0,0 +1,236 @@
+/**
+ *  Copyright (C) 2015-2019
+ *  Author Alvin Ahmadov <alvin.dev.ahmadov@gmail.com>
+ *
+ *  This file is part of Dixter Project
+ *  License-Identifier: MIT License
+ *  See README.md for more information.
+ */
+#include <map>
+#include <memory>
+#include <mutex>
+
+#include <unicode/uchar.h>
+#include <unicode/ustring.h>
+#include <unicode/utf16.h>
+
+#include "Collator.hpp"
+#include "Exception.hpp"
+#include "Transcoder.hpp"
+#include "Unicode.hpp"
+
+namespace Dixter
+{
+	namespace
+	{
+		/// Flag of upper case letters in ranks
+		constexpr UInt16 kUpper = 0x8000;
+		
+		/// Weights of letters of alphabet start here, ones below are of ASCII symbols
+		constexpr UInt32 kLetterWeight = 0x100;
+		
+		/// Weights of characters outside alphabet start here
+		constexpr UInt32 kOtherWeight = 0x10000;
+		
+		/// Case of characters, trailing lower case ones are left out of keys
+		constexpr TByte kLowerCase = 1;
+		
+		constexpr TByte kUpperCase = 2;
+		
+		inline bool isAsciiLetter(TCodePoint codePoint) noexcept
+		{
+			return ( codePoint | 0x20 ) >= 'a' and ( codePoint | 0x20 ) <= 'z';
+		}
+		
+		/**
+		 * Weights below 0x8000 take 2 bytes, others 3 with high bit set in first one,
+		 * so that bytes of weights compare as weights and never start with 0.
+		 */
+		inline void appendWeight(UInt32 weight, std::string& key)
+		{
+			if (weight < 0x8000)
+			{
+				key.push_back(static_cast<TByte>(weight >> 8));
+				key.push_back(static_cast<TByte>(weight));
+			}
+			else
+			{
+				key.push_back(static_cast<TByte>(0x80 | ( weight >> 16 )));
+				key.push_back(static_cast<TByte>(weight >> 8));
+				key.push_back(static_cast<TByte>(weight));
+			}
+		}
+		
+		/// Decodes code point of UTF-8 text, malformed sequences read as U+FFFD
+		inline TCodePoint next(const TByte*& position, const TByte* end) noexcept
+		{
+			TCodePoint __codePoint {};
+			const auto __length = Unicode::decodeUtf8(position, end, __codePoint);
+			if (not __length)
+			{
+				++position;
+				return Unicode::kReplacement;
+			}
+			position += __length;
+			return __codePoint;
+		}
+		
+		/// Decodes code point of UTF-16 text, unpaired surrogates read as U+FFFD
+		inline TCodePoint next(const char16_t*& position, const char16_t* end) noexcept
+		{
+			const TCodePoint __unit = *position++;
+			if (U16_IS_LEAD(__unit) and position != end and U16_IS_TRAIL(*position))
+				return static_cast<TCodePoint>(U16_GET_SUPPLEMENTARY(__unit, *position++));
+			return U16_IS_SURROGATE(__unit) ? Unicode::kReplacement : __unit;
+		}
+	} // anonymous namespace
+	
+	TCollator::TCollator() noexcept
+			: m_ranks(),
+			  m_first()
+	{ }
+	
+	TCollator::TCollator(TStringView languageId, const Unicode::TAlphabet& alphabet)
+			: m_ranks(),
+			  m_first()
+	{
+		if (not alphabet.getSize())
+			return;
+		
+		const auto [__first, __last] = std::minmax_element(alphabet.begin(), alphabet.end());
+		m_first = *__first;
+		m_ranks.assign(*__last - *__first + 1, 0);
+		
+		// letters of both cases are in alphabet, lower case of language pairs them
+		const TString __locale(languageId);
+		std::map<TCodePoint, UInt16> __ranks;
+		for (const auto __codePoint : alphabet)
+		{
+			auto& __rank = m_ranks[__codePoint - m_first];
+			if (__rank)
+				continue;
+			
+			UChar __letter[U16_MAX_LENGTH];
+			int32_t __length {};
+			U16_APPEND_UNSAFE(__letter, __length, __codePoint);
+			
+			UChar __lower[U16_MAX_LENGTH * 3];
+			UErrorCode __status = U_ZERO_ERROR;
+			const auto __lowerLength = u_strToLower(__lower, static_cast<int32_t>(std::size(__lower)),
+													__letter, __length, __locale.c_str(), &__status);
+			TCodePoint __folded = __codePoint;
+			if (U_SUCCESS(__status) and __lowerLength > 0)
+				U16_GET_UNSAFE(__lower, 0, __folded);
+			
+			const auto __found = __ranks.emplace(__folded, static_cast<UInt16>(__ranks.size() + 1)).first;
+			__rank = static_cast<UInt16>(__found->second | ( __folded != __codePoint ? kUpper : 0 ));
+		}
+	}
+	
+	const TCollator& TCollator::forLanguage(TStringView languageId)
+	{
+		const auto __alphabet = Unicode::findAlphabet(languageId);
+		if (not __alphabet)
+		{
+			throw TNotFoundException("%s:%d No alphabet to collate language \"%s\".",
+									 __FILE__, __LINE__, TString(languageId));
+		}
+		
+		static std::unique_ptr<TCollator> __collators[std::size(Unicode::kAlphabets)];
+		static std::once_flag __made[std::size(Unicode::kAlphabets)];
+		
+		const auto __index = static_cast<TSize>(__alphabet - std::begin(Unicode::kAlphabets));
+		std::call_once(__made[__index], [&]
+		{
+			__collators[__index] = std::make_unique<TCollator>(languageId, *__alphabet);
+		});
+		return *__collators[__index];
+	}
+	
+	const TCollator& TCollator::root() noexcept
+	{
+		static const TCollator __root;
+		return __root;
+	}
+	
+	template<typename TUnit>
+	void TCollator::appendKey(const TUnit* text, TSize length, std::string& key) const
+	{
+		const auto __end = text + length;
+		
+		// weight of code point, case goes to second level
+		const auto __weigh = [this](TCodePoint codePoint, bool& upper)
+		{
+			if (const auto __rank = rankOf(codePoint))
+			{
+				upper = __rank & kUpper;
+				return kLetterWeight + ( __rank & ~kUpper );
+			}
+			if (codePoint < 0x80 and not isAsciiLetter(codePoint))
+			{
+				upper = false;
+				return codePoint + 1;
+			}
+			
+			const auto __lower = static_cast<TCodePoint>(u_tolower(static_cast<UChar32>(codePoint)));
+			upper = __lower != codePoint;
+			if (const auto __rank = rankOf(__lower))
+				return kLetterWeight + ( __rank & ~kUpper );
+			return kOtherWeight + __lower;
+		};
+		
+		bool __upper {};
+		TSize __lastUpper {};
+		TSize __count {};
+		for (auto __position = text; __position != __end;)
+		{
+			appendWeight(__weigh(next(__position, __end), __upper), key);
+			++__count;
+			if (__upper)
+				__lastUpper = __count;
+		}
+		
+		// case level, empty for lower case strings
+		if (not __lastUpper)
+			return;
+		
+		key.append(2, '\0');
+		for (auto __position = text; __lastUpper--;)
+		{
+			__weigh(next(__position, __end), __upper);
+			key.push_back(__upper ? kUpperCase : kLowerCase);
+		}
+	}
+	
+	void TCollator::getSortKey(TStringView text, std::string& key) const
+	{
+		appendKey(text.data(), text.size(), key);
+	}
+	
+	void TCollator::getSortKey(std::u16string_view text, std::string& key) const
+	{
+		appendKey(text.data(), text.size(), key);
+	}
+	
+	std::string TCollator::getSortKey(TStringView text) const
+	{
+		std::string __key;
+		__key.reserve(text.size() * 2);
+		appendKey(text.data(), text.size(), __key);
+		return __key;
+	}
+	
+	Int32 TCollator::compare(TStringView first, TStringView second) const
+	{
+		return getSortKey(first).compare(getSortKey(second));
+	}
+	
+	Int32 TCollator::compare(std::u16string_view first, std::u16string_view second) const
+	{
+		std::string __firstKey;
+		std::string __secondKey;
+		appendKey(first.data(), first.size(), __firstKey);
+		appendKey(second.data(), second.size(), __secondKey);
+		return __firstKey.compare(__secondKey);
+	}
+}
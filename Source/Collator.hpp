@@ -0,0 +1,124 @@
+/**
+ *  Copyright (C) 2015-2019
+ *  Author Alvin Ahmadov <alvin.dev.ahmadov@gmail.com>
+ *
+ *  This file is part of Dixter Project
+ *  License-Identifier: MIT License
+ *  See README.md for more information.
+ */
+#pragma once
+
+#include <algorithm>
+#include <iterator>
+#include <numeric>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Types.hpp"
+
+namespace Dixter
+{
+	namespace Unicode
+	{
+		class TAlphabet;
+	}
+	
+	/**
+	 * \brief Orders strings by alphabet of language.
+	 *
+	 * Every string is turned once into binary sort key, and keys compare with
+	 * memcmp in order of alphabet: letters differing in case only are equal,
+	 * unless strings are equal otherwise, in which case lower case one comes first.
+	 * Digits, spaces and ASCII punctuation go before letters, characters outside
+	 * alphabet after them, by code point.
+	 * \code
+	 * const auto& __collator = TCollator::forLanguage("az");
+	 * __collator.sort(__words.begin(), __words.end(), [](const TU8String& word) { return word.view(); });
+	 * \endcode
+	 * */
+	class TCollator
+	{
+	public:
+		/// Orders letters by code point, ignoring case
+		TCollator() noexcept;
+		
+		/**
+		 * \brief Orders letters of alphabet as listed there. Upper and lower
+		 * case letters are paired by case mapping of language.
+		 * */
+		TCollator(TStringView languageId, const Unicode::TAlphabet& alphabet);
+		
+		/**
+		 * \brief Collator of language, made once on first use.
+		 * \throws TNotFoundException if language has no alphabet.
+		 * */
+		static const TCollator& forLanguage(TStringView languageId);
+		
+		/// Collator not bound to any alphabet
+		static const TCollator& root() noexcept;
+		
+		/// Appends sort key of UTF-8 text to key
+		void getSortKey(TStringView text, std::string& key) const;
+		
+		/// Appends sort key of UTF-16 text to key
+		void getSortKey(std::u16string_view text, std::string& key) const;
+		
+		std::string getSortKey(TStringView text) const;
+		
+		/**
+		 * \brief Compares by sort keys, prefer sort keys for comparing same strings many times.
+		 * \returns Negative, 0 or positive like strcmp
+		 * */
+		Int32 compare(TStringView first, TStringView second) const;
+		
+		Int32 compare(std::u16string_view first, std::u16string_view second) const;
+		
+		/**
+		 * \brief Sorts random access range, making sort key of every element once.
+		 * \param textOf Returns UTF-8 or UTF-16 text of element, as string view
+		 * */
+		template<typename TIterator, typename FTextOf>
+		void sort(TIterator first, TIterator last, FTextOf textOf, bool ascending = true) const
+		{
+			using TValue = typename std::iterator_traits<TIterator>::value_type;
+			
+			const auto __size = static_cast<TSize>(std::distance(first, last));
+			std::vector<std::string> __keys(__size);
+			auto __element = first;
+			for (auto& __key : __keys)
+				getSortKey(textOf(*__element++), __key);
+			
+			std::vector<TSize> __order(__size);
+			std::iota(__order.begin(), __order.end(), TSize {});
+			std::stable_sort(__order.begin(), __order.end(), [&](TSize left, TSize right)
+			{
+				return ascending ? __keys[left] < __keys[right] : __keys[right] < __keys[left];
+			});
+			
+			std::vector<TValue> __sorted;
+			__sorted.reserve(__size);
+			for (const auto __index : __order)
+				__sorted.push_back(std::move(*std::next(first, static_cast<std::ptrdiff_t>(__index))));
+			std::move(__sorted.begin(), __sorted.end(), first);
+		}
+	
+	private:
+		/// Appends weights of code points, followed by their case if any is upper
+		template<typename TUnit>
+		void appendKey(const TUnit* text, TSize length, std::string& key) const;
+		
+		/// Packed rank and case of code point, 0 for code points outside alphabet
+		UInt16 rankOf(TCodePoint codePoint) const noexcept
+		{
+			return codePoint >= m_first and codePoint - m_first < m_ranks.size() ? m_ranks[codePoint - m_first] : 0;
+		}
+	
+	private:
+		/// Rank in alphabet shifted by one, with kUpper for upper case letters
+		std::vector<UInt16> m_ranks;
+		
+		/// Code point of m_ranks.front()
+		TCodePoint m_first;
+	};
+}
@@ -459,6 +459,7 @@ namespace Dixter
 		{
 			TSelf::append<TString>(__pFmt.get(), __anyArg);
 			TSelf::append<TUString>(__pFmt.get(), __anyArg);
+			TSelf::append<TU8String>(__pFmt.get(), __anyArg);
 			TSelf::append<const
 				   TByte*>(__pFmt.get(), __anyArg);
 			TSelf::append<Int32>(__pFmt.get(), __anyArg);
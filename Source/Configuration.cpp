@@ -9,6 +9,11 @@
 
 #include <memory>
 #include <mutex>
+#include <tuple>
+#include <future>
+#include <fstream>
+#include <filesystem>
+#include <boost/filesystem.hpp>
 
 #include "Configuration.hpp"
 #include "Utilities.hpp"
@@ -16,10 +21,13 @@
 #include "Commons.hpp"
 #include "NodeEntry.hpp"
 #include "Constants.hpp"
+#include "ConfigurationCache.hpp"
+#include "XmlReader.hpp"
+#include "JsonReader.hpp"
+#include "ConfigurationWatcher.hpp"
 
 namespace Dixter
 {
-	namespace NStringUtils = Utilities::Strings;
 	#ifdef HAVE_CXX17
 	template<typename T>
 	using scoped_lock = std::scoped_lock<T>;
@@ -32,73 +40,554 @@ namespace Dixter
 	
 	static std::set<TString> g_settingsConfPath { g_guiConfigPath };
 	
-	TNodeData* xmlLoadHelper(const IConfiguration::PropertyTree& prop, const TString& parent, std::function<
-			TString(const TString&, const TUString&,
-					const TUString&, bool)
-	> fn)
+	/// Modification time of file in clock ticks, 0 if it can't be read
+	static Int64 modificationTime(const TString& path)
 	{
-		TNodeData* __configData(new TNodeData);
-		const TString __attributeKey("<xmlattr>");
-		TString __nodeName;
-		for (const auto& __node : prop)
+		// boost reports whole seconds, which misses edits within the second of last read
+		std::error_code __error {};
+		const auto __time = std::filesystem::last_write_time(path, __error);
+		return __error ? 0 : static_cast<Int64>(__time.time_since_epoch().count());
+	}
+	
+	/// Values of nodes by index of their data entry, name and order among nodes with that name
+	using TNodeMap = std::map<std::tuple<Int32, TString, TSize>, TU8String>;
+	
+	static TNodeMap flattenNodes(const IConfiguration::ConfigurationProperty& properties)
+	{
+		TNodeMap __nodes;
+		// every key of single file maps to the same configuration
+		const auto __snapshot = properties.empty() ? nullptr : properties.begin()->second->snapshot();
+		if (not __snapshot)
+			return __nodes;
+		
+		for (const auto& [__index, __data] : __snapshot->entries_)
+		{
+			std::unordered_map<TString, TSize> __occurrences;
+			for (const auto& __node : __data->getNodes())
+			{
+				TString __name(__data->name(__node));
+				const auto __occurrence = __occurrences[__name]++;
+				__nodes.emplace(std::make_tuple(__index, std::move(__name), __occurrence),
+								TU8String(__data->value(__node)));
+			}
+		}
+		return __nodes;
+	}
+	
+	static void diffNodes(const TString& path, const TNodeMap& before, const TNodeMap& after,
+						  TChangeList& changes)
+	{
+		auto __change = [&path, &changes](EChange change, const TNodeMap::key_type& key,
+										  const TU8String& oldValue, const TU8String& newValue)
+		{
+			changes.push_back({ change, path, std::get<0>(key), std::get<1>(key), oldValue, newValue });
+		};
+		
+		auto __old = before.begin();
+		auto __new = after.begin();
+		while (__old != before.end() or __new != after.end())
+		{
+			if (__new == after.end() or ( __old != before.end() and __old->first < __new->first ))
+			{
+				__change(EChange::Removed, __old->first, __old->second, TU8String());
+				++__old;
+			}
+			else if (__old == before.end() or __new->first < __old->first)
+			{
+				__change(EChange::Added, __new->first, TU8String(), __new->second);
+				++__new;
+			}
+			else
+			{
+				if (__old->second != __new->second)
+					__change(EChange::Changed, __old->first, __old->second, __new->second);
+				++__old;
+				++__new;
+			}
+		}
+	}
+	
+	/**
+	 * Builds configuration data from events of XML reader.
+	 *
+	 * Every child element of the root becomes a data entry, its leaf
+	 * descendants become nodes named by their path from the root, like
+	 * "languages.language.name". Attributes are kept with index of the node
+	 * following them.
+	 * */
+	class TXmlNodeBuilder final : public IXmlHandler
+	{
+	public:
+		void onStartElement(TStringView name, const TAttributeList& attributes) override
+		{
+			m_text.clear();
+			if (not m_leaves.empty())
+				m_leaves.back() = false;
+			m_leaves.push_back(true);
+			
+			if (m_leaves.size() == 1)
+			{
+				m_rootNode.assign(name);
+				m_path.assign(name);
+				return;
+			}
+			
+			m_lengths.push_back(m_path.size());
+			m_path.append(1, '.').append(name);
+			if (m_leaves.size() == 2)
+			{
+				m_data.reset(new TNodeData);
+				m_parent.assign(name);
+			}
+			
+			for (const auto& [__name, __value] : attributes)
+				m_data->insertAttribute(__name, __value, m_data->getNodes().size());
+		}
+		
+		void onText(TStringView text) override
+		{
+			m_text.append(text);
+		}
+		
+		void onEndElement(dxMAYBE_UNUSED TStringView name) override
 		{
-			auto __nodeValue = __node.second.get_value<TUString>();
-			// Not attribute
-			if (__node.first != __attributeKey)
+			if (m_leaves.size() > 1)
 			{
-				if (__node.second.size() > 0)
+				if (m_leaves.back())
+					m_data->insertNode(m_path, m_text, m_parent, m_data->getNodes().size());
+				
+				m_path.resize(m_lengths.back());
+				m_lengths.pop_back();
+				if (m_leaves.size() == 2)
+					m_entries.push_back(m_data.release());
+			}
+			m_leaves.pop_back();
+			m_text.clear();
+		}
+		
+		const TString& getRootNode() const noexcept
+		{
+			return m_rootNode;
+		}
+		
+		/// Built data, ownership is passed to caller
+		std::vector<TNodeData*> releaseEntries() noexcept
+		{
+			return std::move(m_entries);
+		}
+		
+		~TXmlNodeBuilder() noexcept override
+		{
+			for (auto __data : m_entries)
+				delete __data;
+		}
+	
+	private:
+		TString m_rootNode;
+		
+		/// Path of current element from root
+		TString m_path;
+		
+		/// Length of path before every open element
+		std::vector<TSize> m_lengths;
+		
+		/// Open elements having no child elements so far
+		std::vector<bool> m_leaves;
+		
+		TString m_parent;
+		
+		TString m_text;
+		
+		std::unique_ptr<TNodeData> m_data;
+		
+		std::vector<TNodeData*> m_entries;
+	};
+	
+	/**
+	 * Builds configuration data from events of JSON reader.
+	 *
+	 * Members of top level object are roots. Every value at depth of two
+	 * keys becomes a data entry, unless it is array, then its elements do.
+	 * Scalars of entry become nodes named by their path of keys, elements
+	 * of nested arrays share name of the array.
+	 * */
+	class TJsonNodeBuilder final : public IJsonHandler
+	{
+	public:
+		void onStartObject() override
+		{
+			enter(false);
+			m_containers.push_back(false);
+		}
+		
+		void onKey(TStringView key) override
+		{
+			m_key = key;
+		}
+		
+		void onEndObject() override
+		{
+			m_containers.pop_back();
+			leave();
+		}
+		
+		void onStartArray() override
+		{
+			enter(true);
+			m_containers.push_back(true);
+		}
+		
+		void onEndArray() override
+		{
+			m_containers.pop_back();
+			leave();
+		}
+		
+		void onValue(TStringView value, dxMAYBE_UNUSED EJsonType type) override
+		{
+			enter(false);
+			if (m_data)
+				m_data->insertNode(m_path, value, m_parent, m_data->getNodes().size());
+			leave();
+		}
+		
+		const TString& getRootNode() const noexcept
+		{
+			return m_rootNode;
+		}
+		
+		/// Built data, ownership is passed to caller
+		std::vector<TNodeData*> releaseEntries() noexcept
+		{
+			return std::move(m_entries);
+		}
+		
+		~TJsonNodeBuilder() noexcept override
+		{
+			for (auto __data : m_entries)
+				delete __data;
+		}
+	
+	private:
+		struct TFrame
+		{
+			TSize length_;
+			
+			TSize depth_;
+		};
+		
+		/// Starts value, named by pending key if it is object member
+		void enter(bool array)
+		{
+			m_frames.push_back({ m_path.size(), m_depth });
+			if (not m_containers.empty() and not m_containers.back())
+			{
+				if (not m_path.empty())
+					m_path.append(1, '.');
+				m_path.append(m_key);
+				++m_depth;
+				if (m_depth == 1 and m_rootNode.empty())
+					m_rootNode.assign(m_key);
+			}
+			
+			if (not array and not m_data and m_depth == 2)
+			{
+				m_data.reset(new TNodeData);
+				m_parent.assign(m_path, m_path.rfind('.') + 1, TString::npos);
+				m_dataFrame = m_frames.size();
+			}
+		}
+		
+		void leave()
+		{
+			if (m_data and m_frames.size() == m_dataFrame)
+				m_entries.push_back(m_data.release());
+			
+			m_path.resize(m_frames.back().length_);
+			m_depth = m_frames.back().depth_;
+			m_frames.pop_back();
+		}
+	
+	private:
+		TString m_rootNode;
+		
+		/// Path of current value from root
+		TString m_path;
+		
+		/// Number of keys in path
+		TSize m_depth {};
+		
+		TStringView m_key;
+		
+		/// Path and depth before every open value
+		std::vector<TFrame> m_frames;
+		
+		/// Open containers, true for arrays
+		std::vector<bool> m_containers;
+		
+		/// Frame of value being built into data
+		TSize m_dataFrame {};
+		
+		TString m_parent;
+		
+		std::unique_ptr<TNodeData> m_data;
+		
+		std::vector<TNodeData*> m_entries;
+	};
+	
+	/**
+	 * Writes configuration data as JSON, inverse of TJsonNodeBuilder.
+	 *
+	 * Nodes are arranged back into tree by their path, members sharing
+	 * name are written as array.
+	 * */
+	class TJsonWriter final
+	{
+	public:
+		explicit TJsonWriter(const TNodeEntry::TSnapshot& snapshot)
+		{
+			for (const auto& __entry : snapshot.entries_)
+			{
+				const auto& __nodes = __entry.second->getNodes();
+				if (__nodes.empty())
+					continue;
+				
+				const auto& __data = *__entry.second;
+				const auto __name = __data.name(__nodes.front());
+				const auto __rootEnd = __name.find('.');
+				auto& __root = child(m_tree, __name.substr(0, __rootEnd));
+				if (__rootEnd == TStringView::npos)
+					continue;
+				
+				const auto __parentEnd = __name.find('.', __rootEnd + 1);
+				const TString __parent(__name.substr(__rootEnd + 1, __parentEnd - __rootEnd - 1));
+				if (__parentEnd == TStringView::npos)
 				{
-					__nodeName = fn(__node.first, TUString(), TUString(), false);
-					for (const auto& __withAttr : __node.second)
-					{
-						auto __nodeNameTemp = __nodeName;
-						__nodeName = fn(__withAttr.first, TUString(), TUString(), true);
-						__configData->insertData(__nodeName, __withAttr.second.get_value<TUString>(), parent);
-						__nodeName = __nodeNameTemp;
-					}
+					// scalar entry
+					__root.children_.push_back({ __parent, TString(__data.value(__nodes.front())), true, {} });
+					continue;
 				}
-				else
+				
+				__root.children_.push_back({ __parent, {}, false, {} });
+				auto& __record = __root.children_.back();
+				const auto __prefix = __name.substr(0, __parentEnd + 1);
+				for (const auto& __node : __nodes)
 				{
-					__nodeName = fn(__node.first, TUString(), TUString(), false);
-					__configData->insertData(__nodeName, __nodeValue, parent);
+					const auto __nodeName = __data.name(__node);
+					if (__nodeName.compare(0, __prefix.size(), __prefix) != 0)
+						continue;
+					
+					auto* __element = &__record;
+					TSize __begin = __prefix.size();
+					for (auto __end = __nodeName.find('.', __begin); __end != TStringView::npos;
+						 __begin = __end + 1, __end = __nodeName.find('.', __begin))
+						__element = &child(*__element, __nodeName.substr(__begin, __end - __begin));
+					
+					__element->children_.push_back({ TString(__nodeName.substr(__begin)), TString(__data.value(__node)),
+													 true, {} });
 				}
 			}
-			else
+		}
+		
+		TString str() const
+		{
+			TString __out;
+			writeObject(__out, m_tree, 0);
+			__out.append(1, '\n');
+			return __out;
+		}
+	
+	private:
+		struct TElement
+		{
+			TString name_;
+			
+			TString value_;
+			
+			bool leaf_;
+			
+			std::vector<TElement> children_;
+		};
+		
+		/// Last object member with name, created if there is none
+		static TElement& child(TElement& parent, TStringView name)
+		{
+			for (auto __child = parent.children_.rbegin(); __child != parent.children_.rend(); ++__child)
+				if (not __child->leaf_ and __child->name_ == name)
+					return *__child;
+			
+			parent.children_.push_back({ TString(name), {}, false, {} });
+			return parent.children_.back();
+		}
+		
+		static void indent(TString& out, TSize level)
+		{
+			out.append(level * 4, ' ');
+		}
+		
+		static void writeString(TString& out, const TString& value)
+		{
+			out.append(1, '"');
+			for (const auto __c : value)
 			{
-				if (__node.second.size() > 1)
+				switch (__c)
 				{
-					xmlLoadHelper(__node.second, parent, fn);
+					case '"': out.append("\\\""); break;
+					case '\\': out.append("\\\\"); break;
+					case '\n': out.append("\\n"); break;
+					case '\r': out.append("\\r"); break;
+					case '\t': out.append("\\t"); break;
+					default:
+						if (static_cast<unsigned char>(__c) < 0x20)
+						{
+							const TByte __hex[] = "0123456789abcdef";
+							out.append("\\u00").append(1, __hex[__c >> 4]).append(1, __hex[__c & 0xF]);
+						}
+						else
+							out.append(1, __c);
 				}
+			}
+			out.append(1, '"');
+		}
+		
+		static bool isBare(const TString& value)
+		{
+			if (value == "true" or value == "false")
+				return true;
+			
+			if (value.empty())
+				return false;
+			
+			// JSON number: -?(0|[1-9]digits)(.digits)?([eE][+-]?digits)?
+			TSize __index = value[0] == '-' ? 1 : 0;
+			auto __digits = [&value, &__index]()
+			{
+				const auto __begin = __index;
+				while (__index < value.size() and value[__index] >= '0' and value[__index] <= '9')
+					++__index;
+				return __index - __begin;
+			};
+			const auto __first = __index;
+			const auto __integer = __digits();
+			if (__integer == 0 or ( __integer > 1 and value[__first] == '0' ))
+				return false;
+			
+			if (__index < value.size() and value[__index] == '.')
+			{
+				++__index;
+				if (__digits() == 0)
+					return false;
+			}
+			if (__index < value.size() and ( value[__index] == 'e' or value[__index] == 'E' ))
+			{
+				++__index;
+				if (__index < value.size() and ( value[__index] == '+' or value[__index] == '-' ))
+					++__index;
+				if (__digits() == 0)
+					return false;
+			}
+			return __index == value.size();
+		}
+		
+		static void writeValue(TString& out, const TElement& element, TSize level)
+		{
+			if (not element.leaf_)
+				writeObject(out, element, level);
+			else if (isBare(element.value_))
+				out.append(element.value_);
+			else
+				writeString(out, element.value_);
+		}
+		
+		/// Object of element's children, grouped by name in order of first appearance
+		static void writeObject(TString& out, const TElement& element, TSize level)
+		{
+			std::vector<TString> __names;
+			for (const auto& __child : element.children_)
+				if (std::find(__names.begin(), __names.end(), __child.name_) == __names.end())
+					__names.push_back(__child.name_);
+			
+			if (__names.empty())
+			{
+				out.append("{}");
+				return;
+			}
+			
+			out.append("{\n");
+			for (TSize __index {}; __index < __names.size(); ++__index)
+			{
+				std::vector<const TElement*> __members;
+				for (const auto& __child : element.children_)
+					if (__child.name_ == __names[__index])
+						__members.push_back(&__child);
+				
+				indent(out, level + 1);
+				writeString(out, __names[__index]);
+				out.append(": ");
+				if (__members.size() == 1)
+					writeValue(out, *__members.front(), level + 1);
 				else
 				{
-					__nodeName = fn(
-							__node.second.front().first, __node.second.front().first,
-							__node.second.front().second.get_value<TUString>(), false);
-					if (not __nodeValue.empty())
+					out.append("[\n");
+					for (TSize __member {}; __member < __members.size(); ++__member)
 					{
-						__configData->insertData(
-								__nodeName, __nodeValue, parent, __node.second.front().first,
-								__node.second.front().second.get_value<TUString>());
+						indent(out, level + 2);
+						writeValue(out, *__members[__member], level + 2);
+						out.append(__member + 1 < __members.size() ? ",\n" : "\n");
 					}
+					indent(out, level + 1);
+					out.append(1, ']');
 				}
+				out.append(__index + 1 < __names.size() ? ",\n" : "\n");
 			}
+			indent(out, level);
+			out.append(1, '}');
 		}
-		return __configData;
+	
+	private:
+		TElement m_tree { {}, {}, false, {} };
+	};
+	
+	// IConfiguration implementation
+	void IConfiguration::set(const TKeyHandle& key, const TU8String& value)
+	{
+		set(key.path(), value);
 	}
 	
-	TString xmlAttributeNameBuilder(const TUString& attributeName, const TUString& attributeValue)
+	void IConfiguration::get(const TKeyHandle& key, std::vector<TU8String>& values) const
 	{
-		static TString __rootNameWithAttr;
-		
-		if (not attributeValue.empty() and not attributeName.empty())
+		get(key.path(), values);
+	}
+	
+	TU8String IConfiguration::get(const TKeyHandle& key, const TU8String& byValue) const
+	{
+		return get(key.path(), byValue);
+	}
+	
+	TU8String IConfiguration::get(const TKeyHandle& key) const
+	{
+		return get(key.path());
+	}
+	
+	TNodeEntry::TSnapshotPtr IConfiguration::snapshot() const
+	{
+		return nullptr;
+	}
+	
+	void IConfiguration::select(TRecordSet& records) const
+	{
+		const auto __firstRow = records.rows();
+		for (TSize __column {}; __column < records.columns(); ++__column)
 		{
-			if (not __rootNameWithAttr.empty())
-				__rootNameWithAttr.clear();
-			__rootNameWithAttr.push_back('<');
-			__rootNameWithAttr.append(attributeValue.asUTF8()).push_back('>');
+			std::vector<TU8String> __values;
+			get(records.getFields()[__column], __values);
+			while (records.rows() < __firstRow + __values.size())
+				records.appendRow();
+			
+			// values are local, so record set stores its own copies
+			for (TSize __row {}; __row < __values.size(); ++__row)
+				records.setCell(__firstRow + __row, __column, TString(__values[__row].asUTF8()));
 		}
-		
-		return __rootNameWithAttr;
 	}
 	
 	// INIConfiguration implementation
@@ -106,7 +595,21 @@ namespace Dixter
 			: m_file(file),
 			  m_propertyTree(new PropertyTree),
 			  m_entries(new TNodeEntry)
+	{ }
+	
+	void TConfigurationINI::load()
 	{
+		TConfigurationCache __cache(m_file);
+		TString __rootNode;
+		std::vector<TNodeData*> __entries;
+		TConfigurationCache::TSourceStamp __stamp {};
+		const bool __stamped = __cache.stamp(__stamp);
+		if (__stamped and __cache.load(__stamp, __rootNode, __entries))
+		{
+			m_entries->insertEntries(__entries);
+			return;
+		}
+		
 		try
 		{
 			boost::property_tree::ini_parser::read_ini<PropertyTree>(m_file, *m_propertyTree);
@@ -114,17 +617,18 @@ namespace Dixter
 		catch (std::exception& e)
 		{
 			printerr(e.what())
+			return;
 		}
-	}
-	
-	void TConfigurationINI::load()
-	{
+		
 		TNodeData* __configData(new TNodeData);
 		
 		for (const auto& __node : *m_propertyTree)
-			__configData->insertData(__node.first, __node.second.get_value<TUString>());
+			__configData->insertData(__node.first, __node.second.get_value<TString>());
 		
 		m_entries->insertEntry(__configData);
+		if (__stamped)
+			__cache.save(__rootNode, *m_entries->snapshot(), __stamp);
+		m_propertyTree->clear();
 	}
 	
 	void TConfigurationINI::save()
@@ -132,86 +636,110 @@ namespace Dixter
 		println("Not implemented yet")
 	}
 	
-	void TConfigurationINI::set(const TString& key, const TUString& value)
+	void TConfigurationINI::set(const TString& key, const TU8String& value)
 	{
 		m_entries->setEntry(key, value);
 	}
 	
 	void TConfigurationINI::keys(std::list<TString>& keyList) const
 	{
-		for (auto& __treeKey : *m_propertyTree)
-			keyList.push_back(__treeKey.first);
+		const auto __snapshot = m_entries->snapshot();
+		for (const auto& __data : __snapshot->entries_)
+			for (const auto& __node : __data.second->getNodes())
+				keyList.emplace_back(__data.second->name(__node));
 	}
 	
 	void TConfigurationINI::get(const TString& key,
-								std::vector<TUString>& values) const
+								std::vector<TU8String>& values) const
 	{
-		for (const auto& __data : *m_entries)
+		const auto __snapshot = m_entries->snapshot();
+		for (const auto& __data : __snapshot->entries_)
 			__data.second->getValues(key, values);
 	}
 	
-	TUString
+	TU8String
 	TConfigurationINI::get(const TString& key,
-						   dxMAYBE_UNUSED const TUString& byValue) const
+						   dxMAYBE_UNUSED const TU8String& byValue) const
 	{
 		return get(key);
 	}
 	
-	TUString
+	TU8String
 	TConfigurationINI::get(const TString& key) const
 	{
-		return m_entries->findEntry(key)->m_value;
+		return m_entries->findValue(key);
+	}
+	
+	void TConfigurationINI::set(const TKeyHandle& key, const TU8String& value)
+	{
+		m_entries->setEntry(key, value);
+	}
+	
+	void TConfigurationINI::get(const TKeyHandle& key, std::vector<TU8String>& values) const
+	{
+		const auto __snapshot = m_entries->snapshot();
+		for (const auto& __data : __snapshot->entries_)
+			__data.second->getValues(key, values);
+	}
+	
+	TU8String
+	TConfigurationINI::get(const TKeyHandle& key, dxMAYBE_UNUSED const TU8String& byValue) const
+	{
+		return get(key);
+	}
+	
+	TU8String
+	TConfigurationINI::get(const TKeyHandle& key) const
+	{
+		return m_entries->findValue(key);
+	}
+	
+	void TConfigurationINI::select(TRecordSet& records) const
+	{
+		m_entries->select(records);
+	}
+	
+	TNodeEntry::TSnapshotPtr TConfigurationINI::snapshot() const
+	{
+		return m_entries->snapshot();
 	}
 	
 	// TConfigurationXML implementation
 	TConfigurationXML::TConfigurationXML(const TString& file) noexcept
 			: m_file(file),
-			  m_entries(new TNodeEntry),
-			  m_propertyTree(new PropertyTree)
-	{
-		try
-		{
-			boost::property_tree::xml_parser::read_xml<PropertyTree>(m_file, *m_propertyTree);
-		}
-		catch (std::exception& e)
-		{
-			printerr("Error reading XML: " << e.what())
-			return;
-		}
-	}
+			  m_entries(new TNodeEntry)
+	{ }
 	
 	void TConfigurationXML::load()
 	{
 		std::lock_guard<std::mutex> __lg(m_mutex);
 		
-		TString __parent;
-		m_rootNode = m_propertyTree->front().first;
-		const auto& __rootNodeName = m_propertyTree->front().first;
-		const auto& __childTree = m_propertyTree->front().second;
-		
-		auto __f_createNodeName = [ &__parent, &__rootNodeName ]
-				(const TString& node, const TUString& attributeName = TUString(),
-				 const TUString& attributeVal = TUString(), bool child = false)
+		TConfigurationCache __cache(m_file);
+		std::vector<TNodeData*> __entries;
+		TConfigurationCache::TSourceStamp __stamp {};
+		const bool __stamped = __cache.stamp(__stamp);
+		if (__stamped and __cache.load(__stamp, m_rootNode, __entries))
 		{
-			static TString __nodeName {};
-			if (not child)
-			{
-				__nodeName.clear();
-				NStringUtils::buildPath(__nodeName, '.', __rootNodeName, __parent);
-				NStringUtils::buildPath(__nodeName, '.', xmlAttributeNameBuilder(attributeName, attributeVal), node);
-			}
-			else
-				NStringUtils::buildPath(__nodeName, '.', node);
-			
-			return __nodeName;
-		};
+			m_entries->insertEntries(__entries);
+			return;
+		}
 		
-		for (const auto& __value : __childTree)
+		TXmlNodeBuilder __builder;
+		try
 		{
-			__parent.clear();
-			__parent = __value.first;
-			m_entries->insertEntry(xmlLoadHelper(__value.second, __parent, __f_createNodeName));
+			TXmlReader(__builder).parseFile(m_file);
 		}
+		catch (TException& e)
+		{
+			printerr("Error reading XML: " << e.what())
+			return;
+		}
+		
+		m_rootNode = __builder.getRootNode();
+		__entries = __builder.releaseEntries();
+		m_entries->insertEntries(__entries);
+		if (__stamped)
+			__cache.save(m_rootNode, *m_entries->snapshot(), __stamp);
 	}
 	
 	void TConfigurationXML::save()
@@ -219,7 +747,7 @@ namespace Dixter
 		throw TNotImplementedException("%s:d% Saving XML configuration not implemented yet", __FILE__, __LINE__);
 	}
 	
-	void TConfigurationXML::set(const TString& key, const TUString& value)
+	void TConfigurationXML::set(const TString& key, const TU8String& value)
 	{
 		m_entries->setEntry(key, value);
 	}
@@ -229,76 +757,199 @@ namespace Dixter
 		keyList.push_back(m_rootNode);
 	}
 	
-	TUString TConfigurationXML::get(const TString& key) const
+	TU8String TConfigurationXML::get(const TString& key) const
 	{
-		return m_entries->findEntry(key)->m_value;
+		return m_entries->findValue(key);
 	}
 	
-	TUString TConfigurationXML::get(const TString& key, const TUString& neighborValue) const
+	TU8String TConfigurationXML::get(const TString& key, const TU8String& neighborValue) const
 	{
-		for (const auto& __confData : *m_entries)
-		{
-			for (const auto& __node : __confData.second->getNodes())
-			{
-				if (__node->m_value.compare(neighborValue) == 0)
-					return m_entries->findEntryData(__confData.first)->getValue(key);
-			}
-		}
+		const auto __index = m_entries->findEntryIndex(neighborValue);
+		if (__index < 0)
+			throw TNotFoundException("%s:%d No node with value %s.", __FILE__, __LINE__, neighborValue);
+		
+		return m_entries->findEntryData(__index)->getValue(key);
 	}
 	
-	void TConfigurationXML::get(const TString& key, std::vector<TUString>& values) const
+	void TConfigurationXML::get(const TString& key, std::vector<TU8String>& values) const
 	{
-		for (const auto& __data : *m_entries)
+		const auto __snapshot = m_entries->snapshot();
+		for (const auto& __data : __snapshot->entries_)
 			__data.second->getValues(key, values);
 	}
 	
+	void TConfigurationXML::set(const TKeyHandle& key, const TU8String& value)
+	{
+		m_entries->setEntry(key, value);
+	}
+	
+	void TConfigurationXML::get(const TKeyHandle& key, std::vector<TU8String>& values) const
+	{
+		const auto __snapshot = m_entries->snapshot();
+		for (const auto& __data : __snapshot->entries_)
+			__data.second->getValues(key, values);
+	}
+	
+	TU8String TConfigurationXML::get(const TKeyHandle& key) const
+	{
+		return m_entries->findValue(key);
+	}
+	
+	void TConfigurationXML::select(TRecordSet& records) const
+	{
+		m_entries->select(records);
+	}
+	
+	TNodeEntry::TSnapshotPtr TConfigurationXML::snapshot() const
+	{
+		return m_entries->snapshot();
+	}
+	
+	TU8String TConfigurationXML::get(const TKeyHandle& key, const TU8String& neighborValue) const
+	{
+		const auto __index = m_entries->findEntryIndex(neighborValue);
+		if (__index < 0)
+			throw TNotFoundException("%s:%d No node with value %s.", __FILE__, __LINE__, neighborValue);
+		
+		return m_entries->findEntryData(__index)->getValue(key);
+	}
+	
 	// TConfigurationJSON implementation
-	TConfigurationJSON::TConfigurationJSON(const Dixter::TString& file) noexcept
+	TConfigurationJSON::TConfigurationJSON(const TString& file) noexcept
 			: m_file(file),
-			  m_rootNode(),
-			  m_entries(new TNodeEntry),
-			  m_propertyTree(new PropertyTree)
+			  m_entries(new TNodeEntry)
+	{ }
+	
+	void TConfigurationJSON::load()
 	{
+		std::lock_guard<std::mutex> __lg(m_mutex);
+		
+		TConfigurationCache __cache(m_file);
+		TString __rootNode;
+		std::vector<TNodeData*> __entries;
+		TConfigurationCache::TSourceStamp __stamp {};
+		const bool __stamped = __cache.stamp(__stamp);
+		if (__stamped and __cache.load(__stamp, __rootNode, __entries))
+		{
+			m_entries->insertEntries(__entries);
+			return;
+		}
+		
+		TJsonNodeBuilder __builder;
 		try
 		{
-			boost::property_tree::json_parser::read_json<PropertyTree>(file, *m_propertyTree);
-		} catch (std::exception& e)
+			TJsonReader(__builder).parseFile(m_file);
+		}
+		catch (TException& e)
 		{
-			printerr(e.what())
+			printerr("Error reading JSON: " << e.what())
+			return;
 		}
-	};
+		
+		__entries = __builder.releaseEntries();
+		m_entries->insertEntries(__entries);
+		if (__stamped)
+			__cache.save(__builder.getRootNode(), *m_entries->snapshot(), __stamp);
+	}
 	
-	void TConfigurationJSON::load()
+	void TConfigurationJSON::save()
 	{
-		printl_log("")
+		namespace NFileSystem = boost::filesystem;
+		
+		std::lock_guard<std::mutex> __lg(m_mutex);
+		const auto __document = TJsonWriter(*m_entries->snapshot()).str();
+		
+		// written aside and renamed, so a reader never sees partial file
+		const auto __temporary = m_file + ".tmp";
+		{
+			std::ofstream __file(__temporary, std::ios::binary | std::ios::trunc);
+			if (not __file.write(__document.data(), static_cast<std::streamsize>(__document.size())))
+				throw TException("Can't write \"" + __temporary + "\".");
+		}
+		
+		boost::system::error_code __error {};
+		NFileSystem::rename(__temporary, m_file, __error);
+		if (__error)
+		{
+			NFileSystem::remove(__temporary, __error);
+			throw TException("Can't replace \"" + m_file + "\".");
+		}
 	}
 	
+	void TConfigurationJSON::set(const TString& key, const TU8String& value)
+	{
+		m_entries->setEntry(key, value);
+	}
 	
-	void TConfigurationJSON::save()
+	void TConfigurationJSON::keys(std::list<TString>& keyList) const
 	{
-		printl_log("")
+		const auto __snapshot = m_entries->snapshot();
+		std::set<TString> __roots;
+		for (const auto& __data : __snapshot->entries_)
+			for (const auto& __node : __data.second->getNodes())
+			{
+				const auto __name = __data.second->name(__node);
+				TString __root(__name.substr(0, __name.find('.')));
+				if (__roots.insert(__root).second)
+					keyList.push_back(std::move(__root));
+			}
 	}
 	
-	void TConfigurationJSON::keys(std::list<TString>&) const
+	void TConfigurationJSON::get(const TString& key, std::vector<TU8String>& values) const
 	{
-		printl_log("")
+		const auto __snapshot = m_entries->snapshot();
+		for (const auto& __data : __snapshot->entries_)
+			__data.second->getValues(key, values);
 	}
 	
-	void TConfigurationJSON::get(const TString&, std::vector<TUString>&) const
+	TU8String TConfigurationJSON::get(const TString& key) const
 	{
+		return m_entries->findValue(key);
+	}
 	
+	TU8String TConfigurationJSON::get(const TString& key, const TU8String& neighborValue) const
+	{
+		const auto __index = m_entries->findEntryIndex(neighborValue);
+		if (__index < 0)
+			throw TNotFoundException("%s:%d No node with value %s.", __FILE__, __LINE__, neighborValue);
+		
+		return m_entries->findEntryData(__index)->getValue(key);
 	}
 	
-	TUString 
-	TConfigurationJSON::get(const TString&) const 
+	void TConfigurationJSON::set(const TKeyHandle& key, const TU8String& value)
 	{
-		printl_log("")
+		m_entries->setEntry(key, value);
 	}
 	
-	TUString 
-	TConfigurationJSON::get(const TString&, const TUString&) const
+	void TConfigurationJSON::get(const TKeyHandle& key, std::vector<TU8String>& values) const
 	{
-		printl_log("")
+		const auto __snapshot = m_entries->snapshot();
+		for (const auto& __data : __snapshot->entries_)
+			__data.second->getValues(key, values);
+	}
+	
+	TU8String TConfigurationJSON::get(const TKeyHandle& key) const
+	{
+		return m_entries->findValue(key);
+	}
+	
+	TU8String TConfigurationJSON::get(const TKeyHandle& key, const TU8String& neighborValue) const
+	{
+		const auto __index = m_entries->findEntryIndex(neighborValue);
+		if (__index < 0)
+			throw TNotFoundException("%s:%d No node with value %s.", __FILE__, __LINE__, neighborValue);
+		
+		return m_entries->findEntryData(__index)->getValue(key);
+	}
+	
+	void TConfigurationJSON::select(TRecordSet& records) const
+	{
+		m_entries->select(records);
+	}
+	
+	TNodeEntry::TSnapshotPtr TConfigurationJSON::snapshot() const
+	{
+		return m_entries->snapshot();
 	}
 	
 	
@@ -356,16 +1007,16 @@ namespace Dixter
 			: m_manager(manager)
 	{ }
 	
-	TUString
+	TU8String
 	TConfigurationManager::
 	TAccessor::getValue(const TString& key, const TString& root) const
 	{
 		return this->get(key, root)->get(key);
 	}
 	
-	TUString
+	TU8String
 	TConfigurationManager::
-	TAccessor::getValue(const TString& key, const TUString& byValue,
+	TAccessor::getValue(const TString& key, const TU8String& byValue,
 						const TString& root) const
 	{
 		return this->get(key, root)->get(key, byValue);
@@ -373,21 +1024,57 @@ namespace Dixter
 	
 	const TConfigurationManager::TAccessor*
 	TConfigurationManager::
-	TAccessor::getValues(const TString& key, std::vector<TUString>& values, const TString& root) const
+	TAccessor::getValues(const TString& key, std::vector<TU8String>& values, const TString& root) const
 	{
 		this->get(key, root)->get(key, values);
 		return this;
 	}
 	
+	TU8String
+	TConfigurationManager::
+	TAccessor::getValue(const TKeyHandle& key, const TString& root) const
+	{
+		return this->get(key.path(), root)->get(key);
+	}
+	
+	TU8String
+	TConfigurationManager::
+	TAccessor::getValue(const TKeyHandle& key, const TU8String& byValue,
+						const TString& root) const
+	{
+		return this->get(key.path(), root)->get(key, byValue);
+	}
+	
+	const TConfigurationManager::TAccessor*
+	TConfigurationManager::
+	TAccessor::getValues(const TKeyHandle& key, std::vector<TU8String>& values, const TString& root) const
+	{
+		this->get(key.path(), root)->get(key, values);
+		return this;
+	}
+	
+	const TConfigurationManager::TAccessor*
+	TConfigurationManager::
+	TAccessor::select(TRecordSet& records, const TString& root) const
+	{
+		if (root.empty() and not records.columns())
+			throw TIllegalArgumentException("%s:%d Neither root nor fields to select.", __FILE__, __LINE__);
+		
+		if (not root.empty())
+			this->get(root)->select(records);
+		else
+		{
+			const auto& __path = records.getFields().front().path();
+			this->get(__path.substr(0, __path.find('.')))->select(records);
+		}
+		return this;
+	}
+	
 	std::shared_ptr<IConfiguration>
 	TConfigurationManager::
 	TAccessor::get(const TString& key, const TString& root) const
 	{
-		auto __iter = m_manager->m_properties.find(root.empty() ? key : root);
-		snprintfm(__msg, "Key \"%s\" not found", key.data());
-		m_manager->checkKey(__iter, __msg.get());
-		
-		return __iter->second;
+		return m_manager->find(root.empty() ? key : root);
 	}
 	
 	///ConfigurationManager::TMutator implementation
@@ -398,30 +1085,216 @@ namespace Dixter
 	
 	const TConfigurationManager::TMutator*
 	TConfigurationManager::
-	TMutator::setValue(const TString& key, const TUString& value, const TString& root)
+	TMutator::setValue(const TString& key, const TU8String& value, const TString& root)
 	{
-		scoped_lock<std::mutex> lockGuard(m_mutex);
 		this->get(key, root)->set(key, value);
 		return this;
 	}
 	
+	const TConfigurationManager::TMutator*
+	TConfigurationManager::
+	TMutator::setValue(const TKeyHandle& key, const TU8String& value, const TString& root)
+	{
+		this->get(key.path(), root)->set(key, value);
+		return this;
+	}
+	
 	std::shared_ptr<IConfiguration>
 	TConfigurationManager::
 	TMutator::get(const TString& key, const TString& root)
 	{
-		auto __iter = m_manager->m_properties.find(root.empty() ? key : root);
-		snprintfm(__msg, "Key \"%s\" not found", key.data());
-		m_manager->checkKey(__iter, __msg.get());
-		
-		return __iter->second;
+		return m_manager->find(root.empty() ? key : root);
 	}
 	
 	///ConfigurationManager implementation
 	TConfigurationManager::TInstancePtr&
 	TConfigurationManager::getManager(EConfiguration type, std::set<TString> paths)
 	{
-		m_instance.reset(new TSelf(type, ( paths.empty() ? g_confPath : paths )));
-		return m_instance;
+		if (paths.empty())
+			paths = g_confPath;
+		
+		TInstancePtr* __instance {};
+		TInstancePtr __modified {};
+		{
+			scoped_lock<std::mutex> __lockGuard(s_registryMutex);
+			__instance = &s_registry[{ type, paths }];
+			if (not *__instance)
+				__instance->reset(new TSelf(type, paths));
+			else
+				__modified = *__instance;
+		}
+		
+		// reloaded without registry lock, subscribers it notifies may get managers too
+		if (__modified)
+			for (const auto& __path : __modified->modifiedPaths())
+				__modified->reload(__path);
+		
+		return *__instance;
+	}
+	
+	bool TConfigurationManager::reload()
+	{
+		std::map<TString, IConfiguration::ConfigurationProperty> __sources {};
+		std::map<TString, Int64> __modified {};
+		TChangeList __changes;
+		{
+			scoped_lock<std::mutex> __lockGuard(m_mutex);
+			try
+			{
+				for (const auto& __path : m_paths)
+					__modified.emplace(__path, modificationTime(__path));
+				this->readAll(__sources);
+			}
+			catch (TException& e)
+			{
+				printerr(e.getMessage())
+				return false;
+			}
+			
+			for (auto& [__path, __properties] : __sources)
+			{
+				auto& __source = m_sources[__path];
+				diffNodes(__path, flattenNodes(__source), flattenNodes(__properties), __changes);
+				__source.swap(__properties);
+			}
+			m_modified.swap(__modified);
+			publish();
+		}
+		notify(__changes);
+		return not __changes.empty();
+	}
+	
+	bool TConfigurationManager::reload(const TString& path)
+	{
+		if (not m_paths.count(path))
+			return false;
+		
+		TChangeList __changes;
+		{
+			scoped_lock<std::mutex> __lockGuard(m_mutex);
+			const auto __time = modificationTime(path);
+			if (not __time)
+				return false;
+			
+			IConfiguration::ConfigurationProperty __properties {};
+			try
+			{
+				this->read(m_type, path, __properties);
+			}
+			catch (TException& e)
+			{
+				printerr(e.getMessage())
+				return false;
+			}
+			
+			auto& __source = m_sources[path];
+			const auto __before = flattenNodes(__source);
+			const auto __after = flattenNodes(__properties);
+			// loaders report malformed files and come up empty, keep what was read before
+			if (__after.empty() and not __before.empty())
+			{
+				printerr("Nothing read from \"" << path << "\", keeping previous data")
+				return false;
+			}
+			
+			diffNodes(path, __before, __after, __changes);
+			__source.swap(__properties);
+			m_modified[path] = __time;
+			publish();
+		}
+		notify(__changes);
+		return not __changes.empty();
+	}
+	
+	bool TConfigurationManager::isModified() const
+	{
+		return not modifiedPaths().empty();
+	}
+	
+	std::set<TString> TConfigurationManager::modifiedPaths() const
+	{
+		std::set<TString> __paths;
+		scoped_lock<std::mutex> __lockGuard(m_mutex);
+		for (const auto& [__path, __time] : m_modified)
+			if (modificationTime(__path) != __time)
+				__paths.insert(__path);
+		
+		return __paths;
+	}
+	
+	bool TConfigurationManager::watch()
+	{
+		unwatch();
+		auto __watcher = TConfigurationWatcher::instance();
+		std::vector<UInt32> __watches;
+		for (const auto& __path : m_paths)
+		{
+			// watcher reports absolute path, reload by path as manager knows it
+			const auto __id = __watcher->watch(__path, [ this, __path ](const TString&)
+			{
+				this->reload(__path);
+			});
+			if (__id)
+				__watches.push_back(__id);
+		}
+		
+		scoped_lock<std::mutex> __lockGuard(m_subscriberMutex);
+		m_watcher = std::move(__watcher);
+		m_watches = std::move(__watches);
+		return not m_watches.empty();
+	}
+	
+	void TConfigurationManager::unwatch()
+	{
+		std::vector<UInt32> __watches;
+		std::shared_ptr<TConfigurationWatcher> __watcher;
+		{
+			scoped_lock<std::mutex> __lockGuard(m_subscriberMutex);
+			__watches.swap(m_watches);
+			__watcher = m_watcher;
+		}
+		// not under lock, unwatch waits for running reload which notifies subscribers
+		for (const auto __id : __watches)
+			__watcher->unwatch(__id);
+	}
+	
+	TConfigurationManager::TSubscriberId
+	TConfigurationManager::subscribe(TSubscriber subscriber)
+	{
+		scoped_lock<std::mutex> __lockGuard(m_subscriberMutex);
+		const auto __id = m_nextSubscriber++;
+		m_subscribers.emplace(__id, std::move(subscriber));
+		return __id;
+	}
+	
+	void TConfigurationManager::unsubscribe(TSubscriberId id)
+	{
+		scoped_lock<std::mutex> __lockGuard(m_subscriberMutex);
+		m_subscribers.erase(id);
+	}
+	
+	void TConfigurationManager::notify(const TChangeList& changes) const
+	{
+		if (changes.empty())
+			return;
+		
+		std::vector<TSubscriber> __subscribers;
+		{
+			scoped_lock<std::mutex> __lockGuard(m_subscriberMutex);
+			for (const auto& __subscriber : m_subscribers)
+				__subscribers.push_back(__subscriber.second);
+		}
+		for (const auto& __subscriber : __subscribers)
+		{
+			try
+			{
+				__subscriber(changes);
+			}
+			catch (std::exception& e)
+			{
+				printerr(e.what())
+			}
+		}
 	}
 	
 	const TConfigurationManager::TAccessorPtr&
@@ -444,25 +1317,78 @@ namespace Dixter
 	
 	TConfigurationManager::TConfigurationManager(EConfiguration type,
 												 const std::set<TString>& paths)
-			: m_paths(paths),
+			: m_type(type),
+			  m_paths(paths),
+			  m_modified(),
+			  m_sources(),
 			  m_properties(),
 			  m_accessor(new TAccessor(this)),
-			  m_mutator( new TMutator(this))
+			  m_mutator( new TMutator(this)),
+			  m_watcher(),
+			  m_watches(),
+			  m_subscribers(),
+			  m_nextSubscriber(1)
 	{
+		scoped_lock<std::mutex> __lockGuard(m_mutex);
 		for (const auto& path : paths)
-			this->read(type, path);
+			m_modified.emplace(path, modificationTime(path));
+		this->readAll(m_sources);
+		publish();
 	}
 	
-	void TConfigurationManager::read(EConfiguration type, const TString& path)
+	TConfigurationManager::~TConfigurationManager() noexcept
+	{
+		unwatch();
+	}
+	
+	void TConfigurationManager::readAll(std::map<TString, IConfiguration::ConfigurationProperty>& sources) const
+	{
+		if (m_paths.size() < 2)
+		{
+			for (const auto& __path : m_paths)
+				this->read(m_type, __path, sources[__path]);
+			return;
+		}
+		
+		// files don't share any state, so they are parsed at once
+		std::vector<std::future<IConfiguration::ConfigurationProperty>> __loads;
+		__loads.reserve(m_paths.size());
+		for (const auto& __path : m_paths)
+			__loads.push_back(std::async(std::launch::async, [ this, &__path ]
+			{
+				IConfiguration::ConfigurationProperty __properties {};
+				this->read(m_type, __path, __properties);
+				return __properties;
+			}));
+		
+		auto __load = __loads.begin();
+		for (const auto& __path : m_paths)
+			sources[__path] = ( __load++ )->get();
+	}
+	
+	void TConfigurationManager::publish()
+	{
+		auto __properties = std::make_shared<IConfiguration::ConfigurationProperty>();
+		// merged in order of paths, so first file wins as when read one by one
+		for (const auto& __path : m_paths)
+		{
+			const auto __source = m_sources.find(__path);
+			if (__source != m_sources.end())
+				__properties->insert(__source->second.begin(), __source->second.end());
+		}
+		std::atomic_store(&m_properties, TPropertiesPtr(std::move(__properties)));
+	}
+	
+	void TConfigurationManager::read(EConfiguration type, const TString& path,
+									 IConfiguration::ConfigurationProperty& properties) const
 	{
 		auto __factory = dxMAKE_UNIQUE(TConfigurationFactory, path, type);
 		
 		std::list<TString> __keyList;
 		__factory->load();
-		m_type = type;
 		__factory->keys(__keyList);
 		for (auto& __key : __keyList)
-			m_properties.emplace(__key, __factory->getConfiguration());
+			properties.emplace(__key, __factory->getConfiguration());
 	}
 	
 	void TConfigurationManager::write(EConfiguration type, const TString& path)
@@ -485,31 +1411,38 @@ namespace Dixter
 		}
 	}
 	
-	void TConfigurationManager::checkKey(const TConfigurationManager::TConstIterator key,
-										 TString errorMsg) const
+	std::shared_ptr<IConfiguration>
+	TConfigurationManager::find(const TString& key) const
 	{
-		if (key == m_properties.end())
-			throw TNotFoundException(errorMsg);
+		const auto __properties = std::atomic_load(&m_properties);
+		auto __iter = __properties->find(key);
+		if (__iter == __properties->end())
+			throw TNotFoundException("%s:%d Key \"%s\" not found", __FILE__, __LINE__, key);
+		
+		return __iter->second;
 	}
 	
+	TConfigurationManager::TRegistry
+			TConfigurationManager::s_registry {};
+	
+	std::mutex TConfigurationManager::s_registryMutex {};
+	
 	TConfigurationManager::TInstancePtr
-			TConfigurationManager::TConfigurationManager::m_instance {};
-	
-	// bool TConfigurationManager::update()
-	// {
-	// 	bool success(false);
-	// 	try
-	// 	{
-	// 		auto __type = m_factory->getType();
-	// 		auto __paths = m_paths;
-	// 		m_instance.reset(new TConfigurationManager(__type, __paths));
-	// 		success = true;
-	// 	} catch (TException& e)
-	// 	{
-	// 		printerr(e.getMessage())
-	// 	}
-	// 	if (success)
-	// 		println("Updated")
-	// 	return success;
-	// }
+	getCatalogueManager()
+	{
+		TString __format {};
+		try
+		{
+			__format = getIniManager({ g_guiConfigPath })
+					->accessor()
+					->getValue(NodeKey::kCatalogueFormatNode).asUTF8();
+		}
+		catch (TException&)
+		{ }
+		
+		if (__format == "json")
+			return getJsonManager({ g_langJsonConfigPath, g_voiceJsonConfigPath });
+		
+		return getXmlManager({ g_langConfigPath, g_voiceConfigPath });
+	}
 }
\ No newline at end of file
@@ -6,25 +6,27 @@
  *  License-Identifier: MIT License
  *  See README.md for more information.
  */
- 
+
 #pragma once
 
 #include <map>
 #include <unordered_map>
 #include <set>
 #include <mutex>
+#include <functional>
 #include <boost/property_tree/ptree.hpp>
 #include <boost/property_tree/ini_parser.hpp>
-#include <boost/property_tree/xml_parser.hpp>
-#include <boost/property_tree/json_parser.hpp>
 #include "Commons.hpp"
+#include "KeyHandle.hpp"
+#include "RecordSet.hpp"
+#include "NodeEntry.hpp"
 
 
 namespace Dixter
 {
-	struct TNode;
 	class TNodeData;
 	class TNodeEntry;
+	class TConfigurationWatcher;
 	struct IConfiguration;
 	
 	/**
@@ -35,7 +37,7 @@ namespace Dixter
 	 * */
 	struct IConfiguration
 	{
-		using PropertyTree          = boost::property_tree::basic_ptree<TString, TUString>;
+		using PropertyTree          = boost::property_tree::basic_ptree<TString, TString>;
 		using PropertyTreePtr       = std::unique_ptr<PropertyTree>;
 		using NodeEntryPtr       	= std::shared_ptr<TNodeEntry>;
 		using ConfigurationProperty = std::unordered_map<TString, std::shared_ptr<IConfiguration>>;
@@ -54,15 +56,42 @@ namespace Dixter
 		 * */
 		virtual void save() = 0;
 		
-		virtual void set(const TString& key, const TUString& value) = 0;
+		virtual void set(const TString& key, const TU8String& value) = 0;
 		
 		virtual void keys(std::list<TString>&) const = 0;
 		
-		virtual void get(const TString& key, std::vector<TUString>& values) const = 0;
+		virtual void get(const TString& key, std::vector<TU8String>& values) const = 0;
+		
+		virtual TU8String get(const TString& key, const TU8String& byValue) const = 0;
+		
+		virtual TU8String get(const TString& key) const = 0;
+		
+		/**
+		 * \interface ConfigurationInterface
+		 * \brief Access by compiled key. Default implementations
+		 * fall back to access by key path.
+		 * */
+		virtual void set(const TKeyHandle& key, const TU8String& value);
+		
+		virtual void get(const TKeyHandle& key, std::vector<TU8String>& values) const;
 		
-		virtual TUString get(const TString& key, const TUString& byValue) const = 0;
+		virtual TU8String get(const TKeyHandle& key, const TU8String& byValue) const;
 		
-		virtual TUString get(const TString& key) const = 0;
+		virtual TU8String get(const TKeyHandle& key) const;
+		
+		/**
+		 * \interface ConfigurationInterface
+		 * \brief Appends requested fields of every record to record set.
+		 * Default implementation copies values field by field.
+		 * */
+		virtual void select(TRecordSet& records) const;
+		
+		/**
+		 * \interface ConfigurationInterface
+		 * \brief Current data, used to find what changed on reload.
+		 * \returns Snapshot or null if configuration doesn't keep one.
+		 * */
+		virtual TNodeEntry::TSnapshotPtr snapshot() const;
 		
 		virtual ~IConfiguration() = default;
 	};
@@ -93,15 +122,27 @@ namespace Dixter
 		
 		void save() override;
 		
-		void set(const TString& key, const TUString& value) override;
+		void set(const TString& key, const TU8String& value) override;
 		
 		void keys(std::list<TString>&) const override;
 		
-		TUString get(const TString& key) const override;
+		TU8String get(const TString& key) const override;
+		
+		void get(const TString& key, std::vector<TU8String>& values) const override;
+		
+		TU8String get(const TString& key, const TU8String& byValue) const override;
+		
+		void set(const TKeyHandle& key, const TU8String& value) override;
 		
-		void get(const TString& key, std::vector<TUString>& values) const override;
+		void get(const TKeyHandle& key, std::vector<TU8String>& values) const override;
 		
-		TUString get(const TString& key, const TUString& byValue) const override;
+		TU8String get(const TKeyHandle& key, const TU8String& byValue) const override;
+		
+		TU8String get(const TKeyHandle& key) const override;
+		
+		void select(TRecordSet& records) const override;
+		
+		TNodeEntry::TSnapshotPtr snapshot() const override;
 	
 	private:
 		TString m_file;
@@ -145,16 +186,28 @@ namespace Dixter
 		 * */
 		void save() override;
 		
-		void set(const TString& key, const TUString& value) override;
+		void set(const TString& key, const TU8String& value) override;
 		
 		void keys(std::list<TString>&) const override;
 		
-		void get(const TString& key, std::vector<TUString>& values) const override;
+		void get(const TString& key, std::vector<TU8String>& values) const override;
+		
+		TU8String get(const TString& key) const override;
 		
-		TUString get(const TString& key) const override;
+		TU8String get(const TString& key, const TU8String& byValue) const override;
 		
-		TUString get(const TString& key, const TUString& byValue) const override;
+		void set(const TKeyHandle& key, const TU8String& value) override;
 		
+		void get(const TKeyHandle& key, std::vector<TU8String>& values) const override;
+		
+		TU8String get(const TKeyHandle& key, const TU8String& byValue) const override;
+		
+		TU8String get(const TKeyHandle& key) const override;
+		
+		void select(TRecordSet& records) const override;
+		
+		TNodeEntry::TSnapshotPtr snapshot() const override;
+	
 	private:
 		TString m_file;
 		
@@ -162,46 +215,105 @@ namespace Dixter
 		
 		NodeEntryPtr m_entries;
 		
-		PropertyTreePtr m_propertyTree;
-		
 		mutable std::mutex m_mutex;
 	};
 	
-	class TConfigurationJSON : public IConfiguration,
-							   public TMoveOnly
+	/**
+	 * \class JSONConfiguration
+	 * \implements ConfigurationInterface
+	 * \brief Class for reading and storing settings from json file
+	 *
+	 * Members of top level object are roots. Every value two levels deep,
+	 * or every element of array found there, becomes a data entry, its
+	 * scalars become nodes named by their path from the root, like
+	 * "languages.language.name", as XML configuration does.
+	 * */
+	class TConfigurationJSON final : public IConfiguration,
+									 public TMoveOnly
 	{
 	public:
-		using PropertyTree = boost::property_tree::basic_ptree<TString, TString>;
-		
-	public:
-		explicit TConfigurationJSON(const TString& file) noexcept ;
+		/**
+		 * \class JSONConfiguration
+		 * \brief ctor.
+		 * \param file Absolute path to JSON configuration file.
+		 * */
+		explicit TConfigurationJSON(const TString& file) noexcept;
 		
 		virtual ~TConfigurationJSON() noexcept override = default;
 		
 		void load() override;
 		
+		/**
+		 * \class JSONConfiguration
+		 * \brief Writes current data back to configuration file.
+		 *
+		 * Nodes sharing name are written as array, so single element
+		 * arrays come back as objects. Values looking like numbers or
+		 * booleans are written bare, others as strings.
+		 * \throws TException if file can't be written.
+		 * */
 		void save() override;
 		
-		void set(const TString&, const TUString&) override {}
+		void set(const TString& key, const TU8String& value) override;
 		
-		void keys(std::list<TString>&) const override;
+		void keys(std::list<TString>& keyList) const override;
+		
+		void get(const TString& key, std::vector<TU8String>& values) const override;
+		
+		TU8String get(const TString& key) const override;
+		
+		TU8String get(const TString& key, const TU8String& byValue) const override;
 		
-		void get(const TString& key, std::vector<TUString>& values) const override;
+		void set(const TKeyHandle& key, const TU8String& value) override;
 		
-		TUString get(const TString& key) const override;
+		void get(const TKeyHandle& key, std::vector<TU8String>& values) const override;
 		
-		TUString get(const TString& key, const TUString& byValue) const override;
+		TU8String get(const TKeyHandle& key, const TU8String& byValue) const override;
 		
+		TU8String get(const TKeyHandle& key) const override;
+		
+		void select(TRecordSet& records) const override;
+		
+		TNodeEntry::TSnapshotPtr snapshot() const override;
+	
 	private:
 		TString m_file;
 		
-		TString m_rootNode;
-		
 		NodeEntryPtr m_entries;
 		
-		std::unique_ptr<PropertyTree> m_propertyTree;
+		mutable std::mutex m_mutex;
+	};
+	
+	enum class EChange
+	{
+		Added,
+		Removed,
+		Changed
+	};
+	
+	/**
+	 * Change of single node found by reload of configuration file.
+	 * Nodes are matched by index of their data entry, name and order
+	 * among nodes with the same name.
+	 * */
+	struct TNodeChange
+	{
+		EChange change_;
+		
+		/// File the node comes from
+		TString path_;
+		
+		Int32 entry_;
+		
+		TString name_;
+		
+		TU8String oldValue_;
+		
+		TU8String newValue_;
 	};
 	
+	using TChangeList = std::vector<TNodeChange>;
+	
 	class TConfigurationFactory : public TMoveOnly
 	{
 	private:
@@ -234,7 +346,10 @@ namespace Dixter
 	 * \class ConfigurationManager
 	 * \implements ConfigurationManagerInterface
 	 * \namespace Dixter
-	 * \brief Singleton class that manages configurations
+	 * \brief Class that manages configurations.
+	 *
+	 * Instances are kept in a registry by type and set of paths,
+	 * so every configuration file is parsed once and shared.
 	 * */
 	class TConfigurationManager : public TNonCopyable
 	{
@@ -263,7 +378,7 @@ namespace Dixter
 		 * \returns Found value.
 		 * \throws NotFoundException.
 		 * */
-			TUString getValue(const TString& key,
+			TU8String getValue(const TString& key,
 							  const TString& root = TString()) const;
 			
 			/**
@@ -274,7 +389,7 @@ namespace Dixter
 			 * \returns value
 			 * \throws NotFoundException
 			 * */
-			TUString getValue(const TString& key, const TUString& byValue,
+			TU8String getValue(const TString& key, const TU8String& byValue,
 							  const TString& root = TString()) const;
 			
 			/**
@@ -282,8 +397,29 @@ namespace Dixter
 			 * \tparam Container Container to which save data.
 			 * */
 			const TAccessor*
-			getValues(const TString& key, std::vector<TUString>& values,
+			getValues(const TString& key, std::vector<TU8String>& values,
 					  const TString& root = TString()) const;
+			
+			/**
+			 * \brief Overloads taking compiled key, see TKeyHandle.
+			 * */
+			TU8String getValue(const TKeyHandle& key,
+							  const TString& root = TString()) const;
+			
+			TU8String getValue(const TKeyHandle& key, const TU8String& byValue,
+							  const TString& root = TString()) const;
+			
+			const TAccessor*
+			getValues(const TKeyHandle& key, std::vector<TU8String>& values,
+					  const TString& root = TString()) const;
+			
+			/**
+			 * \brief Reads requested fields of every record under root at once.
+			 * \param records Record set with fields to select.
+			 * \param root Root key, if empty first segment of the first field path is used.
+			 * */
+			const TAccessor*
+			select(TRecordSet& records, const TString& root = TString()) const;
 		
 		private:
 			std::shared_ptr<IConfiguration>
@@ -319,7 +455,11 @@ namespace Dixter
 		 * \throws NotFoundException.
 		 * */
 			const TMutator*
-			setValue(const TString& key, const TUString& value,
+			setValue(const TString& key, const TU8String& value,
+					 const TString& root = "");
+			
+			const TMutator*
+			setValue(const TKeyHandle& key, const TU8String& value,
 					 const TString& root = "");
 		
 		private:
@@ -328,18 +468,21 @@ namespace Dixter
 		
 		private:
 			TConfigurationManager*  m_manager;
-			
-			mutable std::mutex m_mutex;
 		};
-		
+	
 	public:
 		using TSelf 			= TConfigurationManager;
 		using TInstancePtr 		= std::shared_ptr<TSelf>;
 		using TAccessorPtr 		= std::unique_ptr<TAccessor>;
 		using TMutatorPtr 		= std::unique_ptr<TMutator>;
 		using TConstIterator	= IConfiguration::ConfigurationProperty::const_iterator;
+		using TPropertiesPtr	= std::shared_ptr<const IConfiguration::ConfigurationProperty>;
+		using TRegistryKey		= std::pair<EConfiguration, std::set<TString>>;
+		using TRegistry			= std::map<TRegistryKey, TInstancePtr>;
+		using TSubscriberId		= UInt32;
+		using TSubscriber		= std::function<void(const TChangeList&)>;
 		
-		virtual ~TConfigurationManager() noexcept = default;
+		virtual ~TConfigurationManager() noexcept;
 		
 		/**
 		 * \class ConfigurationManager
@@ -348,9 +491,8 @@ namespace Dixter
 		 * \param paths List of paths to configuration files.
 		 * \returns Manager instance.
 		 *
-		 * If there is an initialised instance and its type is different,
-		 * then the first instance will be added to a set, and new instance
-		 * is initialised and used. Depending on type it will return the correct instance.
+		 * Instance for the same type and paths is created once and shared.
+		 * It is reloaded if any of its files changed since it was read.
 		 * */
 		static TInstancePtr&
 		getManager(EConfiguration type, std::set<TString> paths = std::set<TString>());
@@ -371,11 +513,48 @@ namespace Dixter
 		
 		/**
 		 * \class ConfigurationManager
-		 * \brief Updates loaded configuration values.
+		 * \brief Re-reads configuration files. Values are replaced in place,
+		 * so every holder of the instance sees them.
 		 * \returns True if values updated.
 		 * */
-		// bool update();
+		bool reload();
+		
+		/**
+		 * \class ConfigurationManager
+		 * \brief Re-reads single configuration file, leaving others as they are.
+		 *
+		 * New data is published at once, readers keep using the old data
+		 * until then and are never blocked. Subscribers are notified of
+		 * nodes which differ after that.
+		 * \returns True if any node changed.
+		 * */
+		bool reload(const TString& path);
+		
+		/**
+		 * \class ConfigurationManager
+		 * \brief Checks if any configuration file changed since it was read.
+		 * */
+		bool isModified() const;
+		
+		/**
+		 * \class ConfigurationManager
+		 * \brief Reloads configuration files as soon as they are changed on disk.
+		 * \returns False if files can't be watched on this system.
+		 * */
+		bool watch();
+		
+		void unwatch();
 		
+		/**
+		 * \class ConfigurationManager
+		 * \brief Registers callback called with changes after every reload
+		 * which changed nodes. Callback may run on the watcher thread.
+		 * \returns Id to unsubscribe with.
+		 * */
+		TSubscriberId subscribe(TSubscriber subscriber);
+		
+		void unsubscribe(TSubscriberId id);
+	
 	private:
 		/**
 		 * \class ConfigurationManager
@@ -385,24 +564,60 @@ namespace Dixter
 		 * */
 		TConfigurationManager(EConfiguration type, const std::set<TString>& paths);
 		
-		void read(EConfiguration type, const TString& path);
+		void read(EConfiguration type, const TString& path,
+				  IConfiguration::ConfigurationProperty& properties) const;
+		
+		/// Reads every path of the manager, separate files on separate threads
+		void readAll(std::map<TString, IConfiguration::ConfigurationProperty>& sources) const;
+		
+		/// Publishes properties merged from sources, called with m_mutex held
+		void publish();
+		
+		/// Paths changed since they were read
+		std::set<TString> modifiedPaths() const;
+		
+		void notify(const TChangeList& changes) const;
 		
 		void write(EConfiguration type, const TString& path);
 		
-		void checkKey(const TConstIterator key, TString errorMsg = "") const;
+		/// Configuration for key in current properties, never blocks
+		std::shared_ptr<IConfiguration> find(const TString& key) const;
 	
 	private:
-		static TInstancePtr m_instance;
+		static TRegistry s_registry;
+		
+		static std::mutex s_registryMutex;
 		
 		EConfiguration m_type;
 		
 		std::set<TString> m_paths;
 		
-		IConfiguration::ConfigurationProperty m_properties;
+		/// Modification time of every file when it was read
+		std::map<TString, Int64> m_modified;
+		
+		/// Properties read from every file
+		std::map<TString, IConfiguration::ConfigurationProperty> m_sources;
+		
+		/// Replaced as a whole on reload, so readers don't lock
+		TPropertiesPtr m_properties;
 		
 		std::unique_ptr<TAccessor> m_accessor;
 		
 		std::unique_ptr<TMutator> m_mutator;
+		
+		/// Guards modification times and sources, serialises reloads
+		mutable std::mutex m_mutex;
+		
+		std::shared_ptr<TConfigurationWatcher> m_watcher;
+		
+		std::vector<UInt32> m_watches;
+		
+		std::map<TSubscriberId, TSubscriber> m_subscribers;
+		
+		TSubscriberId m_nextSubscriber;
+		
+		/// Guards subscribers and watches
+		mutable std::mutex m_subscriberMutex;
 	};
 	
 	inline TConfigurationManager::TInstancePtr
@@ -428,4 +643,12 @@ namespace Dixter
 	{
 		return TConfigurationManager::getManager(EConfiguration::JSON, path);
 	}
+	
+	/**
+	 * Manager of language and voice catalogues. Format is chosen by "catalogue_format"
+	 * of settings.ini, "json" for languages.json and voices.json, anything else or
+	 * no value for XML files.
+	 * */
+	TConfigurationManager::TInstancePtr
+	getCatalogueManager();
 } // namespace Dixter
@@ -0,0 +1,376 @@
+/**
+ *  Copyright (C) 2015-2019
+ *  Author Alvin Ahmadov <alvin.dev.ahmadov@gmail.com>
+ *
+ *  This file is part of Dixter Project
+ *  License-Identifier: MIT License
+ *  See README.md for more information.
+ */
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <filesystem>
+#include <unordered_map>
+#include <boost/filesystem.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include "Macros.hpp"
+#include "ConfigurationCache.hpp"
+
+namespace Dixter
+{
+	namespace
+	{
+		namespace NFileSystem = boost::filesystem;
+		namespace NInterprocess = boost::interprocess;
+		
+		constexpr TByte kMagic[4] { 'D', 'X', 'C', 'F' };
+		
+		struct TStringRef
+		{
+			UInt32 offset_;
+			
+			UInt32 length_;
+		};
+		
+		struct THeader
+		{
+			TByte magic_[4];
+			
+			UInt32 version_;
+			
+			Int64 sourceTime_;
+			
+			UInt64 sourceSize_;
+			
+			UInt64 sourceHash_;
+			
+			TStringRef root_;
+			
+			UInt32 entriesNum_;
+			
+			UInt32 nodesNum_;
+			
+			UInt32 attributesNum_;
+			
+			UInt32 stringsSize_;
+		};
+		
+		struct TNodeRecord
+		{
+			UInt32 entry_;
+			
+			UInt32 index_;
+			
+			TStringRef name_;
+			
+			TStringRef value_;
+			
+			TStringRef parent_;
+		};
+		
+		struct TAttributeRecord
+		{
+			UInt32 entry_;
+			
+			UInt32 index_;
+			
+			TStringRef name_;
+			
+			TStringRef value_;
+		};
+		
+		/// FNV-1a hash of file content
+		bool sourceHash(const TString& path, UInt64& hash)
+		{
+			std::ifstream __file(path, std::ios::binary);
+			if (not __file)
+				return false;
+			
+			hash = 14695981039346656037ULL;
+			TByte __buffer[8192];
+			while (__file.read(__buffer, sizeof(__buffer)) or __file.gcount() > 0)
+			{
+				const auto __read = static_cast<TSize>(__file.gcount());
+				for (TSize __index {}; __index < __read; ++__index)
+				{
+					hash ^= static_cast<TUByte>(__buffer[__index]);
+					hash *= 1099511628211ULL;
+				}
+			}
+			return true;
+		}
+		
+		/// Table of unique strings, referred by offset
+		class TStringTable
+		{
+		public:
+			TStringRef add(TStringView value)
+			{
+				auto [__iter, __inserted] = m_offsets.try_emplace(TString(value), TStringRef {});
+				if (__inserted)
+				{
+					__iter->second = { static_cast<UInt32>(m_data.size()), static_cast<UInt32>(value.size()) };
+					m_data.append(value);
+				}
+				return __iter->second;
+			}
+			
+			const TString& data() const noexcept
+			{
+				return m_data;
+			}
+		
+		private:
+			TString m_data;
+			
+			std::unordered_map<TString, TStringRef> m_offsets;
+		};
+		
+		/// Reader of mapped image checking every reference against its bounds
+		class TImageReader
+		{
+		public:
+			TImageReader(const TByte* data, TSize size) noexcept
+					: m_data(data),
+					  m_size(size),
+					  m_strings()
+			{ }
+			
+			bool header(THeader& header)
+			{
+				if (m_size < sizeof(THeader))
+					return false;
+				
+				std::memcpy(&header, m_data, sizeof(THeader));
+				const TSize __expected = sizeof(THeader)
+										 + TSize(header.nodesNum_) * sizeof(TNodeRecord)
+										 + TSize(header.attributesNum_) * sizeof(TAttributeRecord)
+										 + header.stringsSize_;
+				// every entry is allocated before records are read, so their number
+				// is bounded by the image too
+				if (std::memcmp(header.magic_, kMagic, sizeof(kMagic)) != 0
+					or header.version_ != TConfigurationCache::kVersion
+					or __expected != m_size
+					or header.entriesNum_ > m_size)
+					return false;
+				
+				m_strings = TStringView(m_data + m_size - header.stringsSize_, header.stringsSize_);
+				return true;
+			}
+			
+			template<typename TRecord>
+			TRecord record(TSize offset) const noexcept
+			{
+				TRecord __record;
+				std::memcpy(&__record, m_data + offset, sizeof(TRecord));
+				return __record;
+			}
+			
+			bool string(const TStringRef& ref, TStringView& value) const noexcept
+			{
+				if (ref.offset_ > m_strings.size() or ref.length_ > m_strings.size() - ref.offset_)
+					return false;
+				
+				value = m_strings.substr(ref.offset_, ref.length_);
+				return true;
+			}
+		
+		private:
+			const TByte* m_data;
+			
+			TSize m_size;
+			
+			TStringView m_strings;
+		};
+	} // anonymous namespace
+	
+	TConfigurationCache::TConfigurationCache(const TString& sourcePath)
+			: m_sourcePath(sourcePath),
+			  m_cachePath()
+	{
+		// image name is unique for absolute path of the source
+		const auto __source = NFileSystem::absolute(sourcePath);
+		const auto __name = __source.filename().string() + '.'
+							+ std::to_string(std::hash<TString> {}(__source.string())) + ".dxc";
+		m_cachePath = ( NFileSystem::path(cacheDirectory()) / __name ).string();
+	}
+	
+	bool TConfigurationCache::stamp(TSourceStamp& stamp) const
+	{
+		// boost reports whole seconds, which misses same sized edits within a second
+		std::error_code __error {};
+		stamp.time_ = static_cast<Int64>(std::filesystem::last_write_time(m_sourcePath, __error).time_since_epoch().count());
+		if (__error)
+			return false;
+		
+		stamp.size_ = static_cast<UInt64>(std::filesystem::file_size(m_sourcePath, __error));
+		stamp.hashed_ = false;
+		return not __error;
+	}
+	
+	bool TConfigurationCache::load(TSourceStamp& stamp, TString& rootNode, std::vector<TNodeData*>& entries) const
+	{
+		boost::system::error_code __error {};
+		if (not NFileSystem::exists(m_cachePath, __error))
+			return false;
+		
+		try
+		{
+			NInterprocess::file_mapping __file(m_cachePath.c_str(), NInterprocess::read_only);
+			NInterprocess::mapped_region __region(__file, NInterprocess::read_only);
+			TImageReader __reader(static_cast<const TByte*>(__region.get_address()), __region.get_size());
+			
+			THeader __header {};
+			if (not __reader.header(__header))
+				return false;
+			
+			// touched but unchanged sources are recognised by content
+			if (__header.sourceTime_ != stamp.time_ or __header.sourceSize_ != stamp.size_)
+			{
+				if (not stamp.hashed_)
+					stamp.hashed_ = sourceHash(m_sourcePath, stamp.hash_);
+				if (not stamp.hashed_ or stamp.hash_ != __header.sourceHash_)
+					return false;
+			}
+			
+			std::vector<std::unique_ptr<TNodeData>> __entries;
+			__entries.reserve(__header.entriesNum_);
+			for (UInt32 __index {}; __index < __header.entriesNum_; ++__index)
+				__entries.emplace_back(new TNodeData);
+			
+			TSize __offset(sizeof(THeader));
+			TStringView __name, __value, __parent;
+			for (UInt32 __index {}; __index < __header.nodesNum_; ++__index, __offset += sizeof(TNodeRecord))
+			{
+				const auto __node = __reader.record<TNodeRecord>(__offset);
+				if (__node.entry_ >= __header.entriesNum_
+					or not __reader.string(__node.name_, __name)
+					or not __reader.string(__node.value_, __value)
+					or not __reader.string(__node.parent_, __parent))
+					return false;
+				
+				__entries[__node.entry_]->insertNode(__name, __value, __parent, __node.index_);
+			}
+			for (UInt32 __index {}; __index < __header.attributesNum_; ++__index, __offset += sizeof(TAttributeRecord))
+			{
+				const auto __attr = __reader.record<TAttributeRecord>(__offset);
+				if (__attr.entry_ >= __header.entriesNum_
+					or not __reader.string(__attr.name_, __name)
+					or not __reader.string(__attr.value_, __value))
+					return false;
+				
+				__entries[__attr.entry_]->insertAttribute(__name, __value, __attr.index_);
+			}
+			if (not __reader.string(__header.root_, __name))
+				return false;
+			
+			rootNode.assign(__name);
+			entries.reserve(entries.size() + __entries.size());
+			for (auto& __entry : __entries)
+				entries.push_back(__entry.release());
+		}
+		catch (NInterprocess::interprocess_exception& e)
+		{
+			printerr("Error mapping configuration cache " << m_cachePath << ": " << e.what())
+			return false;
+		}
+		catch (std::exception& e)
+		{
+			// corrupt image may still fail allocations, it's a miss like any other
+			printerr("Error reading configuration cache " << m_cachePath << ": " << e.what())
+			return false;
+		}
+		return true;
+	}
+	
+	bool TConfigurationCache::save(const TString& rootNode, const TNodeEntry::TSnapshot& snapshot,
+								   const TSourceStamp& stamp) const
+	{
+		THeader __header {};
+		__header.sourceHash_ = stamp.hash_;
+		if (not stamp.hashed_ and not sourceHash(m_sourcePath, __header.sourceHash_))
+			return false;
+		
+		// hashed content is the parsed one only if source stayed as stamped until now
+		TSourceStamp __current {};
+		if (not this->stamp(__current) or __current.time_ != stamp.time_ or __current.size_ != stamp.size_)
+			return false;
+		
+		std::memcpy(__header.magic_, kMagic, sizeof(kMagic));
+		__header.version_ = kVersion;
+		__header.sourceTime_ = stamp.time_;
+		__header.sourceSize_ = stamp.size_;
+		
+		TStringTable __strings;
+		std::vector<TNodeRecord> __nodes;
+		std::vector<TAttributeRecord> __attributes;
+		__header.root_ = __strings.add(rootNode);
+		
+		UInt32 __entry {};
+		for (const auto& [__index, __data] : snapshot.entries_)
+		{
+			for (const auto& __node : __data->getNodes())
+				__nodes.push_back({ __entry, __node.index_,
+									__strings.add(__data->name(__node)),
+									__strings.add(__data->value(__node)),
+									__strings.add(__data->parent(__node)) });
+			for (const auto& __attr : __data->getAttributes())
+				__attributes.push_back({ __entry, __attr.index_,
+										 __strings.add(__data->string(__attr.name_)),
+										 __strings.add(__data->string(__attr.value_)) });
+			++__entry;
+		}
+		__header.entriesNum_ = __entry;
+		__header.nodesNum_ = static_cast<UInt32>(__nodes.size());
+		__header.attributesNum_ = static_cast<UInt32>(__attributes.size());
+		__header.stringsSize_ = static_cast<UInt32>(__strings.data().size());
+		
+		boost::system::error_code __error {};
+		NFileSystem::create_directories(cacheDirectory(), __error);
+		
+		// written aside and renamed, so a reader never maps partial image,
+		// under unique name as other processes may save the same image
+		const auto __temporary = m_cachePath + '.' + NFileSystem::unique_path().string() + ".tmp";
+		{
+			std::ofstream __file(__temporary, std::ios::binary | std::ios::trunc);
+			__file.write(reinterpret_cast<const TByte*>(&__header), sizeof(__header));
+			__file.write(reinterpret_cast<const TByte*>(__nodes.data()),
+						 static_cast<std::streamsize>(__nodes.size() * sizeof(TNodeRecord)));
+			__file.write(reinterpret_cast<const TByte*>(__attributes.data()),
+						 static_cast<std::streamsize>(__attributes.size() * sizeof(TAttributeRecord)));
+			__file.write(__strings.data().data(), static_cast<std::streamsize>(__strings.data().size()));
+			if (not __file.flush())
+			{
+				NFileSystem::remove(__temporary, __error);
+				return false;
+			}
+		}
+		NFileSystem::rename(__temporary, m_cachePath, __error);
+		if (__error)
+		{
+			NFileSystem::remove(__temporary, __error);
+			return false;
+		}
+		return true;
+	}
+	
+	const TString& TConfigurationCache::getPath() const noexcept
+	{
+		return m_cachePath;
+	}
+	
+	TString TConfigurationCache::cacheDirectory()
+	{
+		if (const auto __cacheHome = std::getenv("XDG_CACHE_HOME"); __cacheHome and *__cacheHome)
+			return ( NFileSystem::path(__cacheHome) / "dixter" ).string();
+		
+		if (const auto __home = std::getenv("HOME"); __home and *__home)
+			return ( NFileSystem::path(__home) / ".cache" / "dixter" ).string();
+		
+		boost::system::error_code __error {};
+		return ( NFileSystem::temp_directory_path(__error) / "dixter" ).string();
+	}
+} // namespace Dixter
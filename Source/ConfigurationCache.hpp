@@ -0,0 +1,92 @@
+/**
+ *  Copyright (C) 2015-2019
+ *  Author Alvin Ahmadov <alvin.dev.ahmadov@gmail.com>
+ *
+ *  This file is part of Dixter Project
+ *  License-Identifier: MIT License
+ *  See README.md for more information.
+ */
+#pragma once
+
+#include <vector>
+
+#include "Commons.hpp"
+#include "NodeEntry.hpp"
+
+namespace Dixter
+{
+	/**
+	 * \author Alvin Ahmadov
+	 * \class TConfigurationCache
+	 * \brief Binary image of parsed configuration file.
+	 *
+	 * Image is written after the source file was parsed and is memory mapped
+	 * on later loads, so configuration comes up without running the parser.
+	 * Layout is a header, node and attribute records and a string table,
+	 * where records refer to strings by offset and equal strings are stored once.
+	 * Image is valid while modification time and size of the source match,
+	 * or if they don't, while content hash of the source matches.
+	 * */
+	class TConfigurationCache : public TNonCopyable
+	{
+	public:
+		static constexpr UInt32 kVersion = 3;
+		
+		/// Modification time and size of source, hash is computed on demand
+		struct TSourceStamp
+		{
+			Int64 time_;
+			
+			UInt64 size_;
+			
+			UInt64 hash_;
+			
+			bool hashed_;
+		};
+	
+	public:
+		/**
+		 * \param sourcePath Path of configuration file to keep image of.
+		 * */
+		explicit TConfigurationCache(const TString& sourcePath);
+		
+		~TConfigurationCache() noexcept override = default;
+		
+		/**
+		 * \brief Stamps source as it is now, to be taken before it's parsed.
+		 * \returns false if source can't be accessed.
+		 * */
+		bool stamp(TSourceStamp& stamp) const;
+		
+		/**
+		 * \brief Restores data of configuration file from image.
+		 * \param stamp Stamp of source, gets its hash if image had to be checked by content.
+		 * \param rootNode Root key of configuration.
+		 * \param entries Restored data, owned by caller.
+		 * \returns false if there is no valid image for the source.
+		 * */
+		bool load(TSourceStamp& stamp, TString& rootNode, std::vector<TNodeData*>& entries) const;
+		
+		/**
+		 * \brief Writes image of data parsed from configuration file.
+		 * \param stamp Stamp taken before parsing, image isn't written if source
+		 * was changed since then.
+		 * \returns false if image couldn't be written.
+		 * */
+		bool save(const TString& rootNode, const TNodeEntry::TSnapshot& snapshot,
+				  const TSourceStamp& stamp) const;
+		
+		const TString& getPath() const noexcept;
+		
+		/**
+		 * Directory of images, $XDG_CACHE_HOME/dixter or ~/.cache/dixter
+		 * falling back to temporary directory.
+		 * */
+		static TString cacheDirectory();
+	
+	private:
+		TString m_sourcePath;
+		
+		TString m_cachePath;
+	};
+} // namespace Dixter
@@ -0,0 +1,221 @@
+/**
+ *  Copyright (C) 2015-2019
+ *  Author Alvin Ahmadov <alvin.dev.ahmadov@gmail.com>
+ *
+ *  This file is part of Dixter Project
+ *  License-Identifier: MIT License
+ *  See README.md for more information.
+ */
+
+#include <vector>
+#include <cerrno>
+#include <cstdint>
+#include <boost/filesystem.hpp>
+
+#ifdef __linux__
+#	include <poll.h>
+#	include <unistd.h>
+#	include <sys/eventfd.h>
+#	include <sys/inotify.h>
+#endif
+
+#include "Macros.hpp"
+#include "ConfigurationWatcher.hpp"
+
+namespace Dixter
+{
+	namespace NFileSystem = boost::filesystem;
+	
+	namespace
+	{
+		/// Quiet time after last event before file is reported
+		constexpr Int32 kSettleMs = 50;
+	} // anonymous namespace
+	
+	std::shared_ptr<TConfigurationWatcher>
+	TConfigurationWatcher::instance()
+	{
+		static std::shared_ptr<TConfigurationWatcher> s_instance(new TConfigurationWatcher);
+		return s_instance;
+	}
+	
+	TConfigurationWatcher::TConfigurationWatcher()
+			: m_inotify(-1),
+			  m_wakeup(-1),
+			  m_nextId(1),
+			  m_watches(),
+			  m_directories(),
+			  m_mutex(),
+			  m_dispatchMutex(),
+			  m_thread()
+	{
+	#ifdef __linux__
+		m_inotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+		m_wakeup = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+		if (m_inotify >= 0 and m_wakeup >= 0)
+		{
+			m_thread.reset(new JoinThread(&TConfigurationWatcher::run, this));
+			return;
+		}
+		
+		printerr("Configuration files can't be watched")
+		if (m_inotify >= 0)
+			close(m_inotify);
+		if (m_wakeup >= 0)
+			close(m_wakeup);
+		m_inotify = m_wakeup = -1;
+	#endif
+	}
+	
+	TConfigurationWatcher::~TConfigurationWatcher() noexcept
+	{
+	#ifdef __linux__
+		if (m_thread)
+		{
+			const std::uint64_t __signal = 1;
+			dxUNUSED(write(m_wakeup, &__signal, sizeof(__signal)))
+			m_thread->join();
+			close(m_inotify);
+			close(m_wakeup);
+		}
+	#endif
+	}
+	
+	TConfigurationWatcher::TWatchId
+	TConfigurationWatcher::watch(const TString& path, TCallback callback)
+	{
+		if (not available())
+			return 0;
+	
+	#ifdef __linux__
+		const auto __path = NFileSystem::absolute(path).lexically_normal();
+		const auto __directory = __path.parent_path().string();
+		
+		std::lock_guard<std::mutex> __lockGuard(m_mutex);
+		const auto __descriptor = inotify_add_watch(m_inotify, __directory.c_str(),
+													IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE);
+		if (__descriptor < 0)
+			return 0;
+		
+		auto& __watched = m_directories[__descriptor];
+		__watched.first = __directory;
+		++__watched.second;
+		
+		const auto __id = m_nextId++;
+		m_watches.emplace(__id, TWatch { __path.string(), __descriptor, std::move(callback) });
+		return __id;
+	#else
+		dxUNUSED(path)
+		dxUNUSED(callback)
+		return 0;
+	#endif
+	}
+	
+	void TConfigurationWatcher::unwatch(TWatchId id)
+	{
+		{
+			std::lock_guard<std::mutex> __lockGuard(m_mutex);
+			auto __watch = m_watches.find(id);
+			if (__watch == m_watches.end())
+				return;
+			
+			auto __directory = m_directories.find(__watch->second.descriptor_);
+			if (__directory != m_directories.end() and --__directory->second.second == 0)
+			{
+			#ifdef __linux__
+				inotify_rm_watch(m_inotify, __directory->first);
+			#endif
+				m_directories.erase(__directory);
+			}
+			m_watches.erase(__watch);
+		}
+		// waits for callback running on watcher thread
+		std::lock_guard<std::recursive_mutex> __dispatchGuard(m_dispatchMutex);
+	}
+	
+	bool TConfigurationWatcher::available() const noexcept
+	{
+		return m_thread != nullptr;
+	}
+	
+	void TConfigurationWatcher::run()
+	{
+	#ifdef __linux__
+		pollfd __descriptors[] = { { m_inotify, POLLIN, 0 }, { m_wakeup, POLLIN, 0 }};
+		alignas(inotify_event) TByte __buffer[4096];
+		std::set<TString> __changed;
+		while (true)
+		{
+			const auto __ready = poll(__descriptors, 2, __changed.empty() ? -1 : kSettleMs);
+			if (__ready < 0 and errno == EINTR)
+				continue;
+			
+			if (__ready < 0 or __descriptors[1].revents)
+				break;
+			
+			if (__ready == 0)
+			{
+				dispatch(__changed);
+				__changed.clear();
+				continue;
+			}
+			
+			ssize_t __length;
+			while (( __length = read(m_inotify, __buffer, sizeof(__buffer))) > 0)
+			{
+				std::lock_guard<std::mutex> __lockGuard(m_mutex);
+				for (auto __position = __buffer; __position < __buffer + __length;)
+				{
+					const auto __event = reinterpret_cast<const inotify_event*>(__position);
+					__position += sizeof(inotify_event) + __event->len;
+					if (__event->mask & IN_Q_OVERFLOW)
+					{
+						// events were lost, every file may have changed
+						for (const auto& __watch : m_watches)
+							__changed.insert(__watch.second.path_);
+						continue;
+					}
+					
+					const auto __directory = m_directories.find(__event->wd);
+					if (__event->len and __directory != m_directories.end())
+						__changed.insert(( NFileSystem::path(__directory->second.first) / __event->name ).string());
+				}
+			}
+		}
+	#endif
+	}
+	
+	void TConfigurationWatcher::dispatch(const std::set<TString>& changed)
+	{
+		std::lock_guard<std::recursive_mutex> __dispatchGuard(m_dispatchMutex);
+		std::vector<TWatchId> __targets;
+		{
+			std::lock_guard<std::mutex> __lockGuard(m_mutex);
+			for (const auto& __watch : m_watches)
+				if (changed.count(__watch.second.path_))
+					__targets.push_back(__watch.first);
+		}
+		
+		for (const auto __id : __targets)
+		{
+			TWatch __target;
+			{
+				// watch may be gone by now
+				std::lock_guard<std::mutex> __lockGuard(m_mutex);
+				auto __watch = m_watches.find(__id);
+				if (__watch == m_watches.end())
+					continue;
+				
+				__target = __watch->second;
+			}
+			try
+			{
+				__target.callback_(__target.path_);
+			}
+			catch (std::exception& e)
+			{
+				printerr(e.what())
+			}
+		}
+	}
+} // namespace Dixter
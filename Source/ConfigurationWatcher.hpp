@@ -0,0 +1,99 @@
+/**
+ *  Copyright (C) 2015-2019
+ *  Author Alvin Ahmadov <alvin.dev.ahmadov@gmail.com>
+ *
+ *  This file is part of Dixter Project
+ *  License-Identifier: MIT License
+ *  See README.md for more information.
+ */
+#pragma once
+
+#include <map>
+#include <set>
+#include <mutex>
+#include <memory>
+#include <functional>
+
+#include "Commons.hpp"
+#include "JoinThread.hpp"
+
+namespace Dixter
+{
+	/**
+	 * \author Alvin Ahmadov
+	 * \class TConfigurationWatcher
+	 * \brief Reports changes of configuration files.
+	 *
+	 * Watches directories of files with inotify on a single background
+	 * thread, so files replaced by rename, as editors save them, are noticed
+	 * as well. Events of the same file arriving close to each other are
+	 * reported once, after the file settled. Callbacks run on the watcher
+	 * thread. Without inotify support watching is unavailable and
+	 * \c watch returns 0.
+	 * */
+	class TConfigurationWatcher : public TNonCopyable
+	{
+	public:
+		using TWatchId = UInt32;
+		using TCallback = std::function<void(const TString& path)>;
+	
+	public:
+		/**
+		 * Shared watcher, kept alive by every holder.
+		 * */
+		static std::shared_ptr<TConfigurationWatcher> instance();
+		
+		~TConfigurationWatcher() noexcept override;
+		
+		/**
+		 * \brief Calls callback after file at path was written or replaced.
+		 * \returns Id of watch or 0 if file can't be watched.
+		 * */
+		TWatchId watch(const TString& path, TCallback callback);
+		
+		/**
+		 * \brief Stops watch. Returns after running callback of watch finished,
+		 * unless called from that callback.
+		 * */
+		void unwatch(TWatchId id);
+		
+		bool available() const noexcept;
+	
+	private:
+		TConfigurationWatcher();
+		
+		void run();
+		
+		/// Calls callbacks of watches on changed files
+		void dispatch(const std::set<TString>& changed);
+	
+	private:
+		struct TWatch
+		{
+			TString path_;
+			
+			Int32 descriptor_;
+			
+			TCallback callback_;
+		};
+		
+		Int32 m_inotify;
+		
+		/// Wakes watcher thread on destruction
+		Int32 m_wakeup;
+		
+		TWatchId m_nextId;
+		
+		std::map<TWatchId, TWatch> m_watches;
+		
+		/// Watched directory by descriptor with number of watches in it
+		std::map<Int32, std::pair<TString, TSize>> m_directories;
+		
+		mutable std::mutex m_mutex;
+		
+		/// Held while callbacks run, so unwatch can wait for them
+		std::recursive_mutex m_dispatchMutex;
+		
+		std::unique_ptr<JoinThread> m_thread;
+	};
+} // namespace Dixter
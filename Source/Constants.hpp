@@ -10,6 +10,7 @@
 
 #include "Macros.hpp"
 #include "Types.hpp"
+#include "KeyHandle.hpp"
 #include <QString>
 
 namespace Dixter
@@ -35,23 +36,34 @@ namespace Dixter
 			static const TString kLangRoot, kVoiceRoot;
 			static const TString kVoiceNode, kVoiceNameNode, kVoiceValueNode;
 			static const TString kLangNode, kLangIdNode, kLangNameNode,
-								 kLangNameDisplayNode, kLangAlphabetNode, kLangStructureNode;
+								 kLangNameDisplayNode, kLangAlphabetNode, kLangStructureNode,
+								 kLangColumnsNode;
 			static const TString kWinFontSizeNode, kWinFontNameNode, kWinBgColourNode, kWinFgColourNode,
 								 kWinBtnColourNode, kWinWidthNode, kWinHeightNode;
 			static const TString kAreaFontSizeNode, kAreaFontNameNode, kAreaBgColourNode,
 								 kAreaFgColourNode;
 			
-			static const TString kDatabaseHostNode, kDatabaseUserNode, kDatabasePassNode, kDatabasePortNode;
+			static const TString kDatabaseHostNode, kDatabaseUserNode, kDatabasePassNode, kDatabasePortNode,
+								 kDatabaseBatchSizeNode, kDatabaseSlowQueryNode;
+			
+			static const TString kCatalogueFormatNode;
 		};
 		
 		const TString g_dbProtocol("tcp://"),
 					  g_dbConnector("MySQL"), g_mdbConnector("MariaDB");
 		
-		const TString g_indexTable("tables"), g_indexColumn("original_value");
+		const UInt32 g_dbBatchSize(500);
+		const UInt32 g_dbSlowQueryThreshold(0);
+		
+		const TString g_indexTable("tables"), g_indexColumn("original_value"), g_idColumn("id");
+		
+		const UInt32 g_dictPageSize(100);
 		
 		const TString g_guiConfigPath  ("/usr/local/share/dixter/Resources/settings.ini");
 		const TString g_langConfigPath ("/usr/local/share/dixter/Resources/languages.xml");
 		const TString g_voiceConfigPath("/usr/local/share/dixter/Resources/voices.xml");
+		const TString g_langJsonConfigPath ("/usr/local/share/dixter/Resources/languages.json");
+		const TString g_voiceJsonConfigPath("/usr/local/share/dixter/Resources/voices.json");
 		
 		const TString NodeKey::kLangRoot("languages");
 		const TString NodeKey::kVoiceRoot("voices");
@@ -65,6 +77,7 @@ namespace Dixter
 		const TString NodeKey::kLangNameDisplayNode("languages.language.display_name");
 		const TString NodeKey::kLangAlphabetNode("languages.language.alphabet");
 		const TString NodeKey::kLangStructureNode("languages.language.structure");
+		const TString NodeKey::kLangColumnsNode("languages.language.columns");
 		
 		const TString NodeKey::kWinWidthNode("window_width");
 		const TString NodeKey::kWinHeightNode("window_height");
@@ -82,8 +95,29 @@ namespace Dixter
 		const TString NodeKey::kDatabaseUserNode("db_user");
 		const TString NodeKey::kDatabasePassNode("db_password");
 		const TString NodeKey::kDatabasePortNode("db_port");
+		const TString NodeKey::kDatabaseBatchSizeNode("db_batch_size");
+		const TString NodeKey::kDatabaseSlowQueryNode("db_slow_query_ms");
+		
+		const TString NodeKey::kCatalogueFormatNode("catalogue_format");
 	} // anonymous namespace
 	
+	/**
+	 * Compiled keys of NodeKey paths looked up on hot paths. Keys are inline,
+	 * so they are compiled once for the whole binary; they are compiled from
+	 * literals, as NodeKey strings of other units may not be initialised yet.
+	 * */
+	struct NodeHandle final
+	{
+		inline static const TKeyHandle kVoiceNameNode = TKeyHandle::compile("voices.voice.name");
+		inline static const TKeyHandle kVoiceValueNode = TKeyHandle::compile("voices.voice.value");
+		inline static const TKeyHandle kLangIdNode = TKeyHandle::compile("languages.language.id");
+		inline static const TKeyHandle kLangNameNode = TKeyHandle::compile("languages.language.name");
+		inline static const TKeyHandle kLangNameDisplayNode = TKeyHandle::compile("languages.language.display_name");
+		inline static const TKeyHandle kLangAlphabetNode = TKeyHandle::compile("languages.language.alphabet");
+		inline static const TKeyHandle kLangStructureNode = TKeyHandle::compile("languages.language.structure");
+		inline static const TKeyHandle kLangColumnsNode = TKeyHandle::compile("languages.language.columns");
+	};
+	
 	enum class EWidgetID
 	{
 		None = -1,
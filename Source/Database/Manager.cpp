@@ -7,6 +7,8 @@
  *  See README.md for more information.
  */
 
+#include <algorithm>
+
 #include <cppconn/driver.h>
 #include <cppconn/statement.h>
 #include <cppconn/prepared_statement.h>
@@ -15,6 +17,8 @@
 #include "Constants.hpp"
 #include "Configuration.hpp"
 #include "Database/QueryBuilder.hpp"
+#include "Database/QueryStats.hpp"
+#include "Database/RowCursor.hpp"
 #include "Database/Manager.hpp"
 #include "Database/Table.hpp"
 #include "Database/Value.hpp"
@@ -31,14 +35,21 @@ namespace Dixter
 											   const TString& userName,
 											   const TString& password) noexcept
 				: name_(userName),
-				  password_(password)
+				  password_(password),
+				  batchSize_(g_dbBatchSize),
+				  slowQueryThreshold_(g_dbSlowQueryThreshold)
 		{
 			TString __dbPort{};
 			try
 			{
-				__dbPort = getIniManager({ g_guiConfigPath })
-						->accessor()
-						->getValue(NodeKey::kDatabasePortNode).asUTF8();
+				const auto& __accessor = getIniManager({ g_guiConfigPath })->accessor();
+				__dbPort = __accessor->getValue(NodeKey::kDatabasePortNode).asUTF8();
+				Int32 __batchSize = __accessor->getValue(NodeKey::kDatabaseBatchSizeNode);
+				if (__batchSize > 0)
+					batchSize_ = static_cast<UInt32>(__batchSize);
+				Int32 __slowQueryThreshold = __accessor->getValue(NodeKey::kDatabaseSlowQueryNode);
+				if (__slowQueryThreshold >= 0)
+					slowQueryThreshold_ = static_cast<UInt32>(__slowQueryThreshold);
 			}
 			catch (TException& e)
 			{
@@ -47,6 +58,50 @@ namespace Dixter
 			host_ = Utilities::Strings::concat(g_dbProtocol, hostName, ":", __dbPort);
 		}
 		
+		// TParameter implementation
+		TManager::TParameter::TParameter(UInt32 index, EType type) noexcept
+				: index_(index),
+				  type_(type),
+				  integer_(),
+				  string_()
+		{ }
+		
+		// TBatch implementation
+		TManager::TBatch::TBatch(UInt32 batchSize) noexcept
+				: size_(batchSize),
+				  rows_(),
+				  values_(),
+				  statement_()
+		{ }
+		
+		// TTransaction implementation
+		TManager::TTransaction::TTransaction(TManager* manager)
+				: m_committed(false),
+				  m_manager(manager)
+		{
+			m_manager->beginTransaction();
+		}
+		
+		TManager::TTransaction::~TTransaction() noexcept
+		{
+			if (m_committed)
+				return;
+			try
+			{
+				m_manager->rollback();
+			}
+			catch (std::exception& e)
+			{
+				printerr(e.what())
+			}
+		}
+		
+		void TManager::TTransaction::commit()
+		{
+			m_manager->commit();
+			m_committed = true;
+		}
+		
 		// TManager implementation
 		TManager::TManager(const TString& hostName, const TString& dbUser, const TString& dbPassword) noexcept
 				: m_driver(nullptr),
@@ -54,8 +109,10 @@ namespace Dixter
 				  m_statement(nullptr),
 				  m_tables(),
 				  m_prepStmts(),
+				  m_batches(),
 				  m_queryBuilder(new TQueryBuilder),
-				  m_connManager(hostName, dbUser, dbPassword)
+				  m_connManager(hostName, dbUser, dbPassword),
+				  m_stats(dxMAKE_SHARED(TQueryStats, m_connManager.slowQueryThreshold_))
 		{
 			try
 			{
@@ -80,10 +137,17 @@ namespace Dixter
 		{
 			try
 			{
-				for (auto& value : m_tables)
-					delete value.second;
+				// no I/O here, rows not flushed or ended by the owner are lost
+				for (const auto& __batch : m_batches)
+				{
+					if (__batch.second->rows_ or not __batch.second->values_.empty())
+						printerr("Dropping " << __batch.second->rows_ << " unflushed rows of "
+											 << __batch.first)
+				}
+				m_batches.clear();
+				m_prepStmts.clear();
 				
-				for (auto& value : m_prepStmts)
+				for (auto& value : m_tables)
 					delete value.second;
 				
 				delete m_statement;
@@ -117,23 +181,105 @@ namespace Dixter
 		void TManager::insertValues(const TString& tableName)
 		{
 			TLockGuard __lockGuard(m_mutex);
-			if (m_tables.find(tableName) != m_tables.end())
-				m_prepStmts.emplace(
-						tableName,
-						m_tables.at(tableName)->insertValues(m_connection));
+			m_prepStmts[tableName].reset(m_tables.at(tableName)->insertValues(m_connection));
+		}
+		
+		void TManager::insertBatch(const TString& tableName, UInt32 batchSize)
+		{
+			TLockGuard __lockGuard(m_mutex);
+			auto __table = m_tables.find(tableName);
+			if (__table == m_tables.end())
+				throw TNotFoundException("%s:%d No table with name %s", __FILE__, __LINE__, tableName);
+			
+			auto __batch = dxMAKE_UNIQUE(TBatch, batchSize ? batchSize : m_connManager.batchSize_);
+			__batch->values_.reserve(__batch->size_ * __table->second->getParametersSize());
+			__batch->statement_.reset(__table->second->insertValues(m_connection, __batch->size_));
+			m_batches[tableName] = std::move(__batch);
+		}
+		
+		int TManager::endBatch(const TString& tableName)
+		{
+			TLockGuard __lockGuard(m_mutex);
+			auto __found = m_batches.find(tableName);
+			if (__found == m_batches.end())
+				throw TNotFoundException("%s:%d No batch for table %s", __FILE__, __LINE__, tableName);
+			
+			auto __batch = std::move(__found->second);
+			m_batches.erase(__found);
+			return this->doFlush(tableName, *__batch);
+		}
+		
+		int TManager::addBatch(const TString& tableName)
+		{
+			TLockGuard __lockGuard(m_mutex);
+			auto& __batch = m_batches.at(tableName);
+			if (++__batch->rows_ < __batch->size_)
+				return 0;
+			
+			return this->doFlush(tableName, *__batch);
+		}
+		
+		int TManager::flush(const TString& tableName)
+		{
+			TLockGuard __lockGuard(m_mutex);
+			return this->doFlush(tableName, *m_batches.at(tableName));
+		}
+		
+		int TManager::flush()
+		{
+			TLockGuard __lockGuard(m_mutex);
+			return this->doFlush();
+		}
+		
+		void TManager::beginTransaction()
+		{
+			TLockGuard __lockGuard(m_mutex);
+			m_connection->setAutoCommit(false);
+		}
+		
+		void TManager::commit()
+		{
+			// rows added by other threads can't slip between flush and commit
+			TLockGuard __lockGuard(m_mutex);
+			this->doFlush();
+			m_connection->commit();
+			m_connection->setAutoCommit(true);
+		}
+		
+		void TManager::rollback()
+		{
+			TLockGuard __lockGuard(m_mutex);
+			for (auto& __batch : m_batches)
+			{
+				__batch.second->values_.clear();
+				__batch.second->rows_ = 0;
+			}
+			m_connection->rollback();
+			m_connection->setAutoCommit(true);
+		}
+		
+		template<typename TBuild>
+		TString TManager::buildQuery(TBuild&& build)
+		{
+			const auto __start = TQueryStats::TClock::now();
+			TString __query(build());
+			m_stats->record(__query, TQueryStats::EPhase::kBuild, TQueryStats::TClock::now() - __start);
+			return __query;
 		}
 		
 		std::vector<TString>
 		TManager::getColumns(const TString& table)
 		{
-			TString __query(m_queryBuilder->describeQuery(table));
+			TString __query(this->buildQuery([ & ] { return m_queryBuilder->describeQuery(table); }));
 			std::vector<TString> __columns {};
 			
 			TLockGuard __lockGuard(m_mutex);
-			auto __result = this->execute(__query);
-			
-			while (__result->next())
-				__columns.push_back(__result->getString(1));
+			TRowCursor<TString> __cursor(this->execute(__query));
+			while (__cursor.fetch())
+			{
+				for (TSize __index {}; __index < __cursor.size(); ++__index)
+					__columns.emplace_back(__cursor.get<0>(__index));
+			}
 			
 			return __columns;
 		}
@@ -143,7 +289,7 @@ namespace Dixter
 							   const TString& column, TClause clause)
 		{
 			TLockGuard __lockGuard(m_mutex);
-			TString __query(m_queryBuilder->selectQuery(table, column, clause));
+			TString __query(this->buildQuery([ & ] { return m_queryBuilder->selectQuery(table, column, clause); }));
 			return this->execute(__query);
 		}
 		
@@ -153,7 +299,9 @@ namespace Dixter
 								UInt32 comparatorColumn, UInt32 leftTableIndex)
 		{
 			TLockGuard __lockGuard(m_mutex);
-			TString __query(m_queryBuilder->selectQuery(tables, columns, comparatorColumn, leftTableIndex));
+			TString __query(this->buildQuery([ & ] {
+				return m_queryBuilder->selectQuery(tables, columns, comparatorColumn, leftTableIndex);
+			}));
 			return this->execute(__query);
 		}
 		
@@ -163,8 +311,9 @@ namespace Dixter
 									 TClause clause)
 		{
 			TLockGuard __lockGuard(m_mutex);
-			auto __clause = TString("WHERE ") + clause.data();
-			TString __query(m_queryBuilder->selectQuery(table, columns, __clause));
+			TString __query(this->buildQuery([ & ] {
+				return m_queryBuilder->selectQuery(table, columns, TString("WHERE ").append(clause));
+			}));
 			return this->execute(__query);
 		}
 		
@@ -174,7 +323,9 @@ namespace Dixter
 								UInt32 comparatorColumn)
 		{
 			TLockGuard __lockGuard(m_mutex);
-			TString __query(m_queryBuilder->selectQuery(table, columns, comparatorColumn));
+			TString __query(this->buildQuery([ & ] {
+				return m_queryBuilder->selectQuery(table, columns, comparatorColumn);
+			}));
 			return this->execute(__query);
 		}
 		
@@ -186,66 +337,99 @@ namespace Dixter
 									UInt32 fieldIndex)
 		{
 			TLockGuard __lockGuard(m_mutex);
-			TString __query(
-					m_queryBuilder->selectLikeQuery(
-							tables, columns,
-							searchText, comparatorColumn,
-							leftTableIndex, fieldIndex));
+			TString __query(this->buildQuery([ & ] {
+				return m_queryBuilder->selectLikeQuery(tables, columns, searchText, comparatorColumn,
+													   leftTableIndex, fieldIndex);
+			}));
+			return this->execute(__query);
+		}
+		
+		TManager::TResultSetPtr
+		TManager::selectPage(const TString& table,
+							 const std::vector<TString>& columns,
+							 TClause clause,
+							 const TString& keyColumn,
+							 const TString& tieColumn,
+							 const TStringPair& after,
+							 UInt32 limit)
+		{
+			TLockGuard __lockGuard(m_mutex);
+			TString __query(this->buildQuery([ & ] {
+				return m_queryBuilder->pageQuery(table, columns, clause, keyColumn, tieColumn, after, limit);
+			}));
 			return this->execute(__query);
 		}
 		
 		void TManager::setBigInt(const TString& tableName, UInt32 parameterIndex, const TString& value)
 		{
+			TParameter __parameter(parameterIndex, TParameter::EType::kBigInt);
+			__parameter.string_ = value;
 			TLockGuard __lockGuard(m_mutex);
-			m_prepStmts.at(tableName)->setBigInt(parameterIndex, value);
+			this->bind(tableName, std::move(__parameter));
 		}
 		
 		void TManager::setBlob(const TString& tableName, UInt32 parameterIndex, std::istream* blob)
 		{
+			TParameter __parameter(parameterIndex, TParameter::EType::kBlob);
+			__parameter.blob_ = blob;
 			TLockGuard __lockGuard(m_mutex);
-			m_prepStmts.at(tableName)->setBlob(parameterIndex, blob);
+			this->bind(tableName, std::move(__parameter));
 		}
 		
 		void TManager::setBoolean(const TString& tableName, UInt32 parameterIndex, bool value)
 		{
+			TParameter __parameter(parameterIndex, TParameter::EType::kBoolean);
+			__parameter.boolean_ = value;
 			TLockGuard __lockGuard(m_mutex);
-			m_prepStmts.at(tableName)->setBoolean(parameterIndex, value);
+			this->bind(tableName, std::move(__parameter));
 		}
 		
 		void TManager::setDateTime(const TString& tableName, UInt32 parameterIndex, const TString& value)
 		{
+			TParameter __parameter(parameterIndex, TParameter::EType::kDateTime);
+			__parameter.string_ = value;
 			TLockGuard __lockGuard(m_mutex);
-			m_prepStmts.at(tableName)->setDateTime(parameterIndex, sql::SQLString { value.data() });
+			this->bind(tableName, std::move(__parameter));
 		}
 		
 		void TManager::setDouble(const TString& tableName, UInt32 parameterIndex, Real32 value)
 		{
+			TParameter __parameter(parameterIndex, TParameter::EType::kDouble);
+			__parameter.real_ = value;
 			TLockGuard __lockGuard(m_mutex);
-			m_prepStmts.at(tableName)->setDouble(parameterIndex, value);
+			this->bind(tableName, std::move(__parameter));
 		}
 		
 		void TManager::setInt(const TString& tableName, UInt32 parameterIndex, Int32 value)
 		{
+			TParameter __parameter(parameterIndex, TParameter::EType::kInt);
+			__parameter.integer_ = value;
 			TLockGuard __lockGuard(m_mutex);
-			m_prepStmts.at(tableName)->setInt(parameterIndex, value);
+			this->bind(tableName, std::move(__parameter));
 		}
 		
 		void TManager::setUInt(const TString& tableName, UInt32 parameterIndex, UInt32 value)
 		{
+			TParameter __parameter(parameterIndex, TParameter::EType::kUInt);
+			__parameter.unsigned_ = value;
 			TLockGuard __lockGuard(m_mutex);
-			m_prepStmts.at(tableName)->setUInt(parameterIndex, value);
+			this->bind(tableName, std::move(__parameter));
 		}
 		
 		void TManager::setInt64(const TString& tableName, UInt32 parameterIndex, Int64 value)
 		{
+			TParameter __parameter(parameterIndex, TParameter::EType::kInt64);
+			__parameter.integer_ = value;
 			TLockGuard __lockGuard(m_mutex);
-			m_prepStmts.at(tableName)->setInt64(parameterIndex, value);
+			this->bind(tableName, std::move(__parameter));
 		}
 		
 		void TManager::setUInt64(const TString& tableName, UInt32 parameterIndex, UInt64 value)
 		{
+			TParameter __parameter(parameterIndex, TParameter::EType::kUInt64);
+			__parameter.unsigned_ = value;
 			TLockGuard __lockGuard(m_mutex);
-			m_prepStmts.at(tableName)->setUInt64(parameterIndex, value);
+			this->bind(tableName, std::move(__parameter));
 		}
 		
 		void TManager::setNull(const TString& tableName, UInt32 parameterIndex)
@@ -260,13 +444,17 @@ namespace Dixter
 					__dataType = __value->getType();
 				++__counter;
 			}
-			m_prepStmts.at(tableName)->setNull(parameterIndex, static_cast<int>(__dataType));
+			TParameter __parameter(parameterIndex, TParameter::EType::kNull);
+			__parameter.integer_ = static_cast<Int64>(__dataType);
+			this->bind(tableName, std::move(__parameter));
 		}
 		
 		void TManager::setString(const TString& tableName, UInt32 parameterIndex, const TString& value)
 		{
+			TParameter __parameter(parameterIndex, TParameter::EType::kString);
+			__parameter.string_ = value;
 			TLockGuard __lockGuard(m_mutex);
-			m_prepStmts.at(tableName)->setString(parameterIndex, value);
+			this->bind(tableName, std::move(__parameter));
 		}
 		
 		UInt32 TManager::setStrings(const TString& tableName,
@@ -281,20 +469,20 @@ namespace Dixter
 			const UInt32 __limit(stringColumnNum + parameterStartIndex);
 			const TString __empty {};
 			UInt32 __index(parameterStartIndex);
-			if (not m_prepStmts.at(tableName))
+			if (m_batches.find(tableName) == m_batches.end() and m_prepStmts.find(tableName) == m_prepStmts.end())
 				throw TSQLException("%s:%d No statement is prepared", __FILE__, __LINE__);
 			
 			try
 			{
 				for (; __index < __limit; ++__index)
 				{
+					TString __value(list.size() != 0 ? std::move(list.back()) : __empty);
 					if (list.size() != 0)
-					{
-						this->setString(tableName, __index, list.back());
 						list.pop_back();
-					}
-					else
-						this->setString(tableName, __index, __empty);
+					
+					TParameter __parameter(__index, TParameter::EType::kString);
+					__parameter.string_ = std::move(__value);
+					this->bind(tableName, std::move(__parameter));
 				}
 			}
 			catch (std::exception& e)
@@ -308,14 +496,164 @@ namespace Dixter
 		int TManager::executeUpdate(const TString& tableName)
 		{
 			TLockGuard __lockGuard(m_mutex);
-			int __result = m_prepStmts.at(tableName)->executeUpdate();
-			return __result;
+			auto __statement = m_prepStmts.find(tableName);
+			if (__statement == m_prepStmts.end())
+				throw TSQLException("%s:%d No statement is prepared for %s", __FILE__, __LINE__, tableName);
+			
+			return this->executeUpdate(__statement->second.get(), tableName);
+		}
+		
+		TString TManager::dumpStatistics() const
+		{
+			return m_stats->toJson();
+		}
+		
+		void TManager::resetStatistics()
+		{
+			m_stats->reset();
+		}
+		
+		void TManager::setSlowQueryThreshold(UInt32 slowQueryThreshold)
+		{
+			m_stats->setSlowQueryThreshold(slowQueryThreshold);
 		}
 		
 		TManager::TResultSetPtr
 		TManager::execute(const TString& query)
 		{
-			return TResultSetPtr(m_statement->executeQuery(query));
+			sql::ResultSet* __result {};
+			const auto __start = TQueryStats::TClock::now();
+			try
+			{
+				__result = m_statement->executeQuery(query);
+			}
+			catch (sql::SQLException&)
+			{
+				m_stats->recordError(query);
+				throw;
+			}
+			m_stats->record(query, TQueryStats::EPhase::kExecute, TQueryStats::TClock::now() - __start);
+			
+			// cursors reading the result set time the fetch phase
+			return TResultSetPtr(__result, TFetchTimer(m_stats, query));
+		}
+		
+		int TManager::executeUpdate(sql::PreparedStatement* statement, const TString& tableName)
+		{
+			const auto __shape = TString("INSERT INTO ").append(tableName);
+			const auto __start = TQueryStats::TClock::now();
+			try
+			{
+				int __result = statement->executeUpdate();
+				m_stats->record(__shape, TQueryStats::EPhase::kExecute, TQueryStats::TClock::now() - __start);
+				return __result;
+			}
+			catch (sql::SQLException&)
+			{
+				m_stats->recordError(__shape);
+				throw;
+			}
+		}
+		
+		void TManager::bind(const TString& tableName, TParameter&& parameter)
+		{
+			auto __batch = m_batches.find(tableName);
+			if (__batch != m_batches.end())
+			{
+				const auto __offset = static_cast<UInt32>(
+						__batch->second->rows_ * m_tables.at(tableName)->getParametersSize());
+				__batch->second->values_.emplace_back(__offset, std::move(parameter));
+				return;
+			}
+			
+			auto __statement = m_prepStmts.find(tableName);
+			if (__statement == m_prepStmts.end())
+				throw TSQLException("%s:%d No statement is prepared for %s", __FILE__, __LINE__, tableName);
+			
+			apply(__statement->second.get(), 0, parameter);
+		}
+		
+		void TManager::apply(sql::PreparedStatement* statement, UInt32 offset, const TParameter& parameter)
+		{
+			const auto __index = offset + parameter.index_;
+			switch (parameter.type_)
+			{
+				case TParameter::EType::kBigInt:
+					statement->setBigInt(__index, parameter.string_);
+					break;
+				case TParameter::EType::kBlob:
+					statement->setBlob(__index, parameter.blob_);
+					break;
+				case TParameter::EType::kBoolean:
+					statement->setBoolean(__index, parameter.boolean_);
+					break;
+				case TParameter::EType::kDateTime:
+					statement->setDateTime(__index, sql::SQLString { parameter.string_.data() });
+					break;
+				case TParameter::EType::kDouble:
+					statement->setDouble(__index, parameter.real_);
+					break;
+				case TParameter::EType::kInt:
+					statement->setInt(__index, static_cast<Int32>(parameter.integer_));
+					break;
+				case TParameter::EType::kUInt:
+					statement->setUInt(__index, static_cast<UInt32>(parameter.unsigned_));
+					break;
+				case TParameter::EType::kInt64:
+					statement->setInt64(__index, parameter.integer_);
+					break;
+				case TParameter::EType::kUInt64:
+					statement->setUInt64(__index, parameter.unsigned_);
+					break;
+				case TParameter::EType::kNull:
+					statement->setNull(__index, static_cast<int>(parameter.integer_));
+					break;
+				case TParameter::EType::kString:
+					statement->setString(__index, parameter.string_);
+					break;
+			}
+		}
+		
+		int TManager::doFlush(const TString& tableName, TBatch& batch)
+		{
+			if (not batch.rows_)
+				return 0;
+			
+			auto __statement = batch.statement_.get();
+			std::unique_ptr<sql::PreparedStatement> __tailStatement {};
+			
+			// A partially filled batch needs its own statement with fewer rows
+			if (batch.rows_ != batch.size_)
+			{
+				__tailStatement.reset(m_tables.at(tableName)->insertValues(m_connection, batch.rows_));
+				__statement = __tailStatement.get();
+			}
+			
+			// Values of a row not closed by addBatch stay buffered for the next statement
+			const auto __closedSize = static_cast<UInt32>(
+					batch.rows_ * m_tables.at(tableName)->getParametersSize());
+			auto __openRow = std::stable_partition(
+					batch.values_.begin(), batch.values_.end(),
+					[ __closedSize ](const auto& value) { return value.first < __closedSize; });
+			
+			for (auto __value = batch.values_.begin(); __value != __openRow; ++__value)
+				apply(__statement, __value->first, __value->second);
+			
+			int __result = this->executeUpdate(__statement, tableName);
+			batch.values_.erase(batch.values_.begin(), __openRow);
+			for (auto& __value : batch.values_)
+				__value.first -= __closedSize;
+			batch.rows_ = 0;
+			return __result;
+		}
+		
+		int TManager::doFlush()
+		{
+			int __result {};
+			for (auto& __batch : m_batches)
+				__result += this->doFlush(__batch.first, *__batch.second);
+			
+			return __result;
 		}
 	} // namespace Database
 } // namespace Dixter
\ No newline at end of file
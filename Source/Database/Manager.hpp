@@ -38,12 +38,14 @@ namespace Dixter
 		
 		class TQueryBuilder;
 		
+		class TQueryStats;
+		
 		class TManager : public TNonCopyable
 		{
 		public:
 			using TResultSetPtr = std::shared_ptr<sql::ResultSet>;
-			using TPreparedStatementMap = std::map<TString, sql::PreparedStatement*>;
 			using TTableMap = std::map<TString, TTable*>;
+			using TPreparedStatementMap = std::map<TString, std::unique_ptr<sql::PreparedStatement>>;
 			#ifdef HAVE_CXX17
 			using TClause = TStringView;
 			#else
@@ -70,6 +72,89 @@ namespace Dixter
 				TString name_;
 				
 				TString password_;
+				
+				UInt32 batchSize_;
+				
+				UInt32 slowQueryThreshold_;
+			};
+			
+			/**
+			 * Parameter value kept until its batch is flushed
+			 * */
+			struct TParameter
+			{
+				enum class EType : UInt8
+				{
+					kBigInt,
+					kBlob,
+					kBoolean,
+					kDateTime,
+					kDouble,
+					kInt,
+					kUInt,
+					kInt64,
+					kUInt64,
+					kNull,
+					kString
+				};
+				
+				TParameter(UInt32 index, EType type) noexcept;
+				
+				UInt32 index_;
+				
+				EType type_;
+				
+				union
+				{
+					bool boolean_;
+					
+					Int64 integer_;
+					
+					UInt64 unsigned_;
+					
+					Real32 real_;
+					
+					std::istream* blob_;
+				};
+				
+				TString string_;
+			};
+			
+			/**
+			 * Rows buffered for a multi-row insert statement
+			 * */
+			struct TBatch
+			{
+				explicit TBatch(UInt32 batchSize) noexcept;
+				
+				UInt32 size_;
+				
+				UInt32 rows_;
+				
+				/// Row offset and value of each bound parameter
+				std::vector<std::pair<UInt32, TParameter>> values_;
+				
+				std::unique_ptr<sql::PreparedStatement> statement_;
+			};
+			
+			using TBatchMap = std::map<TString, std::unique_ptr<TBatch>>;
+			
+			/**
+			 * Scoped transaction. Rolls back on destruction unless committed.
+			 * */
+			class TTransaction : public TNonCopyable
+			{
+			public:
+				explicit TTransaction(TManager* manager);
+				
+				~TTransaction() noexcept override;
+				
+				void commit();
+			
+			private:
+				bool m_committed;
+				
+				TManager* m_manager;
 			};
 		
 		public:
@@ -84,8 +169,56 @@ namespace Dixter
 			void createTable(const TString& tableName,
 							 const std::list<TValue*>& valueList, bool drop = true);
 			
+			/**
+			 * Prepare single-row insert into table, sent by executeUpdate.
+			 * @see insertBatch
+			 * */
 			void insertValues(const TString& tableName);
 			
+			/**
+			 * Prepare multi-row insert statement for table. Values set afterwards
+			 * are buffered and sent to server every \c batchSize rows, until endBatch.
+			 * @param batchSize Rows per statement, 0 to use value from settings
+			 * */
+			void insertBatch(const TString& tableName, UInt32 batchSize = 0);
+			
+			/**
+			 * Flush and close the batch of table. Rows of a failed flush are dropped
+			 * with the batch.
+			 * @returns Number of affected rows
+			 * */
+			int endBatch(const TString& tableName);
+			
+			/**
+			 * Close current row of the batch. Flushes the batch when it is full.
+			 * @returns Number of affected rows
+			 * */
+			int addBatch(const TString& tableName);
+			
+			/**
+			 * Send buffered rows of the batch to server. Rows stay buffered if it fails.
+			 * @returns Number of affected rows
+			 * */
+			int flush(const TString& tableName);
+			
+			/**
+			 * Send buffered rows of every batch to server.
+			 * @returns Number of affected rows
+			 * */
+			int flush();
+			
+			void beginTransaction();
+			
+			/**
+			 * Flush pending batches and commit current transaction.
+			 * */
+			void commit();
+			
+			/**
+			 * Drop pending batches and roll back current transaction.
+			 * */
+			void rollback();
+			
 			std::vector<TString> getColumns(const TString& table);
 			
 			TResultSetPtr selectColumn(const TString& table,
@@ -121,12 +254,28 @@ namespace Dixter
 											UInt32 comparatorColumn, UInt32 leftTableIndex,
 											UInt32 fieldIndex);
 			
+			/**
+			 * Get a page of rows ordered by key column.
+			 * @see TQueryBuilder::pageQuery
+			 * */
+			TResultSetPtr selectPage(const TString& table,
+									 const std::vector<TString>& columns,
+									 TClause clause,
+									 const TString& keyColumn,
+									 const TString& tieColumn,
+									 const TStringPair& after,
+									 UInt32 limit);
+			
 			/**
 			 *
 			 * */
 			void setBigInt(const TString& tableName, UInt32 parameterIndex,
 						   const TString& value);
 			
+			/**
+			 * Stream is read when statement is executed, for a batch it must
+			 * stay valid until the batch is flushed.
+			 * */
 			void setBlob(const TString& tableName, UInt32 parameterIndex,
 						 std::istream* blob);
 			
@@ -159,11 +308,44 @@ namespace Dixter
 			UInt32 setStrings(const TString& tableName, const UInt32& parameterStartIndex,
 							  std::list<TString>& list, UInt32 stringColumnNum = 0);
 			
+			/**
+			 * Execute single-row insert prepared by insertValues.
+			 * @returns Number of rows inserted
+			 * */
 			int executeUpdate(const TString& tableName);
+			
+			/**
+			 * Dump latency statistics of executed queries as JSON.
+			 * */
+			TString dumpStatistics() const;
+			
+			void resetStatistics();
+			
+			/**
+			 * Log queries with any phase taking longer than threshold.
+			 * @param slowQueryThreshold Milliseconds, 0 disables log
+			 * */
+			void setSlowQueryThreshold(UInt32 slowQueryThreshold);
 		
 		private:
 			inline TResultSetPtr
 			execute(const TString& query);
+			
+			template<typename TBuild>
+			TString buildQuery(TBuild&& build);
+			
+			int executeUpdate(sql::PreparedStatement* statement, const TString& tableName);
+			
+			/// Buffer parameter in open batch of table, or set it on single-row statement
+			void bind(const TString& tableName, TParameter&& parameter);
+			
+			static void apply(sql::PreparedStatement* statement, UInt32 offset,
+							  const TParameter& parameter);
+			
+			int doFlush(const TString& tableName, TBatch& batch);
+			
+			/// Flush every batch, manager must be locked
+			int doFlush();
 		
 		private:
 			sql::Driver* m_driver;
@@ -176,10 +358,14 @@ namespace Dixter
 			
 			TPreparedStatementMap m_prepStmts;
 			
+			TBatchMap m_batches;
+			
 			TQueryBuilder* m_queryBuilder;
 			
 			TConnectionManager m_connManager;
 			
+			std::shared_ptr<TQueryStats> m_stats;
+			
 			mutable std::mutex m_mutex;
 		};
 	} // namespace Database
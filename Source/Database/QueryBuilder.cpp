@@ -6,7 +6,7 @@
  *  License-Identifier: MIT License
  *  See README.md for more information.
  */
- 
+
 #include "Constants.hpp"
 #include "QueryBuilder.hpp"
 #include "Utilities.hpp"
@@ -16,234 +16,368 @@ namespace Dixter
 {
 	namespace Database
 	{
-		namespace AlgoUtils	= Utilities::Algorithms;
-		using TLockGuard	= std::lock_guard<std::mutex>;
-		using TQueryStream	= std::ostringstream;
-		
-		TQueryBuilder::TQueryBuilder() noexcept
-				: m_query()
-		{ }
-		
-		TQueryBuilder::TQuery
-		TQueryBuilder::describeQuery(const TString& tableName)
+		namespace
 		{
-			TLockGuard __lockGuard(m_mutex);
-			TQueryStream __queryStream {};
+			using TStringVector = std::vector<TString>;
+			
+			const TSize g_noSkip(static_cast<TSize>(-1));
+			
+			template<typename... TParts>
+			inline TSize partsSize(const TParts&... parts)
+			{
+				return ( TStringView(parts).size() + ... + 0 );
+			}
+			
+			template<typename... TParts>
+			inline TString& appendParts(TString& query, const TParts&... parts)
+			{
+				( query.append(parts), ... );
+				return query;
+			}
 			
-			__queryStream << "DESCRIBE " << tableName;
+			/// Builds query of fixed shape with a single allocation
+			template<typename... TParts>
+			inline TString makeQuery(const TParts&... parts)
+			{
+				TString __query {};
+				__query.reserve(partsSize(parts...));
+				return std::move(appendParts(__query, parts...));
+			}
+			
+			/// Size of items joined with separator, item at index skip excluded
+			TSize joinedSize(const TStringVector& items, TStringView separator, TSize skip = g_noSkip)
+			{
+				TSize __size {}, __count {};
+				for (TSize __index = 0; __index < items.size(); ++__index)
+				{
+					if (__index == skip)
+						continue;
+					__size += items[__index].size();
+					++__count;
+				}
+				return __count ? __size + ( __count - 1 ) * separator.size() : 0;
+			}
+			
+			void appendJoined(TString& query, const TStringVector& items,
+							  TStringView separator, TSize skip = g_noSkip)
+			{
+				bool __first { true };
+				for (TSize __index = 0; __index < items.size(); ++__index)
+				{
+					if (__index == skip)
+						continue;
+					if (not __first)
+						query.append(separator);
+					query.append(items[__index]);
+					__first = false;
+				}
+			}
 			
-			return this->resetQuery(__queryStream);
+			/// Appends value as double quoted literal
+			void appendQuoted(TString& query, TStringView value)
+			{
+				query.push_back('"');
+				for (auto __c : value)
+				{
+					if (__c == '"' or __c == '\\')
+						query.push_back('\\');
+					query.push_back(__c);
+				}
+				query.push_back('"');
+			}
+			
+			/**
+			 * Appends value as double quoted LIKE pattern matching it literally.
+			 * Backslash is escape character of both literal and pattern, so it is doubled twice.
+			 * */
+			void appendLikeQuoted(TString& query, TStringView value, TStringView wildcard)
+			{
+				query.push_back('"');
+				for (auto __c : value)
+				{
+					if (__c == '\\')
+						query.append("\\\\\\\\");
+					else
+					{
+						if (__c == '%' or __c == '_' or __c == '"')
+							query.push_back('\\');
+						query.push_back(__c);
+					}
+				}
+				appendParts(query, wildcard, "\"");
+			}
+		} // anonymous namespace
+		
+		TQueryBuilder::TQuery
+		TQueryBuilder::describeQuery(const TString& tableName) const
+		{
+			return makeQuery("DESCRIBE ", tableName);
 		}
 		
 		TQueryBuilder::TQuery
-		TQueryBuilder::dropQuery(const TString& tableName)
+		TQueryBuilder::dropQuery(const TString& tableName) const
 		{
-			TLockGuard __lockGuard(m_mutex);
-			TQueryStream __queryStream {};
-			
-			__queryStream << "DROP TABLE IF EXISTS " << tableName;
-			
-			return this->resetQuery(__queryStream);
+			return makeQuery("DROP TABLE IF EXISTS ", tableName);
 		}
 		
 		TQueryBuilder::TQuery
 		TQueryBuilder::createQuery(const TString& tableName,
 								   const std::list<TValue*>& dbValueList,
-								   TSize& parametersNum)
+								   TSize& parametersNum) const
 		{
-			TLockGuard __lockGuard(m_mutex);
-			TQueryStream __queryStream {};
+			TString __query {};
+			std::vector<TString> __types {};
+			TSize __size(partsSize("CREATE TABLE ", tableName, " ()"));
 			
-			__queryStream << "CREATE TABLE " << tableName << " (";
+			__types.reserve(dbValueList.size());
+			for (const auto& __value : dbValueList)
+			{
+				__types.push_back(__value->getTypeString());
+				__size += partsSize(" ", __value->getValueName(), " ", __types.back(), " NOT NULL,");
+				if (__value->getSize() != 0)
+					__size += partsSize(" () ", std::to_string(__value->getSize()));
+				if (__value->isAutoIncrement())
+					__size += partsSize(" AUTO_INCREMENT");
+				if (__value->isPrimaryKey())
+					__size += partsSize(", PRIMARY KEY ()", __value->getValueName());
+			}
+			__query.reserve(__size);
+			
+			appendParts(__query, "CREATE TABLE ", tableName, " (");
 			
+			auto __type = __types.cbegin();
 			for (const auto& __value : dbValueList)
 			{
-				bool __isAutoIncr(__value->isAutoIncrement());
-				bool __isNull(__value->isNull());
-				bool __isPrimaryKey { __value->isPrimaryKey() };
-				
-				__queryStream << " " << __value->getValueName() << " " << __value->getTypeString();
+				appendParts(__query, " ", __value->getValueName(), " ", *__type++);
 				
 				if (__value->getSize() != 0)
-					__queryStream << " (" << std::to_string(__value->getSize()) << ") ";
+					appendParts(__query, " (", std::to_string(__value->getSize()), ") ");
 				
-				if (__isAutoIncr)
-					__queryStream << " AUTO_INCREMENT";
+				if (__value->isAutoIncrement())
+					__query.append(" AUTO_INCREMENT");
 				
-				if (__isNull)
-					__queryStream << " NULL";
-				else
-					__queryStream << " NOT NULL";
+				__query.append(__value->isNull() ? " NULL" : " NOT NULL");
 				
-				if (__isPrimaryKey)
-					__queryStream << ", PRIMARY KEY (" << __value->getValueName() << ")";
+				if (__value->isPrimaryKey())
+					appendParts(__query, ", PRIMARY KEY (", __value->getValueName(), ")");
 				
 				if (++parametersNum != dbValueList.size())
-					__queryStream << ',';
+					__query.push_back(',');
 			}
-			__queryStream << ')';
+			__query.push_back(')');
 			
-			return this->resetQuery(__queryStream);
+			return __query;
 		}
 		
 		TQueryBuilder::TQuery
-		TQueryBuilder::insertQuery(const TString& tableName, const TSize& parametersNum)
+		TQueryBuilder::insertQuery(const TString& tableName, const TSize& parametersNum,
+								   const TSize& rowsNum) const
 		{
-			TLockGuard __lockGuard(m_mutex);
-			TQueryStream __queryStream {};
-			
-			TSize __index {};
-			__queryStream << "INSERT INTO " << tableName << " VALUES (";
-			AlgoUtils::forEach(
-					__index, parametersNum,
-					[ & ](TSize&)
-					{
-						__queryStream << '?';
-						if (__index != parametersNum - 1)
-							__queryStream << ", ";
-					});
-			__queryStream << ')';
+			TString __query {};
+			if (not parametersNum or not rowsNum)
+				return __query;
 			
-			return this->resetQuery(__queryStream);
+			// "(?, ?, ?)" per row, rows separated by ", "
+			const TSize __rowSize(2 + parametersNum + ( parametersNum - 1 ) * 2);
+			__query.reserve(partsSize("INSERT INTO ", tableName, " VALUES ")
+							+ rowsNum * __rowSize + ( rowsNum - 1 ) * 2);
+			
+			appendParts(__query, "INSERT INTO ", tableName, " VALUES ");
+			for (TSize __row = 0; __row < rowsNum; ++__row)
+			{
+				if (__row)
+					__query.append(", ");
+				__query.push_back('(');
+				for (TSize __index = 0; __index < parametersNum; ++__index)
+				{
+					if (__index)
+						__query.append(", ");
+					__query.push_back('?');
+				}
+				__query.push_back(')');
+			}
+			
+			return __query;
 		}
 		
 		TQueryBuilder::TQuery
 		TQueryBuilder::selectQuery(const TStringVector& tables, const TStringVector& columns,
-								   UInt32 indexColumn, UInt32 leftTableIndex)
+								   UInt32 indexColumn, UInt32 leftTableIndex) const
 		{
-			TLockGuard __lockGuard(m_mutex);
-			TQueryStream __queryStream {};
+			TString __query {};
+			const auto& __leftTable = tables.at(leftTableIndex);
+			const auto& __indexColumn = columns.at(indexColumn);
 			
-			__queryStream << "SELECT ";
-			
-			for (UInt32 __index = 0; __index < columns.size(); ++__index)
-			{
-				if (__index != indexColumn)
-					__queryStream << columns.at(__index);
-				if (__index != columns.size() - 1 and __index != indexColumn)
-					__queryStream << ',';
-				__queryStream << g_whiteSpace;
-			}
-			
-			__queryStream << " FROM " << tables.at(leftTableIndex);
+			TSize __size(partsSize("SELECT ", " FROM ", __leftTable)
+						 + joinedSize(columns, ", ", indexColumn));
 			if (tables.size() > 1)
 			{
-				__queryStream << " JOIN (";
-				for (UInt32 __index = 0; __index < tables.size(); ++__index)
-				{
+				__size += partsSize(" JOIN (", ") ON ") + joinedSize(tables, ", ", leftTableIndex);
+				for (TSize __index = 0; __index < tables.size(); ++__index)
 					if (__index != leftTableIndex)
-						__queryStream << tables.at(__index);
-					
-					if (__index != tables.size() - 1 and __index != leftTableIndex)
-						__queryStream << ", ";
-				}
-				__queryStream << ") ON ";
+						__size += partsSize(__leftTable, ".", __indexColumn, "=",
+											tables[__index], ".", __indexColumn, " AND ");
 			}
+			__query.reserve(__size);
+			
+			__query.append("SELECT ");
+			appendJoined(__query, columns, ", ", indexColumn);
+			appendParts(__query, " FROM ", __leftTable);
 			
-			for (UInt32 __i = 0; __i < tables.size(); ++__i)
+			if (tables.size() > 1)
 			{
-				if (tables.at(leftTableIndex) != tables.at(__i) and leftTableIndex != __i)
+				__query.append(" JOIN (");
+				appendJoined(__query, tables, ", ", leftTableIndex);
+				__query.append(") ON ");
+				
+				bool __first { true };
+				for (TSize __index = 0; __index < tables.size(); ++__index)
 				{
-					__queryStream << tables.at(leftTableIndex) << '.'
-								  << columns.at(indexColumn) << '='
-								  << tables.at(__i) << '.'
-								  << columns.at(indexColumn);
-					if (__i != tables.size() - 1)
-						__queryStream << " AND ";
+					if (__index == leftTableIndex or tables[__index] == __leftTable)
+						continue;
+					if (not __first)
+						__query.append(" AND ");
+					appendParts(__query, __leftTable, ".", __indexColumn, "=",
+								tables[__index], ".", __indexColumn);
+					__first = false;
 				}
 			}
 			
-			return this->resetQuery(__queryStream);
+			return __query;
 		}
 		
 		TQueryBuilder::TQuery
-		TQueryBuilder::selectQuery(const TString& table, const TString& column, TClause clause)
+		TQueryBuilder::selectQuery(const TString& table, const TString& column, TClause clause) const
 		{
-			TLockGuard __lockGuard(m_mutex);
-			TQueryStream __queryStream;
-			
-			__queryStream << "SELECT " << column << " FROM " << table;
+			if (clause.empty())
+				return makeQuery("SELECT ", column, " FROM ", table);
 			
-			if (not clause.empty())
-				__queryStream << " WHERE " << clause;
-			
-			return this->resetQuery(__queryStream);
+			return makeQuery("SELECT ", column, " FROM ", table, " WHERE ", clause);
 		}
 		
 		TQueryBuilder::TQuery
-		TQueryBuilder::selectQuery(const TString& table, const TStringVector& columns, UInt32 indexColumn)
+		TQueryBuilder::selectQuery(const TString& table, const TStringVector& columns, UInt32 indexColumn) const
 		{
-			TLockGuard __lockGuard(m_mutex);
-			TQueryStream __queryStream;
-			
-			__queryStream << "SELECT ";
-			
-			for (UInt32 index = 0; index < columns.size(); index++)
-			{
-				if (index != indexColumn)
-					__queryStream << columns.at(index);
-				if (index != columns.size() - 1 and index != indexColumn)
-					__queryStream << ',';
-				__queryStream << g_whiteSpace;
-			}
+			TString __query {};
+			__query.reserve(partsSize("SELECT ", " FROM ", table) + joinedSize(columns, ", ", indexColumn));
 			
-			__queryStream << " FROM " << table;
+			__query.append("SELECT ");
+			appendJoined(__query, columns, ", ", indexColumn);
+			appendParts(__query, " FROM ", table);
 			
-			return this->resetQuery(__queryStream);
+			return __query;
 		}
 		
 		TQueryBuilder::TQuery
-		TQueryBuilder::selectQuery(const TString& table, const TStringVector& columns, TClause clause)
+		TQueryBuilder::selectQuery(const TString& table, const TStringVector& columns, TClause clause) const
 		{
-			TLockGuard __lockGuard(m_mutex);
-			TQueryStream __queryStream;
-			uint index {};
+			TString __query {};
+			__query.reserve(partsSize("SELECT ", " FROM ", table, " ", clause) + joinedSize(columns, ", "));
 			
-			__queryStream << "SELECT ";
+			__query.append("SELECT ");
+			appendJoined(__query, columns, ", ");
+			appendParts(__query, " FROM ", table, " ", clause);
 			
-			for (const auto& column : columns)
-				__queryStream << column << ( index++ == columns.size() - 1 ? "" : ", " );
-			
-			__queryStream << g_whiteSpace << " FROM " << table << g_whiteSpace << clause;
-			
-			return this->resetQuery(__queryStream);
+			return __query;
 		}
 		
 		TQueryBuilder::TQuery
 		TQueryBuilder::selectLikeQuery(const TStringVector& tables, const TStringVector& columns,
 									   const TString& text, UInt32 comparatorColumn,
-									   UInt32 leftTableIndex, UInt32 fieldIndex, bool asRegex)
+									   UInt32 leftTableIndex, UInt32 fieldIndex, bool asRegex) const
 		{
-			TLockGuard __lockGuard(m_mutex);
-			TQueryStream __queryStream;
+			auto __query = this->selectQuery(tables, columns, comparatorColumn, leftTableIndex);
+			const auto& __field = columns.at(fieldIndex);
 			
-			this->selectQuery(tables, columns, comparatorColumn, leftTableIndex);
-			__queryStream << " WHERE " << columns.at(fieldIndex)
-						  << " LIKE \"" << ( asRegex ? "\'%" : "" )
-						  << text << '%' << "\"";
+			__query.reserve(__query.size() + partsSize(" WHERE ", __field, " LIKE \"%", text, "%\""));
+			appendParts(__query, " WHERE ", __field, ( asRegex ? " LIKE \"%" : " LIKE \"" ), text, "%\"");
 			
-			return this->resetQuery(__queryStream);
+			return __query;
 		}
 		
 		TQueryBuilder::TQuery
-		TQueryBuilder::updateQuery(const TString& tableName, const std::list<TValue*>& dbValueList)
+		TQueryBuilder::updateQuery(const TString& tableName, const std::list<TValue*>& dbValueList) const
 		{
-			TLockGuard __lockGuard(m_mutex);
-			TQueryStream __queryStream;
+			TString __query {};
+			TSize __size(partsSize("UPDATE ", tableName, " SET "));
+			for (const auto& __value : dbValueList)
+				__size += partsSize(__value->getValueName(), "=?, ");
+			__query.reserve(__size);
 			
+			appendParts(__query, "UPDATE ", tableName, " SET ");
+			
+			bool __first { true };
 			for (const auto& __value : dbValueList)
-				__queryStream << "UPDATE " << tableName
-							  << " SET " << __value->getValueName() << "=, ";
+			{
+				if (not __first)
+					__query.append(", ");
+				appendParts(__query, __value->getValueName(), "=?");
+				__first = false;
+			}
 			
-			return this->resetQuery(__queryStream);
+			return __query;
+		}
+		
+		TQueryBuilder::TQuery
+		TQueryBuilder::equalClause(const TString& column, TClause value) const
+		{
+			TString __query {};
+			__query.reserve(partsSize(column, " = \"\"") + 2 * value.size());
+			appendParts(__query, column, " = ");
+			appendQuoted(__query, value);
+			return __query;
+		}
+		
+		TQueryBuilder::TQuery
+		TQueryBuilder::prefixClause(const TString& column, TClause prefix) const
+		{
+			TString __query {};
+			__query.reserve(partsSize(column, " LIKE \"%\"") + 4 * prefix.size());
+			appendParts(__query, column, " LIKE ");
+			appendLikeQuoted(__query, prefix, "%");
+			return __query;
 		}
 		
-		inline TString&
-		TQueryBuilder::resetQuery(std::ostringstream& stream)
+		TQueryBuilder::TQuery
+		TQueryBuilder::pageQuery(const TString& table, const TStringVector& columns, TClause clause,
+								 const TString& keyColumn, const TString& tieColumn,
+								 const TStringPair& after, TSize limit) const
 		{
-			m_query.clear();
-			m_query = stream.str();
-			return m_query;
+			TString __query {};
+			const auto __limit = std::to_string(limit);
+			const bool __hasAfter(not after.second.empty());
+			
+			TSize __size(partsSize("SELECT ", " FROM ", table, " WHERE () AND ",
+								   " ORDER BY ", keyColumn, ", ", tieColumn, " LIMIT ", __limit)
+						 + joinedSize(columns, ", ") + clause.size());
+			if (__hasAfter)
+				__size += partsSize("( > \"\" OR ( = \"\" AND  > \"\"))", keyColumn, keyColumn, tieColumn)
+						  + 2 * ( after.first.size() + after.second.size());
+			__query.reserve(__size);
+			
+			__query.append("SELECT ");
+			appendJoined(__query, columns, ", ");
+			appendParts(__query, " FROM ", table);
+			
+			if (not clause.empty() or __hasAfter)
+				__query.append(" WHERE ");
+			if (not clause.empty())
+				appendParts(__query, "(", clause, ")");
+			if (not clause.empty() and __hasAfter)
+				__query.append(" AND ");
+			if (__hasAfter)
+			{
+				appendParts(__query, "(", keyColumn, " > ");
+				appendQuoted(__query, after.first);
+				appendParts(__query, " OR (", keyColumn, " = ");
+				appendQuoted(__query, after.first);
+				appendParts(__query, " AND ", tieColumn, " > ");
+				appendQuoted(__query, after.second);
+				__query.append("))");
+			}
+			appendParts(__query, " ORDER BY ", keyColumn, ", ", tieColumn, " LIMIT ", __limit);
+			
+			return __query;
 		}
 	} // namespace Database
 } // namespace Dixter
\ No newline at end of file
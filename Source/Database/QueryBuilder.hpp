@@ -10,7 +10,6 @@
 #pragma once
 
 #include <vector>
-#include <mutex>
 #include <list>
 
 namespace Dixter
@@ -29,53 +28,76 @@ namespace Dixter
 			using TStringVector     = std::vector<TString>;
 			#ifdef HAVE_CXX17
 			using TClause           = TStringView;
-			using TQuery            = TStringView;
 			#else
 			using TClause           = TString;
-			using TQuery            = TString;
 			#endif
+			using TQuery            = TString;
 		public:
 			/**
 			 * @brief Initializes structures
+			 *
+			 * Builder holds no state, every query is returned as a new string
+			 * sized once, so one instance can be shared between threads.
 			 * */
-			TQueryBuilder() noexcept;
+			TQueryBuilder() noexcept = default;
 			
 			~TQueryBuilder() noexcept = default;
 			
-			TQuery describeQuery(const TString& tableName);
+			TQuery describeQuery(const TString& tableName) const;
 			
-			TQuery dropQuery(const TString& tableName);
+			TQuery dropQuery(const TString& tableName) const;
 			
 			TQuery createQuery(const TString& tableName, const std::list<TValue*>& dbValueList,
-							   TSize& parametersNum);
+							   TSize& parametersNum) const;
 			
-			TQuery insertQuery(const TString& tableName, const TSize& parametersNum);
+			/**
+			 * Create parameterized insert query
+			 * @param parametersNum Number of columns per row
+			 * @param rowsNum Number of rows inserted by a single statement
+			 * */
+			TQuery insertQuery(const TString& tableName, const TSize& parametersNum,
+							   const TSize& rowsNum = 1) const;
 			
 			/**
 			 * Create query
 			 * */
 			TQuery selectQuery(const TStringVector& tables, const TStringVector& columns,
-							   UInt32 indexColumn, UInt32 leftTableIndex);
+							   UInt32 indexColumn, UInt32 leftTableIndex) const;
 			
-			TQuery selectQuery(const TString& table, const TString& column, TClause clause = "");
+			TQuery selectQuery(const TString& table, const TString& column, TClause clause = "") const;
 			
-			TQuery selectQuery(const TString& table, const TStringVector& columns, UInt32 indexColumn);
+			TQuery selectQuery(const TString& table, const TStringVector& columns, UInt32 indexColumn) const;
 			
-			TQuery selectQuery(const TString& table, const TStringVector& columns, TClause clause);
+			TQuery selectQuery(const TString& table, const TStringVector& columns, TClause clause) const;
 			
 			TQuery selectLikeQuery(const TStringVector& tables, const TStringVector& columns,
 								   const TString& text, UInt32 comparatorColumn,
-								   UInt32 leftTableIndex, UInt32 fieldIndex, bool asRegex = false);
+								   UInt32 leftTableIndex, UInt32 fieldIndex, bool asRegex = false) const;
 			
-			TQuery updateQuery(const TString& tableName, const std::list<TValue*>& dbValueList);
-		
-		private:
-			TString& resetQuery(std::ostringstream& stream);
-		
-		private:
-			TString m_query;
+			TQuery updateQuery(const TString& tableName, const std::list<TValue*>& dbValueList) const;
+			
+			/**
+			 * Create filter matching column values equal to value, value is quoted.
+			 * */
+			TQuery equalClause(const TString& column, TClause value) const;
 			
-			mutable std::mutex m_mutex;
+			/**
+			 * Create filter matching column values starting with prefix.
+			 * Prefix is quoted and its '%' and '_' match literally.
+			 * */
+			TQuery prefixClause(const TString& column, TClause prefix) const;
+			
+			/**
+			 * Create keyset paginated query ordered by key column,
+			 * tie-breaker column orders rows with equal keys.
+			 * @param clause Filter without WHERE, may be empty
+			 * @param after Key and tie-breaker values of the last row of previous page,
+			 * first page is selected if tie-breaker value is empty
+			 * @param limit Maximal number of rows
+			 * */
+			TQuery pageQuery(const TString& table, const TStringVector& columns, TClause clause,
+							 const TString& keyColumn, const TString& tieColumn,
+							 const TStringPair& after, TSize limit) const;
 		};
 	} // namespace Database
 } // namespace Dixter
\ No newline at end of file
@@ -0,0 +1,296 @@
+/**
+ *  Copyright (C) 2015-2019
+ *  Author Alvin Ahmadov <alvin.dev.ahmadov@gmail.com>
+ *
+ *  This file is part of Dixter Project
+ *  License-Identifier: MIT License
+ *  See README.md for more information.
+ */
+
+#include <cctype>
+#include <limits>
+#include <iostream>
+
+#include "Macros.hpp"
+#include "Database/QueryStats.hpp"
+
+namespace Dixter
+{
+	namespace Database
+	{
+		namespace
+		{
+			using TLockGuard = std::lock_guard<std::mutex>;
+			
+			inline bool isIdentifierChar(TByte c) noexcept
+			{
+				return std::isalnum(static_cast<unsigned char>(c)) or c == '_' or c == '$';
+			}
+			
+			void appendJsonString(TString& json, TStringView value)
+			{
+				json.push_back('"');
+				for (auto __c : value)
+				{
+					switch (__c)
+					{
+						case '"':
+							json.append("\\\"");
+							break;
+						case '\\':
+							json.append("\\\\");
+							break;
+						case '\n':
+							json.append("\\n");
+							break;
+						case '\t':
+							json.append("\\t");
+							break;
+						default:
+							if (static_cast<unsigned char>(__c) < 0x20)
+								json.append("\\u00").append({ "0123456789abcdef"[__c >> 4],
+															  "0123456789abcdef"[__c & 0xf] });
+							else
+								json.push_back(__c);
+					}
+				}
+				json.push_back('"');
+			}
+			
+			void appendJsonHistogram(TString& json, const TLatencyHistogram& histogram)
+			{
+				json.append("{\"count\":").append(std::to_string(histogram.count()))
+					.append(",\"min\":").append(std::to_string(histogram.min()))
+					.append(",\"max\":").append(std::to_string(histogram.max()))
+					.append(",\"mean\":").append(std::to_string(histogram.mean()))
+					.append(",\"p50\":").append(std::to_string(histogram.percentile(50.0)))
+					.append(",\"p90\":").append(std::to_string(histogram.percentile(90.0)))
+					.append(",\"p99\":").append(std::to_string(histogram.percentile(99.0)))
+					.append(",\"p999\":").append(std::to_string(histogram.percentile(99.9)))
+					.push_back('}');
+			}
+		} // anonymous namespace
+		
+		// TLatencyHistogram implementation
+		TLatencyHistogram::TLatencyHistogram() noexcept
+				: m_buckets(),
+				  m_count(),
+				  m_min(std::numeric_limits<UInt64>::max()),
+				  m_max(),
+				  m_sum()
+		{ }
+		
+		void TLatencyHistogram::record(UInt64 value) noexcept
+		{
+			++m_buckets[indexOf(value)];
+			++m_count;
+			m_sum += value;
+			m_min = std::min(m_min, value);
+			m_max = std::max(m_max, value);
+		}
+		
+		void TLatencyHistogram::reset() noexcept
+		{
+			*this = TLatencyHistogram();
+		}
+		
+		UInt64 TLatencyHistogram::count() const noexcept
+		{
+			return m_count;
+		}
+		
+		UInt64 TLatencyHistogram::min() const noexcept
+		{
+			return m_count ? m_min : 0;
+		}
+		
+		UInt64 TLatencyHistogram::max() const noexcept
+		{
+			return m_max;
+		}
+		
+		Real32 TLatencyHistogram::mean() const noexcept
+		{
+			return m_count ? static_cast<Real32>(m_sum) / m_count : 0.0;
+		}
+		
+		UInt64 TLatencyHistogram::percentile(Real32 percentile) const noexcept
+		{
+			if (not m_count)
+				return 0;
+			
+			percentile = std::min(std::max(percentile, 0.0), 100.0);
+			auto __rank = static_cast<UInt64>(percentile / 100.0 * m_count + 0.5);
+			__rank = std::max(__rank, UInt64(1));
+			
+			UInt64 __seen {};
+			for (TSize __index {}; __index < kBuckets; ++__index)
+			{
+				__seen += m_buckets[__index];
+				if (__seen >= __rank)
+					return std::min(upperBoundOf(__index), m_max);
+			}
+			return m_max;
+		}
+		
+		TSize TLatencyHistogram::indexOf(UInt64 value) noexcept
+		{
+			if (value < kSubBuckets)
+				return static_cast<TSize>(value);
+			
+			UInt32 __magnitude { kSubBucketBits };
+			while (value >> ( __magnitude + 1 ))
+				++__magnitude;
+			
+			const UInt32 __shift(__magnitude - kSubBucketBits);
+			return ( __shift + 1 ) * kSubBuckets + static_cast<TSize>(( value >> __shift ) - kSubBuckets);
+		}
+		
+		UInt64 TLatencyHistogram::upperBoundOf(TSize index) noexcept
+		{
+			if (index < kSubBuckets)
+				return index;
+			
+			const auto __shift = static_cast<UInt32>(index / kSubBuckets - 1);
+			const UInt64 __subBucket(kSubBuckets + index % kSubBuckets);
+			return (( __subBucket + 1 ) << __shift ) - 1;
+		}
+		
+		// TQueryStats implementation
+		TQueryStats::TShapeStats::TShapeStats() noexcept
+				: errors_(),
+				  phases_()
+		{ }
+		
+		TQueryStats::TQueryStats(UInt32 slowQueryThreshold) noexcept
+				: m_shapes(),
+				  m_slowQueryThreshold(slowQueryThreshold),
+				  m_mutex()
+		{ }
+		
+		void TQueryStats::record(const TString& query, EPhase phase, TClock::duration duration)
+		{
+			const auto __micros = std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+			{
+				auto __shape = shapeOf(query);
+				TLockGuard __lockGuard(m_mutex);
+				m_shapes[std::move(__shape)].phases_[static_cast<TSize>(phase)]
+						.record(static_cast<UInt64>(std::max(__micros, decltype(__micros)(0))));
+			}
+			
+			const auto __threshold = m_slowQueryThreshold.load(std::memory_order_relaxed);
+			if (__threshold and __micros >= static_cast<decltype(__micros)>(__threshold) * 1000)
+			{
+				printl_log("Slow query " << phaseName(phase) << " took "
+										 << __micros / 1000 << " ms: " << query)
+			}
+		}
+		
+		void TQueryStats::recordError(const TString& query)
+		{
+			auto __shape = shapeOf(query);
+			TLockGuard __lockGuard(m_mutex);
+			++m_shapes[std::move(__shape)].errors_;
+		}
+		
+		void TQueryStats::setSlowQueryThreshold(UInt32 slowQueryThreshold) noexcept
+		{
+			m_slowQueryThreshold.store(slowQueryThreshold, std::memory_order_relaxed);
+		}
+		
+		UInt32 TQueryStats::getSlowQueryThreshold() const noexcept
+		{
+			return m_slowQueryThreshold.load(std::memory_order_relaxed);
+		}
+		
+		void TQueryStats::reset()
+		{
+			TLockGuard __lockGuard(m_mutex);
+			m_shapes.clear();
+		}
+		
+		TString TQueryStats::toJson() const
+		{
+			TLockGuard __lockGuard(m_mutex);
+			TString __json("{\"slow_query_ms\":");
+			__json.append(std::to_string(this->getSlowQueryThreshold())).append(",\"queries\":[");
+			
+			bool __first { true };
+			for (const auto& [__shape, __stats] : m_shapes)
+			{
+				if (not __first)
+					__json.push_back(',');
+				__json.append("{\"shape\":");
+				appendJsonString(__json, __shape);
+				__json.append(",\"errors\":").append(std::to_string(__stats.errors_));
+				for (auto __phase : { EPhase::kBuild, EPhase::kExecute, EPhase::kFetch })
+				{
+					__json.append(",\"");
+					__json.append(phaseName(__phase)).append("_us\":");
+					appendJsonHistogram(__json, __stats.phases_[static_cast<TSize>(__phase)]);
+				}
+				__json.push_back('}');
+				__first = false;
+			}
+			__json.append("]}");
+			
+			return __json;
+		}
+		
+		TString TQueryStats::shapeOf(TStringView query)
+		{
+			TString __shape {};
+			__shape.reserve(query.size());
+			
+			for (TSize __index {}; __index < query.size(); ++__index)
+			{
+				const auto __c = query[__index];
+				
+				// quoted literal, doubled quote is an escaped one
+				if (__c == '\'' or __c == '"')
+				{
+					while (++__index < query.size())
+					{
+						if (query[__index] == '\\')
+							++__index;
+						else if (query[__index] == __c)
+						{
+							if (__index + 1 < query.size() and query[__index + 1] == __c)
+								++__index;
+							else
+								break;
+						}
+					}
+					__shape.push_back('?');
+				}
+				// numeric literal not being a part of identifier
+				else if (std::isdigit(static_cast<unsigned char>(__c))
+						 and ( __shape.empty() or not isIdentifierChar(__shape.back())))
+				{
+					while (__index + 1 < query.size()
+						   and ( isIdentifierChar(query[__index + 1]) or query[__index + 1] == '.' ))
+						++__index;
+					__shape.push_back('?');
+				}
+				else
+					__shape.push_back(__c);
+			}
+			
+			return __shape;
+		}
+		
+		TStringView TQueryStats::phaseName(EPhase phase) noexcept
+		{
+			switch (phase)
+			{
+				case EPhase::kBuild:
+					return "build";
+				case EPhase::kExecute:
+					return "execute";
+				case EPhase::kFetch:
+					return "fetch";
+			}
+			return "unknown";
+		}
+	} // namespace Database
+} // namespace Dixter
\ No newline at end of file
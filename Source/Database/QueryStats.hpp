@@ -0,0 +1,146 @@
+/**
+ *  Copyright (C) 2015-2019
+ *  Author Alvin Ahmadov <alvin.dev.ahmadov@gmail.com>
+ *
+ *  This file is part of Dixter Project
+ *  License-Identifier: MIT License
+ *  See README.md for more information.
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+
+#include "Commons.hpp"
+
+namespace Dixter
+{
+	namespace Database
+	{
+		/**
+		 * \class TLatencyHistogram
+		 * \brief Log-linear latency histogram in the manner of HdrHistogram.
+		 *
+		 * Every power of two range is split into 2^kSubBucketBits linear buckets,
+		 * so recorded values keep about 6% precision over the whole 64 bit range
+		 * with fixed memory and no allocation on record.
+		 * */
+		class TLatencyHistogram
+		{
+		public:
+			static constexpr UInt32 kSubBucketBits = 4;
+			
+			static constexpr TSize kSubBuckets = TSize(1) << kSubBucketBits;
+			
+			static constexpr TSize kBuckets = ( 64 - kSubBucketBits + 1 ) * kSubBuckets;
+		
+		public:
+			TLatencyHistogram() noexcept;
+			
+			void record(UInt64 value) noexcept;
+			
+			void reset() noexcept;
+			
+			UInt64 count() const noexcept;
+			
+			UInt64 min() const noexcept;
+			
+			UInt64 max() const noexcept;
+			
+			Real32 mean() const noexcept;
+			
+			/**
+			 * Upper bound of bucket holding given percentile.
+			 * @param percentile Value in range [0, 100]
+			 * */
+			UInt64 percentile(Real32 percentile) const noexcept;
+		
+		private:
+			static TSize indexOf(UInt64 value) noexcept;
+			
+			static UInt64 upperBoundOf(TSize index) noexcept;
+		
+		private:
+			std::array<UInt64, kBuckets> m_buckets;
+			
+			UInt64 m_count;
+			
+			UInt64 m_min;
+			
+			UInt64 m_max;
+			
+			UInt64 m_sum;
+		};
+		
+		/**
+		 * \class TQueryStats
+		 * \brief Latency statistics of database queries grouped by query shape.
+		 *
+		 * Shape of a query is its text with string and numeric literals replaced
+		 * by '?', so lookups of different words in the same table share a shape.
+		 * Latencies are kept in microseconds per phase: building of the query text,
+		 * execution on server and reading of the result rows. Phases exceeding the
+		 * slow query threshold are written to log.
+		 * */
+		class TQueryStats : public TNonCopyable
+		{
+		public:
+			using TClock = std::chrono::steady_clock;
+			
+			enum class EPhase
+			{
+				/// Building of query text on client
+				kBuild,
+				kExecute,
+				/// Reading of result rows by cursors, time between blocks is not counted
+				kFetch
+			};
+			
+			struct TShapeStats
+			{
+				TShapeStats() noexcept;
+				
+				UInt64 errors_;
+				
+				std::array<TLatencyHistogram, 3> phases_;
+			};
+		
+		public:
+			/**
+			 * @param slowQueryThreshold Milliseconds, 0 disables slow query log
+			 * */
+			explicit TQueryStats(UInt32 slowQueryThreshold = 0) noexcept;
+			
+			~TQueryStats() noexcept override = default;
+			
+			void record(const TString& query, EPhase phase, TClock::duration duration);
+			
+			void recordError(const TString& query);
+			
+			void setSlowQueryThreshold(UInt32 slowQueryThreshold) noexcept;
+			
+			UInt32 getSlowQueryThreshold() const noexcept;
+			
+			void reset();
+			
+			/**
+			 * Dump statistics of every query shape as JSON object.
+			 * */
+			TString toJson() const;
+			
+			static TString shapeOf(TStringView query);
+			
+			static TStringView phaseName(EPhase phase) noexcept;
+		
+		private:
+			std::map<TString, TShapeStats> m_shapes;
+			
+			std::atomic<UInt32> m_slowQueryThreshold;
+			
+			mutable std::mutex m_mutex;
+		};
+	} // namespace Database
+} // namespace Dixter
\ No newline at end of file
@@ -0,0 +1,224 @@
+/**
+ *  Copyright (C) 2015-2019
+ *  Author Alvin Ahmadov <alvin.dev.ahmadov@gmail.com>
+ *
+ *  This file is part of Dixter Project
+ *  License-Identifier: MIT License
+ *  See README.md for more information.
+ */
+
+#include <cppconn/resultset.h>
+
+#include "Macros.hpp"
+#include "QueryStats.hpp"
+#include "RowCursor.hpp"
+
+namespace Dixter
+{
+	namespace Database
+	{
+		TFetchTimer::TFetchTimer(std::shared_ptr<TQueryStats> stats, TString query) noexcept
+				: m_stats(std::move(stats)),
+				  m_query(std::move(query)),
+				  m_duration(),
+				  m_finished(false)
+		{ }
+		
+		void TFetchTimer::operator()(sql::ResultSet* resultSet) noexcept
+		{
+			try
+			{
+				if (m_duration != TClock::duration::zero())
+					this->finish();
+			}
+			catch (std::exception& e)
+			{
+				printerr(e.what())
+			}
+			delete resultSet;
+		}
+		
+		void TFetchTimer::add(TClock::duration duration) noexcept
+		{
+			m_duration += duration;
+		}
+		
+		void TFetchTimer::finish()
+		{
+			if (m_finished)
+				return;
+			m_finished = true;
+			m_stats->record(m_query, TQueryStats::EPhase::kFetch, m_duration);
+		}
+		
+		void TTextBlock::reserve(TSize cellsNum)
+		{
+			m_cells.reserve(cellsNum);
+		}
+		
+		void TTextBlock::clear() noexcept
+		{
+			m_data.clear();
+			m_cells.clear();
+		}
+		
+		void TTextBlock::append(sql::ResultSet* resultSet, UInt32 column)
+		{
+			const TSize __offset(m_data.size());
+			m_data.append(resultSet->getString(column).asStdString());
+			m_cells.emplace_back(__offset, m_data.size() - __offset);
+		}
+		
+		TStringView TTextBlock::at(TSize index) const noexcept
+		{
+			const auto& [__offset, __length] = m_cells[index];
+			return TStringView(m_data.data() + __offset, __length);
+		}
+		
+		TSize TTextBlock::size() const noexcept
+		{
+			return m_cells.size();
+		}
+		
+		namespace NInternal
+		{
+			void TColumnTraits<TString>::fetch(sql::ResultSet* resultSet, UInt32 column, TStorage& storage)
+			{
+				storage.append(resultSet, column);
+			}
+			
+			void TColumnTraits<Int32>::fetch(sql::ResultSet* resultSet, UInt32 column, TStorage& storage)
+			{
+				storage.push_back(resultSet->getInt(column));
+			}
+			
+			void TColumnTraits<UInt32>::fetch(sql::ResultSet* resultSet, UInt32 column, TStorage& storage)
+			{
+				storage.push_back(resultSet->getUInt(column));
+			}
+			
+			void TColumnTraits<Int64>::fetch(sql::ResultSet* resultSet, UInt32 column, TStorage& storage)
+			{
+				storage.push_back(resultSet->getInt64(column));
+			}
+			
+			void TColumnTraits<UInt64>::fetch(sql::ResultSet* resultSet, UInt32 column, TStorage& storage)
+			{
+				storage.push_back(resultSet->getUInt64(column));
+			}
+			
+			void TColumnTraits<Real32>::fetch(sql::ResultSet* resultSet, UInt32 column, TStorage& storage)
+			{
+				storage.push_back(static_cast<Real32>(resultSet->getDouble(column)));
+			}
+			
+			void TColumnTraits<bool>::fetch(sql::ResultSet* resultSet, UInt32 column, TStorage& storage)
+			{
+				storage.push_back(resultSet->getBoolean(column));
+			}
+			
+			bool wasNull(sql::ResultSet* resultSet)
+			{
+				return resultSet->wasNull();
+			}
+			
+			bool nextRow(sql::ResultSet* resultSet)
+			{
+				return resultSet->next();
+			}
+			
+			void recordFetch(const std::shared_ptr<sql::ResultSet>& resultSet,
+							 TFetchTimer::TClock::time_point start, bool exhausted)
+			{
+				auto __timer = std::get_deleter<TFetchTimer>(resultSet);
+				if (not __timer)
+					return;
+				
+				__timer->add(TFetchTimer::TClock::now() - start);
+				if (exhausted)
+					__timer->finish();
+			}
+		} // namespace NInternal
+		
+		TTextCursor::TTextCursor(TResultSetPtr resultSet, TSize columnsNum,
+								 TSize blockSize, UInt32 firstColumn)
+				: m_resultSet(std::move(resultSet)),
+				  m_columnsNum(columnsNum),
+				  m_blockSize(blockSize ? blockSize : kDefaultBlockSize),
+				  m_size(),
+				  m_count(),
+				  m_firstColumn(firstColumn),
+				  m_exhausted(not m_resultSet),
+				  m_cells(),
+				  m_nulls()
+		{
+			m_cells.reserve(m_blockSize * m_columnsNum);
+			m_nulls.reserve(m_blockSize * m_columnsNum);
+		}
+		
+		bool TTextCursor::fetch()
+		{
+			m_cells.clear();
+			m_nulls.clear();
+			m_size = 0;
+			
+			if (m_exhausted)
+				return false;
+			
+			const auto __start = TFetchTimer::TClock::now();
+			while (not m_exhausted and m_size < m_blockSize)
+			{
+				if (not m_resultSet->next())
+				{
+					m_exhausted = true;
+					break;
+				}
+				for (TSize __column {}; __column < m_columnsNum; ++__column)
+				{
+					m_cells.append(m_resultSet.get(), m_firstColumn + static_cast<UInt32>(__column));
+					m_nulls.push_back(m_resultSet->wasNull());
+				}
+				++m_size;
+			}
+			NInternal::recordFetch(m_resultSet, __start, m_exhausted);
+			m_count += m_size;
+			
+			return m_size != 0;
+		}
+		
+		TSize TTextCursor::size() const noexcept
+		{
+			return m_size;
+		}
+		
+		TSize TTextCursor::count() const noexcept
+		{
+			return m_count;
+		}
+		
+		TSize TTextCursor::columnsNum() const noexcept
+		{
+			return m_columnsNum;
+		}
+		
+		TStringView TTextCursor::at(TSize index, TSize column) const
+		{
+			checkIndex(index, column);
+			return m_cells.at(index * m_columnsNum + column);
+		}
+		
+		bool TTextCursor::isNull(TSize index, TSize column) const
+		{
+			checkIndex(index, column);
+			return m_nulls[index * m_columnsNum + column];
+		}
+		
+		void TTextCursor::checkIndex(TSize index, TSize column) const
+		{
+			if (index >= m_size or column >= m_columnsNum)
+				throw TRangeException("%s:%d Cell (%u, %u) is out of block (%u, %u)",
+									  __FILE__, __LINE__, static_cast<UInt32>(index), static_cast<UInt32>(column),
+									  static_cast<UInt32>(m_size), static_cast<UInt32>(m_columnsNum));
+		}
+	} // namespace Database
+} // namespace Dixter
\ No newline at end of file
@@ -0,0 +1,320 @@
+/**
+ *  Copyright (C) 2015-2019
+ *  Author Alvin Ahmadov <alvin.dev.ahmadov@gmail.com>
+ *
+ *  This file is part of Dixter Project
+ *  License-Identifier: MIT License
+ *  See README.md for more information.
+ */
+
+#pragma once
+
+#include <tuple>
+#include <chrono>
+#include <memory>
+#include <vector>
+#include <utility>
+
+#include "Commons.hpp"
+
+namespace sql
+{
+	class ResultSet;
+} // namespace sql
+
+namespace Dixter
+{
+	namespace Database
+	{
+		class TQueryStats;
+		
+		/**
+		 * \class TFetchTimer
+		 * \brief Deleter of result sets returned by TManager, sums time spent reading rows.
+		 *
+		 * Cursors add time of every block they fetch and finish the timer once the
+		 * result set has no more rows, then the sum is recorded as fetch phase of the query.
+		 * Time the consumer keeps the result set is not counted. Result set released
+		 * before its end records time of rows read so far.
+		 * */
+		class TFetchTimer
+		{
+		public:
+			using TClock = std::chrono::steady_clock;
+		
+		public:
+			TFetchTimer(std::shared_ptr<TQueryStats> stats, TString query) noexcept;
+			
+			void operator()(sql::ResultSet* resultSet) noexcept;
+			
+			void add(TClock::duration duration) noexcept;
+			
+			void finish();
+		
+		private:
+			std::shared_ptr<TQueryStats> m_stats;
+			
+			TString m_query;
+			
+			TClock::duration m_duration;
+			
+			bool m_finished;
+		};
+		
+		/**
+		 * Text cells of fetched block stored back to back in a single buffer.
+		 * Buffer keeps its capacity between blocks, so cells are not allocated one by one.
+		 * */
+		class TTextBlock
+		{
+		public:
+			TTextBlock() noexcept = default;
+			
+			void reserve(TSize cellsNum);
+			
+			void clear() noexcept;
+			
+			void append(sql::ResultSet* resultSet, UInt32 column);
+			
+			/**
+			 * View of cell. Valid until next clear of the block.
+			 * */
+			TStringView at(TSize index) const noexcept;
+			
+			TSize size() const noexcept;
+		
+		private:
+			TString m_data;
+			
+			std::vector<std::pair<TSize, TSize>> m_cells;
+		};
+		
+		namespace NInternal
+		{
+			template<typename T>
+			struct TScalarColumn
+			{
+				using TStorage  = std::vector<T>;
+				using TView     = T;
+				
+				static TView view(const TStorage& storage, TSize index) noexcept
+				{
+					return storage[index];
+				}
+			};
+			
+			/**
+			 * Column type of the cursor schema.
+			 * Defines storage of fetched block and how value is pulled from result set.
+			 * */
+			template<typename T>
+			struct TColumnTraits;
+			
+			template<>
+			struct TColumnTraits<TString>
+			{
+				using TStorage  = TTextBlock;
+				using TView     = TStringView;
+				
+				static void fetch(sql::ResultSet* resultSet, UInt32 column, TStorage& storage);
+				
+				static TView view(const TStorage& storage, TSize index) noexcept
+				{
+					return storage.at(index);
+				}
+			};
+			
+			template<>
+			struct TColumnTraits<Int32> : TScalarColumn<Int32>
+			{
+				static void fetch(sql::ResultSet* resultSet, UInt32 column, TStorage& storage);
+			};
+			
+			template<>
+			struct TColumnTraits<UInt32> : TScalarColumn<UInt32>
+			{
+				static void fetch(sql::ResultSet* resultSet, UInt32 column, TStorage& storage);
+			};
+			
+			template<>
+			struct TColumnTraits<Int64> : TScalarColumn<Int64>
+			{
+				static void fetch(sql::ResultSet* resultSet, UInt32 column, TStorage& storage);
+			};
+			
+			template<>
+			struct TColumnTraits<UInt64> : TScalarColumn<UInt64>
+			{
+				static void fetch(sql::ResultSet* resultSet, UInt32 column, TStorage& storage);
+			};
+			
+			template<>
+			struct TColumnTraits<Real32> : TScalarColumn<Real32>
+			{
+				static void fetch(sql::ResultSet* resultSet, UInt32 column, TStorage& storage);
+			};
+			
+			template<>
+			struct TColumnTraits<bool> : TScalarColumn<bool>
+			{
+				static void fetch(sql::ResultSet* resultSet, UInt32 column, TStorage& storage);
+			};
+			
+			bool wasNull(sql::ResultSet* resultSet);
+			
+			bool nextRow(sql::ResultSet* resultSet);
+			
+			/// Add time of block fetched since start to timer of result set, if it has one
+			void recordFetch(const std::shared_ptr<sql::ResultSet>& resultSet,
+							 TFetchTimer::TClock::time_point start, bool exhausted);
+		} // namespace NInternal
+		
+		/**
+		 * \class TRowCursor
+		 * \brief Reads result set in blocks of rows with compile-time column schema.
+		 *
+		 * Rows are fetched into buffers owned by cursor and reused by every block,
+		 * text columns are exposed as views into those buffers. Views are valid
+		 * until the next call of fetch().
+		 * \code
+		 * TRowCursor<Int32, TString> __cursor(manager->selectColumns(table, columns, 0));
+		 * while (__cursor.fetch())
+		 * 	for (TSize __index {}; __index < __cursor.size(); ++__index)
+		 * 		auto [__id, __word] = __cursor.row(__index);
+		 * \endcode
+		 * \tparam TColumns Column types in order of selection
+		 * */
+		template<typename... TColumns>
+		class TRowCursor : public TNonCopyable
+		{
+		public:
+			using TResultSetPtr = std::shared_ptr<sql::ResultSet>;
+			using TSchema       = std::tuple<TColumns...>;
+			using TRow          = std::tuple<typename NInternal::TColumnTraits<TColumns>::TView...>;
+			using TStorage      = std::tuple<typename NInternal::TColumnTraits<TColumns>::TStorage...>;
+			
+			template<TSize N>
+			using TColumnView = std::tuple_element_t<N, TRow>;
+			
+			static constexpr TSize kColumnsNum = sizeof...(TColumns);
+			
+			static constexpr TSize kDefaultBlockSize = 256;
+		
+		public:
+			/**
+			 * @param blockSize Rows fetched at once
+			 * @param firstColumn Result set index of the first schema column
+			 * */
+			explicit TRowCursor(TResultSetPtr resultSet,
+								TSize blockSize = kDefaultBlockSize,
+								UInt32 firstColumn = 1);
+			
+			~TRowCursor() noexcept override = default;
+			
+			/**
+			 * Fetch next block of rows, replacing current one.
+			 * @returns false if result set has no more rows
+			 * */
+			bool fetch();
+			
+			/// Rows in current block
+			TSize size() const noexcept;
+			
+			/// Rows fetched since construction
+			TSize count() const noexcept;
+			
+			TRow row(TSize index) const;
+			
+			template<TSize N>
+			TColumnView<N> get(TSize index) const;
+			
+			bool isNull(TSize index, TSize column) const;
+		
+		private:
+			template<TSize... Ns>
+			void fetchRow(std::index_sequence<Ns...>);
+			
+			template<TSize... Ns>
+			TRow makeRow(TSize index, std::index_sequence<Ns...>) const;
+			
+			void checkIndex(TSize index, TSize column = 0) const;
+		
+		private:
+			TResultSetPtr m_resultSet;
+			
+			TSize m_blockSize;
+			
+			TSize m_size;
+			
+			TSize m_count;
+			
+			UInt32 m_firstColumn;
+			
+			bool m_exhausted;
+			
+			TStorage m_columns;
+			
+			std::vector<bool> m_nulls;
+		};
+		
+		/**
+		 * \class TTextCursor
+		 * \brief Block cursor for result sets whose columns are known at runtime only.
+		 *
+		 * Every column is read as text into a single reused buffer.
+		 * */
+		class TTextCursor : public TNonCopyable
+		{
+		public:
+			using TResultSetPtr = std::shared_ptr<sql::ResultSet>;
+			
+			static constexpr TSize kDefaultBlockSize = 256;
+		
+		public:
+			TTextCursor(TResultSetPtr resultSet, TSize columnsNum,
+						TSize blockSize = kDefaultBlockSize,
+						UInt32 firstColumn = 1);
+			
+			~TTextCursor() noexcept override = default;
+			
+			bool fetch();
+			
+			TSize size() const noexcept;
+			
+			TSize count() const noexcept;
+			
+			TSize columnsNum() const noexcept;
+			
+			/**
+			 * View of cell. Valid until next call of fetch().
+			 * */
+			TStringView at(TSize index, TSize column) const;
+			
+			bool isNull(TSize index, TSize column) const;
+		
+		private:
+			void checkIndex(TSize index, TSize column) const;
+		
+		private:
+			TResultSetPtr m_resultSet;
+			
+			TSize m_columnsNum;
+			
+			TSize m_blockSize;
+			
+			TSize m_size;
+			
+			TSize m_count;
+			
+			UInt32 m_firstColumn;
+			
+			bool m_exhausted;
+			
+			TTextBlock m_cells;
+			
+			std::vector<bool> m_nulls;
+		};
+	} // namespace Database
+} // namespace Dixter
+
+#include "RowCursorImpl.hpp"
\ No newline at end of file
@@ -0,0 +1,129 @@
+/**
+ *  Copyright (C) 2015-2019
+ *  Author Alvin Ahmadov <alvin.dev.ahmadov@gmail.com>
+ *
+ *  This file is part of Dixter Project
+ *  License-Identifier: MIT License
+ *  See README.md for more information.
+ */
+#pragma once
+
+#include "Exception.hpp"
+
+namespace Dixter
+{
+	namespace Database
+	{
+		/// Row cursor implementation
+		template<typename... TColumns>
+		TRowCursor<TColumns...>::TRowCursor(TResultSetPtr resultSet, TSize blockSize, UInt32 firstColumn)
+				: m_resultSet(std::move(resultSet)),
+				  m_blockSize(blockSize ? blockSize : kDefaultBlockSize),
+				  m_size(),
+				  m_count(),
+				  m_firstColumn(firstColumn),
+				  m_exhausted(not m_resultSet),
+				  m_columns(),
+				  m_nulls()
+		{
+			std::apply([this](auto&... __storage) {
+				( __storage.reserve(m_blockSize), ... );
+			}, m_columns);
+			m_nulls.reserve(m_blockSize * kColumnsNum);
+		}
+		
+		template<typename... TColumns>
+		bool TRowCursor<TColumns...>::fetch()
+		{
+			std::apply([](auto&... __storage) {
+				( __storage.clear(), ... );
+			}, m_columns);
+			m_nulls.clear();
+			m_size = 0;
+			
+			if (m_exhausted)
+				return false;
+			
+			const auto __start = TFetchTimer::TClock::now();
+			while (not m_exhausted and m_size < m_blockSize)
+			{
+				if (not NInternal::nextRow(m_resultSet.get()))
+				{
+					m_exhausted = true;
+					break;
+				}
+				this->fetchRow(std::index_sequence_for<TColumns...> {});
+				++m_size;
+			}
+			NInternal::recordFetch(m_resultSet, __start, m_exhausted);
+			m_count += m_size;
+			
+			return m_size != 0;
+		}
+		
+		template<typename... TColumns>
+		TSize TRowCursor<TColumns...>::size() const noexcept
+		{
+			return m_size;
+		}
+		
+		template<typename... TColumns>
+		TSize TRowCursor<TColumns...>::count() const noexcept
+		{
+			return m_count;
+		}
+		
+		template<typename... TColumns>
+		typename TRowCursor<TColumns...>::TRow
+		TRowCursor<TColumns...>::row(TSize index) const
+		{
+			checkIndex(index);
+			return makeRow(index, std::index_sequence_for<TColumns...> {});
+		}
+		
+		template<typename... TColumns>
+		template<TSize N>
+		typename TRowCursor<TColumns...>::template TColumnView<N>
+		TRowCursor<TColumns...>::get(TSize index) const
+		{
+			static_assert(N < kColumnsNum, "Column index is out of schema");
+			checkIndex(index);
+			using TTraits = NInternal::TColumnTraits<std::tuple_element_t<N, TSchema>>;
+			return TTraits::view(std::get<N>(m_columns), index);
+		}
+		
+		template<typename... TColumns>
+		bool TRowCursor<TColumns...>::isNull(TSize index, TSize column) const
+		{
+			checkIndex(index, column);
+			return m_nulls[index * kColumnsNum + column];
+		}
+		
+		template<typename... TColumns>
+		template<TSize... Ns>
+		void TRowCursor<TColumns...>::fetchRow(std::index_sequence<Ns...>)
+		{
+			auto __resultSet = m_resultSet.get();
+			(( NInternal::TColumnTraits<TColumns>::
+			   fetch(__resultSet, m_firstColumn + static_cast<UInt32>(Ns), std::get<Ns>(m_columns)),
+			   m_nulls.push_back(NInternal::wasNull(__resultSet)) ), ... );
+		}
+		
+		template<typename... TColumns>
+		template<TSize... Ns>
+		typename TRowCursor<TColumns...>::TRow
+		TRowCursor<TColumns...>::makeRow(TSize index, std::index_sequence<Ns...>) const
+		{
+			return TRow { NInternal::TColumnTraits<TColumns>::view(std::get<Ns>(m_columns), index)... };
+		}
+		
+		template<typename... TColumns>
+		void TRowCursor<TColumns...>::checkIndex(TSize index, TSize column) const
+		{
+			if (index >= m_size or column >= kColumnsNum)
+				throw TRangeException("%s:%d Cell (%u, %u) is out of block (%u, %u)",
+									  __FILE__, __LINE__, static_cast<UInt32>(index), static_cast<UInt32>(column),
+									  static_cast<UInt32>(m_size), static_cast<UInt32>(kColumnsNum));
+		}
+	} // namespace Database
+} // namespace Dixter
\ No newline at end of file
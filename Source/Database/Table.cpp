@@ -55,9 +55,12 @@ namespace Dixter
 		}
 		
 		sql::PreparedStatement*
-		TTable::insertValues(sql::Connection* connection)
+		TTable::insertValues(sql::Connection* connection, TSize rowsNum)
 		{
-			auto __query = m_queryBuilder->insertQuery(m_tableName, m_paramsSize);
+			if (connection == nullptr)
+				throw TIllegalArgumentException("%s:%d Connection is NULL.\n", __FILE__, __LINE__);
+			
+			auto __query = m_queryBuilder->insertQuery(m_tableName, m_paramsSize, rowsNum);
 			auto __result = connection->prepareStatement(__query.data());
 			return __result;
 		}
@@ -40,8 +40,14 @@ namespace Dixter
 			
 			void createTable(sql::Statement* statement, bool dropIf = true);
 			
+			/**
+			 * Prepare insert statement for \c rowsNum rows at once
+			 * @param connection Connection to prepare statement with
+			 * @param rowsNum Number of rows bound to the statement
+			 * @returns Prepared statement owned by caller
+			 * */
 			sql::PreparedStatement*
-			insertValues(sql::Connection* connection);
+			insertValues(sql::Connection* connection, TSize rowsNum = 1);
 			
 			sql::PreparedStatement*
 			updateValues(sql::Connection* connection);
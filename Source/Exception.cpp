@@ -63,4 +63,6 @@ namespace Dixter
 	DEF_DETAILED_EXCEPTION(TRangeException)
 	
 	DEF_DETAILED_EXCEPTION(TSQLException)
+	
+	DEF_DETAILED_EXCEPTION(TParseException)
 } // namespace Dixter
\ No newline at end of file
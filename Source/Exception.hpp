@@ -62,4 +62,6 @@ namespace Dixter
 	DECL_DETAILED_EXCEPTION(TRangeException)
 	
 	DECL_DETAILED_EXCEPTION(TSQLException)
+	
+	DECL_DETAILED_EXCEPTION(TParseException)
 } // namespace Dixter
\ No newline at end of file
@@ -10,8 +10,12 @@
 
 #include "GroupElement.hpp"
 #include "MethodCallback.hpp"
+#include "ThreadPool.hpp"
 #include <cassert>
+#include <deque>
 #include <mutex>
+#include <optional>
+#include <vector>
 
 namespace Dixter
 {
@@ -23,6 +27,8 @@ namespace Dixter
 	 * \brief Group is a container storing objects which have common name.
 	 *
 	 * It can store objects of classes which have common base class.
+	 * Elements are found by id through a hash index and kept in pooled
+	 * slots, groups keep them in order of addition.
 	 * */
 	template<class T, typename ID = UInt32>
 	class TGroup final : public TNonCopyable
@@ -32,14 +38,13 @@ namespace Dixter
 		using EId                   = ID;
 		using TKey                  = TString;
 		using TElement              = TGroupElement<TObject*, ID>;
-		using TContainer            = std::list<TElement*>;
-		using TMapped               = TContainer*;
-		using TValue                = std::pair<TKey, TMapped>;
-		using TMultimap             = std::unordered_map<TKey, TMapped>;
-		using TIterator             = typename TGroup<T, ID>::TMultimap::iterator;
-		using TConstIterator        = typename TGroup<T, ID>::TMultimap::const_iterator;
-		using TListIterator         = typename std::list<TElement*>::iterator;
-		using TListConstIterator    = const typename std::list<TElement*>::iterator;
+		using TContainer            = std::vector<TElement*>;
+		using TValue                = std::pair<TKey, TContainer>;
+		using TGroupList            = std::vector<TValue>;
+		using TIterator             = typename TGroupList::iterator;
+		using TConstIterator        = typename TGroupList::const_iterator;
+		using TListIterator         = typename TContainer::iterator;
+		using TListConstIterator    = typename TContainer::const_iterator;
 	public:
 		TGroup() noexcept;
 		
@@ -96,19 +101,19 @@ namespace Dixter
 		 * \class Group
 		 * \brief Finds elements of a group.
 		 * \param groupName The name of the group.
-		 * \returns Elements of the group.
+		 * \returns Elements of the group in order of addition.
 		 * \throws NotFoundException
 		 * */
-		TMapped& getGroup(const TKey& groupName);
+		TContainer& getGroup(const TKey& groupName);
 		
-		TMapped& getGroup(TSize index)
-		{
-			TSize idx {};
-			
-			for (auto&[__key, __mapped] : *m_group)
-				if (idx++ == index)
-					return __mapped;
-		}
+		const TContainer& getGroup(const TKey& groupName) const;
+		
+		/**
+		 * \class Group
+		 * \brief Finds elements of a group by order of group creation.
+		 * \throws RangeException
+		 * */
+		TContainer& getGroup(TSize index);
 		
 		/**
 		 * \class Group
@@ -116,6 +121,7 @@ namespace Dixter
 		 * \tparam TCast Type to cast the element.
 		 * \param id Id of the element.
 		 * \returns Casted element.
+		 * \throws NotFoundException
 		 * */
 		template<class TCast = TObject>
 		TCast*
@@ -166,6 +172,23 @@ namespace Dixter
 		>
 		void forEach(const TKey& groupName, TReturn(T::*MethodCallback)(TArgs ... args), TArgs ... args);
 		
+		/**
+		 * \class Group
+		 * \brief Calls specified method of element of all groups with execution policy.
+		 * \param policy With EExecution::Parallel, elements are split in chunks run
+		 * on shared thread pool, unless there are only a few of them.
+		 *
+		 * Parallel call requires method to be safe to call on different elements
+		 * at once, with arguments shared by all calls. Elements must not be
+		 * added to or removed from the group meanwhile. Qt widgets may only
+		 * be used sequentially from GUI thread.
+		 * */
+		template<
+				typename TReturn,
+				typename... TArgs
+		>
+		void forEach(EExecution policy, TReturn(T::*MethodCallback)(TArgs...), TArgs ... args);
+		
 		/**
 		 * \class Group
 		 * \returns Number of groups.
@@ -187,6 +210,10 @@ namespace Dixter
 		
 		bool isEmpty(const TKey& key) const noexcept;
 		
+		/**
+		 * \class Group
+		 * \brief Groups as (name, elements) pairs in order of creation.
+		 * */
 		TIterator
 		begin() noexcept;
 		
@@ -199,24 +226,38 @@ namespace Dixter
 		TConstIterator
 		cend() const noexcept;
 	
+	private:
+		/**
+		 * Pooled element with position of its group.
+		 * */
+		struct TSlot
+		{
+			std::optional<TElement> element_;
+			
+			TSize group_;
+		};
+		
+		using TPool         = std::deque<TSlot>;
+		using TIdIndex      = std::unordered_map<ID, TSize>;
+		using TGroupIndex   = std::unordered_map<TKey, TSize>;
+	
 	private:
 		/**
 		 * \class Group
-		 * \brief Insert a GroupElement object to the group.
+		 * \brief Insert element to the group, creating group if needed.
 		 * \param groupName The name of the group to be added.
-		 * \param groupElement The name of the element to be added to group.
-		 * \returns True if item added successfully.
-		 * \throws IllegalArgumentException.
+		 * \returns Added element.
+		 * \throws IllegalArgumentException if id is taken.
 		 */
-		TObject* doAdd(const TKey& groupName, TElement* groupElement);
+		TObject* doAdd(const TKey& groupName, TObject* element, ID id, bool autoDelete,
+					   typename TElement::TDescription description);
+		
+		/// Slot of element with id in group, null if there is none
+		const TSlot* findSlot(const TKey& groupName, const ID& id) const;
 		
 		bool
 		hasElement(const TKey& groupName, const ID& id) const;
 		
-		/*! Method that finds item in group by its group name
-		 * @param groupName Name of the group where exists the searched data
-		 * @returns A pair with true if found, and the iterator to the item
-		 */
 		bool
 		hasGroup(const TKey& groupName) const;
 		
@@ -241,7 +282,19 @@ namespace Dixter
 	private:
 		TSize m_count;
 		
-		TMultimap* m_group;
+		/// Groups with elements in order of addition
+		TGroupList m_groups;
+		
+		/// Positions of groups by name
+		TGroupIndex m_groupIndex;
+		
+		/// Element storage, slots of removed elements are reused
+		TPool m_pool;
+		
+		std::vector<TSize> m_freeSlots;
+		
+		/// Slots of elements by id, which is unique among all groups
+		TIdIndex m_index;
 		
 		static const TKey s_defaultGroup;
 		
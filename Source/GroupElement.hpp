@@ -106,7 +106,8 @@ namespace Dixter
 	private:
 		Element m_element;
 		
-		TElementProperty<ID>* m_pProperties;
+		/// Held in place, so pooled elements need no allocation of their own
+		TElementProperty<ID> m_properties;
 	};
 	template<typename Element, typename ID>
 	struct ElementComparator
@@ -127,14 +128,14 @@ namespace Dixter
 	TGroupElement<Element, ID>::
 	TGroupElement(Element& element, const ID& id,
 				  TGroupElement<Element, ID>::TDescription description, bool autoDelete)
-			: m_pProperties(new TElementProperty<ID>(id, description, autoDelete))
+			: m_properties(id, description, autoDelete)
 	{
 		m_element = element;
 	}
 	
 	template<class Element, typename ID>
 	TGroupElement<Element, ID>::TGroupElement(Element& element, const ID& id, bool autoRelease)
-			: m_pProperties(new TElementProperty<ID>(id, autoRelease))
+			: m_properties(id, autoRelease)
 	{
 		m_element = element;
 	}
@@ -149,7 +150,7 @@ namespace Dixter
 	int
 	TGroupElement<Element, ID>::compareTo(const TGroupElement<Element, ID>& other) noexcept
 	{
-		return static_cast<int>(m_pProperties->getId()) - static_cast<int>(other.m_pProperties->getId());
+		return static_cast<int>(m_properties.getId()) - static_cast<int>(other.m_properties.getId());
 	}
 	
 	template<class Element, typename ID>
@@ -164,7 +165,7 @@ namespace Dixter
 	>
 	inline bool TGroupElement<Element, ID>::equal(const ID& id) const
 	{
-		return m_pProperties->getId() == id;
+		return m_properties.getId() == id;
 	}
 	
 	template<class Element, typename ID>
@@ -189,7 +190,7 @@ namespace Dixter
 	const TElementProperty<ID>*
 	TGroupElement<Element, ID>::getProperties() const
 	{
-		return m_pProperties;
+		return &m_properties;
 	}
 	
 	template<class Element, typename ID>
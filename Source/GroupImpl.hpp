@@ -7,6 +7,8 @@
  */
 #pragma once
 
+#include <algorithm>
+
 #include "Exception.hpp"
 
 namespace Dixter
@@ -15,60 +17,82 @@ namespace Dixter
 	template<class T, typename ID>
 	TGroup<T, ID>::TGroup() noexcept
 			: m_count(),
-			  m_group(new TMultimap)
+			  m_groups(),
+			  m_groupIndex(),
+			  m_pool(),
+			  m_freeSlots(),
+			  m_index()
 	{ }
 	
 	template<class T, typename ID>
 	TGroup<T, ID>::TGroup(TGroup<T, ID>&& src) noexcept
-			: m_group(std::move(src.m_group)),
-			  m_count(std::move(src.m_count))
-	{ }
+			: m_count(src.m_count),
+			  m_groups(std::move(src.m_groups)),
+			  m_groupIndex(std::move(src.m_groupIndex)),
+			  m_pool(std::move(src.m_pool)),
+			  m_freeSlots(std::move(src.m_freeSlots)),
+			  m_index(std::move(src.m_index))
+	{
+		src.m_count = 0;
+	}
 	
 	template<class T, typename ID>
 	TGroup<T, ID>&
 	TGroup<T, ID>::operator=(TGroup&& src) noexcept
 	{
-		m_group = std::move(src.m_group);
-		m_count = std::move(src.m_count);
+		if (this != &src)
+		{
+			clear();
+			m_count = src.m_count;
+			m_groups = std::move(src.m_groups);
+			m_groupIndex = std::move(src.m_groupIndex);
+			m_pool = std::move(src.m_pool);
+			m_freeSlots = std::move(src.m_freeSlots);
+			m_index = std::move(src.m_index);
+			src.m_count = 0;
+		}
+		return *this;
 	}
 	
 	template<class T, typename ID>
 	TGroup<T, ID>::~TGroup() noexcept
 	{
-		for (auto& group_pair : *m_group)
-			for (auto& __element : *group_pair.second)
-				delete __element;
-		
-		delete m_group;
+		clear();
 	}
 	
 	template<class T, typename ID>
 	typename TGroup<T, ID>::TObject*
-	TGroup<T, ID>::doAdd(const TGroup<T, ID>::TKey& groupName,
-						 TGroup<T, ID>::TElement* groupElement)
+	TGroup<T, ID>::doAdd(const TGroup<T, ID>::TKey& groupName, TObject* element, ID id,
+						 bool autoDelete, typename TElement::TDescription description)
 	{
 		std::lock_guard<std::mutex> addLock(m_mutex);
-		bool __groupExists(this->hasGroup(groupName));
-		bool __elementExists(this->hasElement(groupName, groupElement->getProperties()->getId()));
+		const auto [__id, __added] = m_index.try_emplace(id, TSize());
+		if (not __added)
+			throw TIllegalArgumentException(
+					"%s:%d\nThe specified element can not be added to the group %s",
+					__FILE__, __LINE__, groupName);
 		
-		// create both group and element
-		if (not __groupExists and not __elementExists)
+		const auto [__group, __created] = m_groupIndex.try_emplace(groupName, m_groups.size());
+		if (__created)
 		{
-			/// If we don't have the item then create group and add child item to the new group
-			m_group->insert({ groupName, new TGroup<T, ID>::TContainer { groupElement }});
+			m_groups.emplace_back(groupName, TContainer());
 			++m_count;
 		}
-		else if (__groupExists and not __elementExists)
+		
+		if (m_freeSlots.empty())
 		{
-			// create only item in existing group
-			this->getGroup(groupName)->push_back(groupElement);
+			m_freeSlots.push_back(m_pool.size());
+			m_pool.emplace_back();
 		}
-		else
-			throw TIllegalArgumentException(
-					"%s:%d\nThe specified element can not be added to the group %s",
-					__FILE__, __LINE__, groupName);
+		__id->second = m_freeSlots.back();
+		m_freeSlots.pop_back();
+		
+		auto& __slot = m_pool[__id->second];
+		__slot.element_.emplace(element, id, description, autoDelete);
+		__slot.group_ = __group->second;
+		m_groups[__group->second].second.push_back(&*__slot.element_);
 		
-		return groupElement->getElement();
+		return __slot.element_->getElement();
 	}
 	
 	// Mutators
@@ -79,17 +103,15 @@ namespace Dixter
 	TGroup<T, ID>::add(const TGroup<T, ID>::TKey& groupName, TObject* element, ID id,
 					   bool autoRelease, typename TElement::TDescription description)
 	{
-		if (this->hasElement(groupName, id))
-			return this->get<TCast>(groupName, id);
+		if (auto __slot = findSlot(groupName, id))
+			return dynamic_cast<TCast*>(__slot->element_->getElement());
 		
 		assert((this->isValidGroupName(groupName))&&("Not a valid group name."));;
 		assert((this->isValidElement(element))&&("Not a valid element."));;
 		
 		try
 		{
-			return dynamic_cast<TCast*>(this->doAdd(
-					groupName,
-					new TGroupElement<TObject*, ID> { element, id, description, autoRelease }));
+			return dynamic_cast<TCast*>(this->doAdd(groupName, element, id, autoRelease, description));
 		}
 		catch (TException& e)
 		{
@@ -110,9 +132,7 @@ namespace Dixter
 		assert((this->isValidElement(element))&&("Not a valid element."));;
 		try
 		{
-			return dynamic_cast<TCast*>(this->doAdd(
-					s_defaultGroup,
-					new TGroupElement<TObject*, ID>(element, id, description, autoRelease)));
+			return dynamic_cast<TCast*>(this->doAdd(s_defaultGroup, element, id, autoRelease, description));
 		}
 		catch (TException& e)
 		{
@@ -127,63 +147,71 @@ namespace Dixter
 	template<class T, typename ID>
 	bool TGroup<T, ID>::remove(const TGroup<T, ID>::TKey& groupName, ID id)
 	{
-		bool __bExists(this->hasElement(groupName, id));
-		TGroup<T, ID>::TMapped __elementList {};
-		if (__bExists)
-		{
-			std::for_each(
-					m_group->begin(), m_group->end(),
-					[ & ](TGroup<T, ID>::TValue& values)
-					{
-						if (values.first == groupName)
-						{
-							__elementList = values.second;
-							for (auto __listIter = __elementList->begin();
-								 __listIter != __elementList->end();
-								 ++__listIter)
-							{
-								if ((( *__listIter )->equal(id)) and not(( *__listIter )->empty()))
-								{
-									this->releaseElement(( *__listIter ));
-									__elementList->erase(__listIter);
-									--m_count;
-									__bExists = this->hasElement(groupName, id);
-									return not __bExists;
-								}
-							}
-						}
-						return __bExists;
-					});
-		}
-		return false;
+		std::lock_guard<std::mutex> removeLock(m_mutex);
+		auto __id = m_index.find(id);
+		if (__id == m_index.end() or m_groups[m_pool[__id->second].group_].first != groupName)
+			return false;
+		
+		auto& __slot = m_pool[__id->second];
+		auto& __elements = m_groups[__slot.group_].second;
+		// erased in place, so remaining elements keep their order
+		__elements.erase(std::find(__elements.begin(), __elements.end(), &*__slot.element_));
+		__slot.element_.reset();
+		m_freeSlots.push_back(__id->second);
+		m_index.erase(__id);
+		return true;
 	}
 	
 	template<class T, typename ID>
 	inline void TGroup<T, ID>::clear()
 	{
-		m_group->clear();
+		m_groups.clear();
+		m_groupIndex.clear();
+		m_pool.clear();
+		m_freeSlots.clear();
+		m_index.clear();
+		m_count = 0;
 	}
 	
 	template<class T, typename ID>
 	TGroup<T, ID>&
 	TGroup<T, ID>::append(T* element, ID id)
 	{
-		auto mp = this->getGroup(getSize() - 1);
+		if (m_groups.empty())
+			throw TNotFoundException("%s:%d\nThere is no group to append to", __FILE__, __LINE__);
 		
-		mp->insert(mp->end(), new TGroupElement<TObject*, ID>(element, id));
+		doAdd(m_groups.back().first, element, id, true, "");
 		return *this;
 	}
 	
 	template<class T, typename ID>
-	inline typename TGroup<T, ID>::TMapped&
+	inline typename TGroup<T, ID>::TContainer&
 	TGroup<T, ID>::getGroup(const TGroup<T, ID>::TKey& groupName)
 	{
-		if (this->hasGroup(groupName))
-			return m_group->at(groupName);
-		else
+		return const_cast<TContainer&>(static_cast<const TGroup*>(this)->getGroup(groupName));
+	}
+	
+	template<class T, typename ID>
+	inline const typename TGroup<T, ID>::TContainer&
+	TGroup<T, ID>::getGroup(const TGroup<T, ID>::TKey& groupName) const
+	{
+		auto __group = m_groupIndex.find(groupName);
+		if (__group == m_groupIndex.end())
 			throw TNotFoundException(
 					"%s:%d\nThe group %s is not found",
 					__FILE__, __LINE__, groupName);
+		
+		return m_groups[__group->second].second;
+	}
+	
+	template<class T, typename ID>
+	inline typename TGroup<T, ID>::TContainer&
+	TGroup<T, ID>::getGroup(TSize index)
+	{
+		if (index >= m_groups.size())
+			throw TRangeException("%s:%d Group %u out of range.", __FILE__, __LINE__, static_cast<UInt32>(index));
+		
+		return m_groups[index].second;
 	}
 	
 	template<class T, typename ID>
@@ -191,18 +219,12 @@ namespace Dixter
 	TCast*
 	TGroup<T, ID>::get(ID id)
 	{
-		auto __first = m_group->begin();
-		auto __last = m_group->end();
+		auto __id = m_index.find(id);
+		if (__id == m_index.end())
+			throw TNotFoundException("%s:%d Item with id %d not found.", __FILE__, __LINE__,
+									 static_cast<Int32>(id));
 		
-		for (auto __iter = __first;
-			 __iter != __last; __iter++)
-		{
-			auto __container = __iter->second;
-			for (auto __groupItem : *__container)
-				if (__groupItem->equal(id))
-					return dynamic_cast<TCast*>(__groupItem->getElement());
-		}
-		throw TNotFoundException("%s:%d Item with id %d not found.", __FILE__, __LINE__, id);
+		return dynamic_cast<TCast*>(m_pool[__id->second].element_->getElement());
 	}
 	
 	template<class T, typename ID>
@@ -210,19 +232,13 @@ namespace Dixter
 	inline TCast*
 	TGroup<T, ID>::get(const TGroup<T, ID>::TKey& groupName, ID id)
 	{
-		if (m_group->find(groupName) == m_group->end())
+		auto __slot = findSlot(groupName, id);
+		if (not __slot)
 			throw TNotFoundException(
 					"%s:%d Item with id %d not found in group \"%s\"",
-					__FILE__, __LINE__, groupName);
+					__FILE__, __LINE__, static_cast<Int32>(id), groupName);
 		
-		for (const auto& __groupItem : *m_group->find(groupName)->second)
-		{
-			if (__groupItem->equal(id))
-				return dynamic_cast<TCast*>(__groupItem->getElement());
-		}
-		throw TNotFoundException(
-				"%s:%d Item with id %d not found in group \"%s\"",
-				__FILE__, __LINE__, groupName);
+		return dynamic_cast<TCast*>(__slot->element_->getElement());
 	}
 	
 	template<class T, typename ID>
@@ -234,16 +250,12 @@ namespace Dixter
 	TGroup<T, ID>::forEach(TReturn(T::*method)(TArgs ...), TArgs... args)
 	{
 		auto __methodCallback = TMethodCallback<T, TReturn, TArgs...>(method);
-
-		std::for_each(
-				begin(), end(), [ &__methodCallback, &args... ](typename TMultimap::value_type& pair)
-				{
-					for (TElement* __item : *pair.second)
-					{
-						if (not __item->empty())
-							__methodCallback(__item->getElement(), std::forward<TArgs>(args)...);
-					}
-				});
+		for (auto& __group : m_groups)
+			for (TElement* __item : __group.second)
+			{
+				if (not __item->empty())
+					__methodCallback(__item->getElement(), std::forward<TArgs>(args)...);
+			}
 	}
 	
 	template<class T, typename ID>
@@ -257,38 +269,64 @@ namespace Dixter
 						   TArgs... args)
 	{
 		auto __methodCallback = TMethodCallback<T, TReturn, TArgs...>(method);
-		for (auto& __item : *getGroup(groupName))
+		for (auto& __item : getGroup(groupName))
 			__methodCallback(__item->getElement(), std::forward<TArgs>(args)...);
 	}
 	
+	template<class T, typename ID>
+	template<
+			typename TReturn,
+			typename... TArgs
+	>
+	void
+	TGroup<T, ID>::forEach(EExecution policy, TReturn(T::*method)(TArgs...), TArgs... args)
+	{
+		if (policy == EExecution::Sequenced)
+			return forEach(method, args...);
+		
+		std::vector<TObject*> __elements;
+		{
+			std::lock_guard<std::mutex> forEachLock(m_mutex);
+			__elements.reserve(m_index.size());
+			for (auto& __group : m_groups)
+				for (TElement* __item : __group.second)
+					if (not __item->empty())
+						__elements.push_back(__item->getElement());
+		}
+		TThreadPool::shared().parallelFor(
+				__elements.size(), [ & ](TSize begin, TSize end)
+				{
+					for (auto __index = begin; __index < end; ++__index)
+						( __elements[__index]->*method )(args...);
+				});
+	}
+	
 	// Accessors
 	template<class T, typename ID>
 	inline TSize
 	TGroup<T, ID>::getSize() const
 	{
-		return m_group->size();
+		return m_groups.size();
 	}
 	
 	template<class T, typename ID>
 	inline TSize
 	TGroup<T, ID>::getItemCount(const TGroup<T, ID>::TKey& groupName) const
 	{
-		auto __groupItems = this->getGroup(groupName);
-		if (__groupItems->size())
-			return this->getGroup(groupName)->size();
-		return 0;
+		return getGroup(groupName).size();
 	}
 	
 	template<class T, typename ID>
 	inline bool TGroup<T, ID>::empty() const noexcept
 	{
-		return m_group->empty();
+		return m_groups.empty();
 	}
 	
 	template<class T, typename ID>
 	inline bool TGroup<T, ID>::empty(const TGroup<T, ID>::TKey& key) const noexcept
 	{
-		this->getGroup(key)->empty();
+		auto __group = m_groupIndex.find(key);
+		return __group == m_groupIndex.end() or m_groups[__group->second].second.empty();
 	}
 	
 	template<class T, typename ID>
@@ -300,58 +338,55 @@ namespace Dixter
 	template<class T, typename ID>
 	inline bool TGroup<T, ID>::isEmpty(const TGroup<T, ID>::TKey& key) const noexcept
 	{
-		return this->empty(key);;
+		return this->empty(key);
 	}
 	
 	template<class T, typename ID>
 	typename TGroup<T, ID>::TIterator
 	inline TGroup<T, ID>::begin() noexcept
 	{
-		return m_group->begin();
+		return m_groups.begin();
 	}
 	
 	template<class T, typename ID>
 	typename TGroup<T, ID>::TIterator
 	inline TGroup<T, ID>::end() noexcept
 	{
-		return m_group->end();
+		return m_groups.end();
 	}
 	
 	template<class T, typename ID>
 	typename TGroup<T, ID>::TConstIterator
 	inline TGroup<T, ID>::cbegin() const noexcept
 	{
-		return m_group->begin();
+		return m_groups.cbegin();
 	}
 	
 	template<class T, typename ID>
 	typename TGroup<T, ID>::TConstIterator
 	inline TGroup<T, ID>::cend() const noexcept
 	{
-		return m_group->end();
+		return m_groups.cend();
+	}
+	
+	template<class T, typename ID>
+	const typename TGroup<T, ID>::TSlot*
+	TGroup<T, ID>::findSlot(const TGroup<T, ID>::TKey& groupName, const ID& id) const
+	{
+		auto __id = m_index.find(id);
+		if (__id == m_index.end())
+			return nullptr;
+		
+		const auto& __slot = m_pool[__id->second];
+		return m_groups[__slot.group_].first == groupName ? &__slot : nullptr;
 	}
 	
 	template<class T, typename ID>
 	bool
 	TGroup<T, ID>::hasElement(const TGroup<T, ID>::TKey& groupName, const ID& id) const
 	{
-		bool __bExists {};
-		
-		if (this->hasGroup(groupName))
-		{
-			auto __first = m_group->begin();
-			auto __last = m_group->end();
-			
-			for (auto __iterator = __first; __iterator != __last; ++__iterator)
-			{
-				for (const auto& __element : *__iterator->second)
-				{
-					if (__element->getProperties()->getId() == id and __element->getElement() != nullptr)
-						__bExists = true;
-				}
-			}
-		}
-		return __bExists;
+		auto __slot = findSlot(groupName, id);
+		return __slot and not __slot->element_->empty();
 	}
 	
 	template<class T, typename ID>
@@ -369,15 +404,12 @@ namespace Dixter
 	}
 	
 	template<class T, typename ID>
-	bool TGroup<T, ID>::hasGroup(const TGroup<T, ID>::TKey& groupName) const
+	inline bool TGroup<T, ID>::hasGroup(const TGroup<T, ID>::TKey& groupName) const
 	{
-		for (const TValue& __value : *m_group)
-			if (__value.first.compare(groupName) == 0)
-				return true;
-		return false;
+		return m_groupIndex.find(groupName) != m_groupIndex.end();
 	}
 	
 	template<class T, typename ID>
 	const typename TGroup<T, ID>::TKey
 			TGroup<T, ID>::s_defaultGroup("Default");
-}
\ No newline at end of file
+}
@@ -10,6 +10,7 @@
 #include <QBoxLayout>
 #include <QGroupBox>
 #include <QAction>
+#include <QScrollBar>
 
 #include "Group.hpp"
 #include "Configuration.hpp"
@@ -52,13 +53,13 @@ namespace Dixter
 		
 		void TDictionaryPanel::show(bool show)
 		{
-			m_widgets->forEach(&QWidget::setVisible, show);
+			m_widgets->forEach<&QWidget::setVisible>(show);
 		}
 		
 		APanel::TOptionBoxPtr
 		TDictionaryPanel::getOptionBox(EWidgetID widgetID)
 		{
-			return dxMAKE_SHARED(TOptionBox, m_widgets->get<TOptionBox>(g_widgetGroup, widgetID));
+			return dxMAKE_SHARED(TOptionBox, m_widgets->get<TOptionBox>(widgetID));
 		}
 		
 		void TDictionaryPanel::init()
@@ -68,19 +69,13 @@ namespace Dixter
 									   new QVBoxLayout(this),
 									   EWidgetID::Grid);
 			auto __textView = m_widgets
-					->add<TTextView>(g_widgetGroup,
-									 new TTextView(this, true),
-									 EWidgetID::TextView);
+					->add<EWidgetID::TextView>(new TTextView(this, true));
 			auto __langBoxWest = m_widgets
-					->add<TOptionBox>(g_widgetGroup,
-									  new TOptionBox(nullptr,
-													 QString("Select language...")),
-									  EWidgetID::LangboxWest);
+					->add<EWidgetID::LangboxWest>(new TOptionBox(nullptr,
+																 QString("Select language...")));
 			auto __langBoxEast = m_widgets
-					->add<TOptionBox>(g_widgetGroup,
-									  new TOptionBox(nullptr,
-													 QString("Select language...")),
-									  EWidgetID::LangboxEast);
+					->add<EWidgetID::LangboxEast>(new TOptionBox(nullptr,
+																 QString("Select language...")));
 			
 			auto __controlGroup = new QGroupBox;
 			auto __controlBox = new QHBoxLayout;
@@ -89,13 +84,9 @@ namespace Dixter
 			
 			// Search entry for words in a Database
 			auto __searchEntry = m_widgets
-					->add<TSearchEntry>(g_widgetGroup,
-										new TSearchEntry(this, tr("Word...")),
-										EWidgetID::SearchControl, true);
+					->add<EWidgetID::SearchControl>(new TSearchEntry(this, tr("Word...")), true);
 			auto __searchButton = m_widgets
-					->add<TButton>(g_widgetGroup,
-								   new TButton(this, tr("Search")),
-								   EWidgetID::SearchButton, true);
+					->add<EWidgetID::SearchButton>(new TButton(this, tr("Search")), true);
 			
 			__controlBox->addWidget(__labelFrom);
 			__controlBox->addWidget(__langBoxWest);
@@ -114,79 +105,109 @@ namespace Dixter
 			
 			setValues();
 			setLayout(__mainGrid);
-			
+		
 		}
 		
 		void TDictionaryPanel::connectEvents()
 		{
-			connect(m_widgets->get<TButton>(EWidgetID::SearchButton), SIGNAL(clicked()),
+			connect(m_widgets->get<EWidgetID::SearchButton>(), SIGNAL(clicked()),
 					this, SLOT(onSearch()));
+			connect(m_widgets->get<EWidgetID::LangboxWest>(), SIGNAL(currentIndexChanged(int)),
+					this, SLOT(onLanguageChange()));
+			connect(m_widgets->get<EWidgetID::TextView>()->verticalScrollBar(), SIGNAL(valueChanged(int)),
+					this, SLOT(onScroll(int)));
 		}
 		
 		void TDictionaryPanel::setValues()
 		{
-			std::vector<TUString> __languageNames {}, __languageDisplayNames {};
+			TRecordSet __languages({ NodeHandle::kLangNameNode, NodeHandle::kLangNameDisplayNode });
 			
 			try
 			{
-				getXmlManager({ g_langConfigPath, g_voiceConfigPath })
+				getCatalogueManager()
 						->accessor()
-						->getValues(NodeKey::kLangNameNode, __languageNames, NodeKey::kLangRoot)
-						->getValues(NodeKey::kLangNameDisplayNode, __languageDisplayNames, NodeKey::kLangRoot);
+						->select(__languages, NodeKey::kLangRoot);
 			}
 			catch (TException& e)
 			{ printerr(e.what()); }
 			
-			AlgoUtils::foreachCompound<std::vector<TUString>>(
-					__languageNames, __languageDisplayNames,
-					[](TUString& langName, const TUString& langNameDisplay)
-					{ langName.append(u" / ").append(langNameDisplay); }
-															 );
+			std::vector<TU8String> __languageNames {};
+			__languageNames.reserve(__languages.rows());
+			for (TSize __row {}; __row < __languages.rows(); ++__row)
+			{
+				__languageNames.push_back(__languages.getValue(__row, 0));
+				if (__languages.has(__row, 1))
+					__languageNames.back().append(" / ").append(__languages.at(__row, 1));
+			}
 			
-			m_widgets->get<TOptionBox>(EWidgetID::LangboxWest)->setValues(__languageNames);
-			m_widgets->get<TOptionBox>(EWidgetID::LangboxEast)->setValues(__languageNames);
+			m_widgets->get<EWidgetID::LangboxWest>()->setValues(__languageNames);
+			m_widgets->get<EWidgetID::LangboxEast>()->setValues(std::move(__languageNames));
 		}
 		
 		void TDictionaryPanel::onCopyButton(void)
 		{
-			auto __searchControl = m_widgets->get<TSearchEntry>(EWidgetID::ButtonLayout);
+			auto __searchControl = m_widgets->get<EWidgetID::SearchControl>();
 			__searchControl->selectAll();
 			__searchControl->copy();
 		}
 		
 		void TDictionaryPanel::onClearButton(void)
 		{
-			auto __searchControl = m_widgets->get<TSearchEntry>(EWidgetID::ButtonLayout);
+			auto __searchControl = m_widgets->get<EWidgetID::SearchControl>();
 			__searchControl->selectAll();
 			__searchControl->cut();
 		}
 		
 		void TDictionaryPanel::onLanguageChange(void)
 		{
-			auto __languagesBox = m_widgets->get<TOptionBox>(EWidgetID::LangboxWest);
-			auto __textView = m_widgets->get<TTextView>(EWidgetID::TextView);
+			auto __languagesBox = m_widgets->get<EWidgetID::LangboxWest>();
+			auto __textView = m_widgets->get<EWidgetID::TextView>();
 			
 			if (__languagesBox and not __languagesBox->isPlaceholderSet())
 			{
-				TUString __structures;
-				TUString __languageName;
-				auto __strSel = __languagesBox->currentText();
+				TU8String __structures;
+				TU8String __languageName;
+				// options read "name / display name"
+				auto __strSel = __languagesBox->currentText().section(" / ", 0, 0);
 				try
 				{
-					__structures = getXmlManager()
+					__structures = getCatalogueManager()
 							->accessor()
-							->getValue(NodeKey::kLangStructureNode,
+							->getValue(NodeHandle::kLangStructureNode,
 									   __strSel, NodeKey::kLangRoot);
 					
-					__languageName = getXmlManager()
+					__languageName = getCatalogueManager()
 							->accessor()
-							->getValue(NodeKey::kLangNameNode,
+							->getValue(NodeHandle::kLangNameNode,
 									   __strSel, NodeKey::kLangRoot);
 					
 					__textView->clear();
 					__textView->insertColumns(__structures.asCustom().split(','), "Id");
 				} catch (TException& e)
 				{ printerr(e.what()); }
+				
+				// Languages without column list fetch every column of dictionary table
+				std::vector<TString> __columns {};
+				try
+				{
+					__columns = StringUtils::split<std::vector<TString>>(
+							getCatalogueManager()
+									->accessor()
+									->getValue(NodeHandle::kLangColumnsNode,
+											   __strSel, NodeKey::kLangRoot).asUTF8());
+				} catch (TNotFoundException&)
+				{ }
+				m_widgets->get<EWidgetID::SearchControl>()->setColumns(std::move(__columns));
+				
+				try
+				{
+					m_widgets->get<EWidgetID::SearchControl>()->setLanguage(
+							getCatalogueManager()
+									->accessor()
+									->getValue(NodeHandle::kLangIdNode,
+											   __strSel, NodeKey::kLangRoot).asUTF8());
+				} catch (TException& e)
+				{ printerr(e.what()); }
 			}
 		}
 		
@@ -194,13 +215,27 @@ namespace Dixter
 		{
 			try
 			{
-				auto __textView = m_widgets->get<TTextView>(EWidgetID::TextView);
-				m_widgets->get<TSearchEntry>(EWidgetID::SearchControl)
+				auto __textView = m_widgets->get<EWidgetID::TextView>();
+				m_widgets->get<EWidgetID::SearchControl>()
 						 ->search("dixterdb_NO", "paradigm", __textView);
 			} catch (TException& e)
 			{ printerr(e.getMessage()); }
 		}
 		
+		void TDictionaryPanel::onScroll(int value) noexcept
+		{
+			try
+			{
+				auto __textView = m_widgets->get<EWidgetID::TextView>();
+				if (value < __textView->verticalScrollBar()->maximum())
+					return;
+				
+				m_widgets->get<EWidgetID::SearchControl>()
+						 ->searchNext("paradigm", __textView);
+			} catch (TException& e)
+			{ printerr(e.getMessage()); }
+		}
+		
 		QWidget* TDictionaryPanel::getWidget(EWidgetID id)
 		{
 			return m_widgets->get(id);
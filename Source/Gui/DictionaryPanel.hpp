@@ -9,6 +9,8 @@
 
 #pragma once
 
+#include "Constants.hpp"
+#include "StaticGroup.hpp"
 #include "Gui/Panel.hpp"
 #include "Gui/OptionBox.hpp"
 
@@ -16,8 +18,6 @@ class QMutex;
 
 namespace Dixter
 {
-	enum class EWidgetID;
-	
 	template<
 			typename T,
 			typename ID
@@ -26,11 +26,20 @@ namespace Dixter
 	
 	namespace Gui
 	{
+		class TTextView;
+		class TSearchEntry;
+		class TButton;
+		
 		class TDictionaryPanel : public APanel
 		{
 		Q_OBJECT
 		private:
-			using WidgetGroup   = TGroup<QWidget, EWidgetID>;
+			using WidgetGroup   = TStaticGroup<QWidget,
+											   TTypedId<EWidgetID::TextView, TTextView>,
+											   TTypedId<EWidgetID::LangboxWest, TOptionBox>,
+											   TTypedId<EWidgetID::LangboxEast, TOptionBox>,
+											   TTypedId<EWidgetID::SearchControl, TSearchEntry>,
+											   TTypedId<EWidgetID::SearchButton, TButton>>;
 			using GridGroup     = TGroup<QLayout, EWidgetID>;
 		
 		public:
@@ -56,11 +65,14 @@ namespace Dixter
 			void onCopyButton(void);
 			
 			void onClearButton(void);
-			
+		
+		protected slots:
 			void onLanguageChange(void);
 			
-		protected slots:
 			void onSearch() noexcept;
+			
+			/// Loads next page of results once text view is scrolled to its end
+			void onScroll(int value) noexcept;
 		
 		private:
 			bool m_isLanguageSet;
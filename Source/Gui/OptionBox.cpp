@@ -7,7 +7,11 @@
  *  See README.md for more information.
  */
 #include <QDebug>
+#include <QLocale>
+#include <QSignalBlocker>
 
+#include "Collator.hpp"
+#include "Exception.hpp"
 #include "Utilities.hpp"
 #include "Configuration.hpp"
 #include "Constants.hpp"
@@ -47,9 +51,27 @@ namespace Dixter
 			return __ret;
 		}
 		
+		inline std::u16string_view toUtf16(const QString& string)
+		{
+			return { reinterpret_cast<const char16_t*>(string.utf16()), static_cast<TSize>(string.size()) };
+		}
+		
+		/// Collator of user interface language, root one if its alphabet is unknown
+		const TCollator& interfaceCollator()
+		{
+			try
+			{
+				return TCollator::forLanguage(QLocale().name().section('_', 0, 0).toStdString());
+			}
+			catch (TNotFoundException&)
+			{
+				return TCollator::root();
+			}
+		}
+		
 		Int32 compare(const QVariant& v1, const QVariant& v2)
 		{
-			return v1.toString().compare(v2.toString());
+			return interfaceCollator().compare(toUtf16(v1.toString()), toUtf16(v2.toString()));
 		}
 		
 		TOptionBox::TOptionBox(QWidget* parent,
@@ -58,7 +80,8 @@ namespace Dixter
 				: QComboBox(parent),
 				  m_isPlaceholderSet(),
 				  m_sort(sort),
-				  m_placeHolder(placeholder)
+				  m_placeHolder(placeholder),
+				  m_collator(&interfaceCollator())
 		{
 			setPlaceholder(placeholder);
 			if (size.height() > 0 and size.width() > 0)
@@ -109,9 +132,10 @@ namespace Dixter
 			}
 		}
 		
-		void TOptionBox::setValues(vector<TUString>& options, bool sort)
+		void TOptionBox::setValues(vector<TU8String> options, bool sort)
 		{
-			Q_UNUSED(sort)
+			if (sort or m_sort)
+				m_collator->sort(options.begin(), options.end(), [](const TU8String& option) { return option.view(); });
 			
 			if (options.size() > 0)
 			{
@@ -151,19 +175,28 @@ namespace Dixter
 		
 		void TOptionBox::sort(bool ascending)
 		{
-			//TODO(Alvin): Reimplement
-			(void)ascending;
-			// auto __currentValues = currentData();
-			// clear();
-			// if (ascending)
-			// {
-			// 	std::sort(__currentValues.begin(), __currentValues.end(), std::greater<QString>());
-			// } else
-			// {
-			// 	std::sort(__currentValues.begin(), __currentValues.end(), std::less<QString>());
-			// }
-			//
-			// setValues(__currentValues);
+			const Int32 __first = isPlaceholderSet() and itemText(0) == m_placeHolder ? 1 : 0;
+			const auto __current = currentText();
+			
+			vector<std::pair<QString, QVariant>> __items {};
+			__items.reserve(static_cast<TSize>(count() - __first));
+			for (auto __index = __first; __index < count(); ++__index)
+				__items.emplace_back(itemText(__index), itemData(__index));
+			
+			m_collator->sort(__items.begin(), __items.end(),
+							 [](const std::pair<QString, QVariant>& item) { return toUtf16(item.first); }, ascending);
+			
+			const QSignalBlocker __blocker(this);
+			while (count() > __first)
+				removeItem(count() - 1);
+			for (const auto& [__text, __data] : __items)
+				addItem(__text, __data);
+			setCurrentIndex(findText(__current));
+		}
+		
+		void TOptionBox::setCollator(const TCollator& collator)
+		{
+			m_collator = &collator;
 		}
 		
 		Int32 TOptionBox::getItemCount() const
@@ -15,6 +15,8 @@ class QWidget;
 
 namespace Dixter
 {
+	class TCollator;
+	
 	namespace Gui
 	{
 		class TOptionBox : public QComboBox
@@ -34,14 +36,19 @@ namespace Dixter
 			
 			void resetPlaceholder();
 			
-			void setValues(std::vector<TUString>& options, bool sort = false);
+			/// Adds options, sorted if sort is set here or on construction
+			void setValues(std::vector<TU8String> options, bool sort = false);
 			
 			void setValues(const QStringList& options);
 			
 			void swapCurrent(TOptionBox* src);
 			
+			/// Sorts options by collator, keeping placeholder first
 			void sort(bool ascending = true);
 			
+			/// Collator of options, collator of user interface language by default
+			void setCollator(const TCollator& collator);
+			
 			Int32 getItemCount() const;
 			
 			Int32 getPosition(const QString& value);
@@ -62,6 +69,8 @@ namespace Dixter
 			bool m_sort;
 			
 			QString m_placeHolder;
+			
+			const TCollator* m_collator;
 		};
 	} // namespace Gui
 } // namespace Dixter
\ No newline at end of file
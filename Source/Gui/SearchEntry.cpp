@@ -7,14 +7,18 @@
  *  See README.md for more information.
  */
 
+#include <algorithm>
+#include <numeric>
 #include <regex>
 
 #include "Macros.hpp"
+#include "Collator.hpp"
 #include "JoinThread.hpp"
 #include "Constants.hpp"
 #include "Exception.hpp"
 #include "Configuration.hpp"
 #include "OpenTranslate/Dictionary.hpp"
+#include "OpenTranslate/Transliterator.hpp"
 #include "Database/Manager.hpp"
 #include "Gui/TextView.hpp"
 #include "Gui/SearchEntry.hpp"
@@ -27,30 +31,109 @@ namespace Dixter
 {
 	namespace Gui
 	{
-		void populateTextView(const TSearchResult& fetchedData, TTextView* textView,
-							  FHideCondition& hideIf, FRenameCondition& renameIfMatches)
+		/// Column of key before renaming, -1 if there is none
+		int findColumn(const TTextView* textView, const QString& key)
 		{
-			textView->clearAll();
+			for (int __column = 0; __column < textView->columnCount(); ++__column)
+			{
+				const auto __header = textView->horizontalHeaderItem(__column);
+				if (__header and __header->data(Qt::UserRole).toString() == key)
+					return __column;
+			}
+			return -1;
+		}
+		
+		/**
+		 * Sort key of row, kept so shown rows are never collated again. It's stored in
+		 * item of the last column, which is created first and so exists in every row.
+		 * */
+		constexpr int kSortKeyRole = Qt::UserRole + 1;
+		
+		std::string sortKeyOf(const TTextView* textView, int row)
+		{
+			const auto __item = textView->item(row, textView->columnCount() - 1);
+			const auto __key = __item ? __item->data(kSortKeyRole).toByteArray() : QByteArray {};
+			return std::string(__key.constData(), static_cast<TSize>(__key.size()));
+		}
+		
+		/**
+		 * Show fetched rows in order of collator by key column. Columns of result are
+		 * parallel, so rows are ordered as a whole. If append is set, fetched rows are
+		 * sorted among themselves and merged into rows already shown, which stay sorted.
+		 * */
+		void populateTextView(const TSearchResult& fetchedData, TTextView* textView, const TCollator& collator,
+							  const TString& keyColumn, FHideCondition& hideIf, FRenameCondition& renameIfMatches,
+							  bool append)
+		{
+			if (not append)
+				textView->clearAll();
+			
+			// new columns are inserted in front, so positions are looked up once all exist
+			std::vector<std::pair<QString, const std::vector<TString>*>> __shown;
+			TSize __rowsNum {};
 			for (const auto& __data : fetchedData)
 			{
 				auto __key = __data.first;
-				const auto& __values = __data.second;
-				const int __valuesLen = static_cast<int>(__values.size());
-				
 				if (hideIf(__key))
 					continue;
 				
-				renameIfMatches(__key);
-				textView->insertColumn(0);
-				textView->setColumnText(0, __key);
-				textView->setRowCount(__values.size());
-				
-				if (__valuesLen == 1)
-					textView->setRowText(0, 0, __values.front());
-				else {
-					for (int __i = 0; __i < __valuesLen; ++__i)
-						textView->setRowText(__i, 0, __values.at(__i));
+				const auto __originalKey = QString::fromStdString(__key);
+				if (findColumn(textView, __originalKey) < 0)
+				{
+					renameIfMatches(__key);
+					textView->insertColumn(0);
+					textView->setColumnText(0, __key);
+					textView->horizontalHeaderItem(0)->setData(Qt::UserRole, __originalKey);
 				}
+				__shown.emplace_back(__originalKey, &__data.second);
+				__rowsNum = std::max(__rowsNum, __data.second.size());
+			}
+			
+			std::vector<std::pair<int, const std::vector<TString>*>> __columns;
+			__columns.reserve(__shown.size());
+			for (const auto& __column : __shown)
+				__columns.emplace_back(findColumn(textView, __column.first), __column.second);
+			
+			const auto __keyValues = fetchedData.find(keyColumn);
+			std::vector<std::string> __keys(__rowsNum);
+			if (__keyValues != fetchedData.end())
+			{
+				for (TSize __row {}; __row < __keyValues->second.size(); ++__row)
+					collator.getSortKey(__keyValues->second[__row], __keys[__row]);
+			}
+			
+			std::vector<TSize> __order(__rowsNum);
+			std::iota(__order.begin(), __order.end(), TSize {});
+			std::stable_sort(__order.begin(), __order.end(),
+							 [ &__keys ](TSize left, TSize right) { return __keys[left] < __keys[right]; });
+			
+			// fetched rows come in ascending order, so each is placed after the previous one
+			int __lower {};
+			for (const auto __fetched : __order)
+			{
+				const auto& __key = __keys[__fetched];
+				int __row = __lower;
+				int __count = textView->rowCount() - __lower;
+				while (__count > 0)
+				{
+					const int __step = __count / 2;
+					if (__key < sortKeyOf(textView, __row + __step))
+						__count = __step;
+					else
+					{
+						__row += __step + 1;
+						__count -= __step + 1;
+					}
+				}
+				
+				textView->insertRow(__row);
+				for (const auto& __column : __columns)
+					if (__fetched < __column.second->size())
+						textView->setRowText(__row, __column.first, ( *__column.second )[__fetched]);
+				
+				if (const auto __item = textView->item(__row, textView->columnCount() - 1))
+					__item->setData(kSortKeyRole, QByteArray(__key.data(), static_cast<int>(__key.size())));
+				__lower = __row + 1;
 			}
 		}
 		
@@ -59,7 +142,10 @@ namespace Dixter
 				: QLineEdit(parent),
 				  m_isPlaceholderSet(),
 				  m_placeholder(placeholder),
-				  m_dbManager(nullptr)
+				  m_dbManager(nullptr),
+				  m_columns(),
+				  m_nextPage(),
+				  m_collator(&TCollator::root())
 		{
 			init();
 			setTextMargins(margin, margin, margin, margin);
@@ -95,6 +181,33 @@ namespace Dixter
 			return m_isPlaceholderSet;
 		}
 		
+		void TSearchEntry::setColumns(std::vector<TString> columns)
+		{
+			m_columns = std::move(columns);
+		}
+		
+		void TSearchEntry::setLanguage(const TString& languageId)
+		{
+			using TTransliterator = OpenTranslate::TTransliterator;
+			
+			try
+			{
+				m_collator = &TCollator::forLanguage(languageId);
+			}
+			catch (TNotFoundException&)
+			{
+				m_collator = &TCollator::root();
+			}
+			
+			if (not m_dictionary)
+				return;
+			
+			m_dictionary->setTransliterator(
+					TTransliterator::isSupported(languageId)
+					? &TTransliterator::forLanguage(languageId, TTransliterator::EDirection::kFromLatin)
+					: nullptr);
+		}
+		
 		void TSearchEntry::search(const TString& database, const TString& keyColumn,
 								  TTextView* textView)
 		{
@@ -113,15 +226,38 @@ namespace Dixter
 			}
 			
 			m_dbManager->selectDatabase(database);
-
-			const auto& __fetchedData = m_dictionary->lookFor(__text, keyColumn, true);
 			
-			if (not __fetchedData.size())
+			auto __page = m_dictionary->lookForPage(__text, keyColumn, g_dictPageSize, {}, m_columns);
+			m_nextPage = __page.hasMore_ ? std::move(__page.next_) : OpenTranslate::TDictionary::TPageToken {};
+			
+			if (not __page.result_.size())
 			{
 				textView->clearAll();
 				printl_log("No such a word.");
 				return;
 			}
+			showResult(__page.result_, keyColumn, textView);
+		}
+		
+		bool TSearchEntry::searchNext(const TString& keyColumn, TTextView* textView)
+		{
+			if (m_nextPage.empty() or not m_dbManager)
+				return false;
+			
+			auto __page = m_dictionary->lookForPage(text().toStdString(), keyColumn,
+													g_dictPageSize, m_nextPage, m_columns);
+			m_nextPage = __page.hasMore_ ? std::move(__page.next_) : OpenTranslate::TDictionary::TPageToken {};
+			
+			if (not __page.result_.size())
+				return false;
+			
+			showResult(__page.result_, keyColumn, textView, true);
+			return true;
+		}
+		
+		void TSearchEntry::showResult(const TSearchResult& result, const TString& keyColumn,
+									  TTextView* textView, bool append)
+		{
 			FHideCondition __hideIf =
 					[](TStringView column) { return (column == "id" or column == "word"); };
 			
@@ -134,7 +270,7 @@ namespace Dixter
 					column = std::regex_replace(column, __categoryRegex, "Category");
 			};
 			
-			populateTextView(__fetchedData, textView, __hideIf, __renameIfMatches);
+			populateTextView(result, textView, *m_collator, keyColumn, __hideIf, __renameIfMatches, append);
 		}
 	} // namespace Gui
 } // namespace Dixter
\ No newline at end of file
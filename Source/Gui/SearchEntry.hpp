@@ -10,19 +10,13 @@
 
 #include <QLineEdit>
 
+#include "OpenTranslate/Dictionary.hpp"
+
 class QMutex;
 
 namespace Dixter
 {
-	namespace Database
-	{
-		class TManager;
-	}
-	
-	namespace OpenTranslate
-	{
-		class TDictionary;
-	}
+	class TCollator;
 	
 	namespace Gui
 	{
@@ -46,11 +40,39 @@ namespace Dixter
 			
 			bool isPlaceholderSet() const;
 			
+			/**
+			 * Show the first page of words starting with entered text.
+			 * */
 			void search(const TString& database, const TString& keyColumn,
 						TTextView* textView);
+			
+			/**
+			 * Show the next page of the last search.
+			 * @returns false if there are no more pages
+			 * */
+			bool searchNext(const TString& keyColumn, TTextView* textView);
+			
+			/**
+			 * Set columns fetched by search, empty to fetch all columns.
+			 * */
+			void setColumns(std::vector<TString> columns);
+			
+			/**
+			 * Set language of words searched. Words of languages written in other
+			 * scripts may be typed in Latin and are transliterated before search.
+			 * Results are sorted in alphabetical order of language.
+			 * */
+			void setLanguage(const TString& languageId);
 		
 		protected:
 			virtual void init();
+			
+			/**
+			 * Show result rows in order of key column, merged into rows already
+			 * shown if append is set.
+			 * */
+			void showResult(const OpenTranslate::TDictionary::TSearchResult& result, const TString& keyColumn,
+							TTextView* textView, bool append = false);
 		
 		private:
 			bool m_isPlaceholderSet;
@@ -62,6 +84,13 @@ namespace Dixter
 			TDictionaryPtr m_dictionary;
 			
 			TDatabaseManagerPtr m_dbManager;
+			
+			std::vector<TString> m_columns;
+			
+			OpenTranslate::TDictionary::TPageToken m_nextPage;
+			
+			/// Orders values of result columns, by alphabet of language searched
+			const TCollator* m_collator;
 		};
 	} // namespace Gui
 } // namespace Dixter
\ No newline at end of file
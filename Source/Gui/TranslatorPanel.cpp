@@ -52,40 +52,47 @@ namespace Dixter
 		
 		void TTranslatorPanel::show(bool show)
 		{
-			m_widgets->forEach(&QWidget::setVisible, show);
+			m_widgets->forEach<&QWidget::setVisible>(show);
 		}
 		
 		APanel::TOptionBoxPtr
 		TTranslatorPanel::getOptionBox(EWidgetID id)
 		{
-			return dxMAKE_SHARED(TOptionBox, m_widgets->get<TOptionBox>(g_controlGroup, id));
+			return dxMAKE_SHARED(TOptionBox, m_widgets->get<TOptionBox>(id));
 		}
 		
 		void TTranslatorPanel::setValues()
 		{
-			auto __languageNames = std::vector<TUString>();
-			auto __languageDisplayNames = std::vector<TUString>();
-			auto __languageIds = std::vector<TUString>();
-			auto __voiceNames = std::vector<TUString>();
+			TRecordSet __languages({ NodeHandle::kLangNameNode, NodeHandle::kLangNameDisplayNode });
+			TRecordSet __voices({ NodeHandle::kVoiceNameNode });
 			
 			try
 			{
-				TConfigurationManager::getManager(EConfiguration::XML)
+				getCatalogueManager()
 						->accessor()
-						->getValues(NodeKey::kLangNameNode, __languageNames, NodeKey::kLangRoot)
-						->getValues(NodeKey::kLangNameDisplayNode, __languageDisplayNames, NodeKey::kLangRoot)
-						->getValues(NodeKey::kLangIdNode, __languageIds, NodeKey::kLangRoot)
-						->getValues(NodeKey::kVoiceNameNode, __voiceNames, NodeKey::kVoiceRoot);
+						->select(__languages, NodeKey::kLangRoot)
+						->select(__voices, NodeKey::kVoiceRoot);
 			} catch (std::exception& e)
 			{ printerr(e.what()); }
 			
-			NAlgoUtils::foreachCompound(__languageNames, __languageDisplayNames,
-										[](TUString& languageName, const TUString& languageDisplayName)
-										{ languageName.append(u" / ").append(languageDisplayName); });
+			auto __languageNames = std::vector<TU8String>();
+			__languageNames.reserve(__languages.rows());
+			for (TSize __row {}; __row < __languages.rows(); ++__row)
+			{
+				__languageNames.push_back(__languages.getValue(__row, 0));
+				if (__languages.has(__row, 1))
+					__languageNames.back().append(" / ").append(__languages.at(__row, 1));
+			}
+			
+			auto __voiceNames = std::vector<TU8String>();
+			__voiceNames.reserve(__voices.rows());
+			for (const auto __voiceName : __voices.getColumn(0))
+				if (__voiceName.data())
+					__voiceNames.emplace_back(__voiceName);
 			
-			m_widgets->get<TOptionBox>(g_widgetGroup, EWidgetID::LangboxWest)->setValues(__languageNames);
-			m_widgets->get<TOptionBox>(g_widgetGroup, EWidgetID::LangboxEast)->setValues(__languageNames);
-			m_widgets->get<TOptionBox>(g_widgetGroup, EWidgetID::VoiceBoxT)->setValues(__voiceNames);
+			m_widgets->get<EWidgetID::LangboxWest>()->setValues(__languageNames);
+			m_widgets->get<EWidgetID::LangboxEast>()->setValues(std::move(__languageNames));
+			m_widgets->get<EWidgetID::VoiceBoxT>()->setValues(std::move(__voiceNames));
 		}
 		
 		void TTranslatorPanel::init()
@@ -93,25 +100,15 @@ namespace Dixter
 			// init widgets
 			const QSize __buttonSize = QSize(150, 50);
 			auto __voiceBox = m_widgets
-					->add<TOptionBox>(g_widgetGroup,
-									  new TOptionBox(nullptr, tr("Select voice...")),
-									  EWidgetID::VoiceBoxT);
+					->add<EWidgetID::VoiceBoxT>(new TOptionBox(nullptr, tr("Select voice...")));
 			auto __texteditWest = m_widgets
-					->add<TTextEdit>(g_widgetGroup,
-									 new TTextEdit(this, tr("Translation")),
-									 EWidgetID::TranslatorAreaWest);
+					->add<EWidgetID::TranslatorAreaWest>(new TTextEdit(this, tr("Translation")));
 			auto __texteditEast = m_widgets
-					->add<TTextEdit>(g_widgetGroup,
-									 new TTextEdit(this, tr("Translation"), true),
-									 EWidgetID::TranslatorAreaEast);
+					->add<EWidgetID::TranslatorAreaEast>(new TTextEdit(this, tr("Translation"), true));
 			auto __languageBoxWest = m_widgets
-					->add<TOptionBox>(g_widgetGroup,
-									  new TOptionBox(tr("Select language...")),
-									  EWidgetID::LangboxWest);
+					->add<EWidgetID::LangboxWest>(new TOptionBox(tr("Select language...")));
 			auto __languageBoxEast = m_widgets
-					->add<TOptionBox>(g_widgetGroup,
-									  new TOptionBox(tr("Select language...")),
-									  EWidgetID::LangboxEast);
+					->add<EWidgetID::LangboxEast>(new TOptionBox(tr("Select language...")));
 			
 			auto __widgetLayoutWest = new QVBoxLayout();
 			auto __widgetLayoutEast = new QVBoxLayout();
@@ -122,21 +119,13 @@ namespace Dixter
 			
 			//Buttons
 			auto __speakButtonWest = m_widgets
-					->add<TButton>(g_controlGroup,
-								   new TButton(QIcon(":Resources/icons/speak.png")),
-								   EWidgetID::ButtonSpeakWest);
+					->add<EWidgetID::ButtonSpeakWest>(new TButton(QIcon(":Resources/icons/speak.png")));
 			auto __translateButtonWest = m_widgets
-					->add<TButton>(g_controlGroup,
-								   new TButton(QIcon(":Resources/icons/translate.png")),
-								   EWidgetID::ButtonTranslateWest);
+					->add<EWidgetID::ButtonTranslateWest>(new TButton(QIcon(":Resources/icons/translate.png")));
 			auto __speakButtonEast = m_widgets
-					->add<TButton>(g_controlGroup,
-								   new TButton(QIcon(":Resources/icons/speak.png")),
-								   EWidgetID::ButtonSpeakEast);
+					->add<EWidgetID::ButtonSpeakEast>(new TButton(QIcon(":Resources/icons/speak.png")));
 			auto __translateButtonEast = m_widgets
-					->add<TButton>(g_controlGroup,
-								   new TButton(QIcon(":Resources/icons/translate.png")),
-								   EWidgetID::ButtonTranslateEast);
+					->add<EWidgetID::ButtonTranslateEast>(new TButton(QIcon(":Resources/icons/translate.png")));
 			
 			__speakButtonWest->setFixedSize(__buttonSize);
 			__speakButtonEast->setFixedSize(__buttonSize);
@@ -162,9 +151,7 @@ namespace Dixter
 			// Set central box
 			auto __widgetLayoutCenter = new QVBoxLayout;
 			auto __flipButton = m_widgets
-					->add<TButton>(g_controlGroup,
-								   new TButton(QIcon(":Resources/icons/flip.png")),
-								   EWidgetID::ButtonFlip);
+					->add<EWidgetID::ButtonFlip>(new TButton(QIcon(":Resources/icons/flip.png")));
 			
 			__flipButton->setFixedSize(__buttonSize);
 			__widgetLayoutCenter->addSpacing(44);
@@ -200,14 +187,14 @@ namespace Dixter
 			
 			try
 			{
-				auto __languageBoxWest = m_widgets->get<TOptionBox>(g_widgetGroup, EWidgetID::LangboxWest);
+				auto __languageBoxWest = m_widgets->get<EWidgetID::LangboxWest>();
 				if (__languageBoxWest->isPlaceholderSet())
 					return {};
 				
 				__languageName = __languageBoxWest->currentText().toStdString();
-				__languageId = getXmlManager({ g_langConfigPath })
+				__languageId = getCatalogueManager()
 						->accessor()
-						->getValue(NodeKey::kLangNameNode, __languageName, NodeKey::kLangRoot).asUTF8();
+						->getValue(NodeHandle::kLangNameNode, __languageName, NodeKey::kLangRoot).asUTF8();
 			}
 			catch (TException& e)
 			{
@@ -221,10 +208,10 @@ namespace Dixter
 		
 		void TTranslatorPanel::onFlip()
 		{
-			auto __texteditWest = m_widgets->get<TTextEdit>(g_widgetGroup, EWidgetID::TranslatorAreaWest);
-			auto __languageBoxWest = m_widgets->get<TOptionBox>(g_widgetGroup, EWidgetID::LangboxWest);
-			auto __texteditEast = m_widgets->get<TTextEdit>(g_widgetGroup, EWidgetID::TranslatorAreaEast);
-			auto __languageBoxEast = m_widgets->get<TOptionBox>(g_widgetGroup, EWidgetID::LangboxEast);
+			auto __texteditWest = m_widgets->get<EWidgetID::TranslatorAreaWest>();
+			auto __languageBoxWest = m_widgets->get<EWidgetID::LangboxWest>();
+			auto __texteditEast = m_widgets->get<EWidgetID::TranslatorAreaEast>();
+			auto __languageBoxEast = m_widgets->get<EWidgetID::LangboxEast>();
 			
 			__languageBoxWest->swapCurrent(__languageBoxEast);
 			__texteditWest->swapContent(__texteditEast);
@@ -232,7 +219,7 @@ namespace Dixter
 		
 		void TTranslatorPanel::onSpeakWest()
 		{
-			auto __content = m_widgets->get<TTextEdit>(g_widgetGroup, EWidgetID::TranslatorAreaWest)
+			auto __content = m_widgets->get<EWidgetID::TranslatorAreaWest>()
 									  ->getContent();
 			if (not __content.isEmpty())
 			{
@@ -260,9 +247,9 @@ namespace Dixter
 		void TTranslatorPanel::onLanguageChangeFrom()
 		{
 			#ifdef USE_SPEECHD
-			m_widgets->get<OptionBox>(g_widgetGroup, EWidgetID::LangboxWest)->onChanged(choiceEvent);
+			m_widgets->get<EWidgetID::LangboxWest>()->onChanged(choiceEvent);
 			TUString __langId {};
-			auto __pLangBox = m_widgets->get<OptionBox>(g_widgetGroup, EWidgetID::LangboxWest);
+			auto __pLangBox = m_widgets->get<EWidgetID::LangboxWest>();
 			auto __langName = __pLangBox->GetStringSelection();
 			try
 			{
@@ -283,8 +270,8 @@ namespace Dixter
 		{
 			#ifdef USE_SPEECHD
 			QString __voiceId {};
-			auto __voiceName = m_widgets->get<OptionBox>(g_widgetGroup, EWidgetID::VoiceBoxT)->GetStringSelection();
-
+			auto __voiceName = m_widgets->get<EWidgetID::VoiceBoxT>()->GetStringSelection();
+			
 			try
 			{
 				auto confMgr = ConfigurationManager::getManager();
@@ -293,8 +280,8 @@ namespace Dixter
 			delete confMgr;
 			#endif
 			} catch (...) {}
-
-
+			
+			
 			if (not __voiceId.empty())
 				m_narrator->setSynthesisVoice(TargetMode::Single, __voiceId);
 			printl_log(__voiceName)
@@ -303,15 +290,15 @@ namespace Dixter
 		
 		void TTranslatorPanel::connectEvents()
 		{
-			connect(m_widgets->get<TButton>(g_controlGroup, EWidgetID::ButtonFlip),
+			connect(m_widgets->get<EWidgetID::ButtonFlip>(),
 					SIGNAL(clicked()), SLOT(onFlip()));
-			connect(m_widgets->get<TButton>(g_controlGroup, EWidgetID::ButtonSpeakWest),
+			connect(m_widgets->get<EWidgetID::ButtonSpeakWest>(),
 					SIGNAL(clicked()), SLOT(onSpeakWest()));
-			connect(m_widgets->get<TButton>(g_controlGroup, EWidgetID::ButtonTranslateWest),
+			connect(m_widgets->get<EWidgetID::ButtonTranslateWest>(),
 					SIGNAL(clicked()), SLOT(onTranslateWest()));
-			connect(m_widgets->get<TButton>(g_controlGroup, EWidgetID::ButtonSpeakEast),
+			connect(m_widgets->get<EWidgetID::ButtonSpeakEast>(),
 					SIGNAL(clicked()), SLOT(onSpeakEast()));
-			connect(m_widgets->get<TButton>(g_controlGroup, EWidgetID::ButtonTranslateEast),
+			connect(m_widgets->get<EWidgetID::ButtonTranslateEast>(),
 					SIGNAL(clicked()), SLOT(onTranslateEast()));
 		}
 		
@@ -9,6 +9,8 @@
  */
 #pragma once
 
+#include "Constants.hpp"
+#include "StaticGroup.hpp"
 #include "Gui/Panel.hpp"
 
 #ifdef USE_SPEECHD
@@ -28,6 +30,8 @@ namespace Dixter
 	namespace Gui
 	{
 		class TTextEdit;
+		class TOptionBox;
+		class TButton;
 		
 		class TTranslatorPanel : public APanel
 		{
@@ -36,7 +40,17 @@ namespace Dixter
 			#ifdef USE_SPEECHD
 			using SD = vsynth::SpeechDispatcher;
 			#endif
-			using WidgetGroup   = TGroup<QWidget, EWidgetID>;
+			using WidgetGroup   = TStaticGroup<QWidget,
+											   TTypedId<EWidgetID::VoiceBoxT, TOptionBox>,
+											   TTypedId<EWidgetID::TranslatorAreaWest, TTextEdit>,
+											   TTypedId<EWidgetID::TranslatorAreaEast, TTextEdit>,
+											   TTypedId<EWidgetID::LangboxWest, TOptionBox>,
+											   TTypedId<EWidgetID::LangboxEast, TOptionBox>,
+											   TTypedId<EWidgetID::ButtonSpeakWest, TButton>,
+											   TTypedId<EWidgetID::ButtonTranslateWest, TButton>,
+											   TTypedId<EWidgetID::ButtonSpeakEast, TButton>,
+											   TTypedId<EWidgetID::ButtonTranslateEast, TButton>,
+											   TTypedId<EWidgetID::ButtonFlip, TButton>>;
 			using GridGroup     = TGroup<QLayoutItem, EWidgetID>;
 		
 		public:
@@ -84,7 +98,7 @@ namespace Dixter
 			void onTextAreaEdit();
 			
 			void onVoiceChange();
-			
+		
 		private:
 			GridGroup* m_grids;
 			
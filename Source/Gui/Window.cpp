@@ -33,7 +33,8 @@ namespace Dixter
 				: TBase(title, width, height, visible, false, false),
 				  m_widgets(new TGroup<QWidget, EWidgetID>()),
 				  m_dictionaryPanel(),
-				  m_translatorPanel()
+				  m_translatorPanel(),
+				  m_settingsSubscriber()
 		{
 			init();
 			showAll(visible, visible);
@@ -42,6 +43,7 @@ namespace Dixter
 		
 		TWindow::~TWindow() noexcept
 		{
+			getIniManager({ g_guiConfigPath })->unsubscribe(m_settingsSubscriber);
 			delete m_widgets;
 		}
 		
@@ -72,6 +74,28 @@ namespace Dixter
 		};
 		
 		void TWindow::init()
+		{
+			applySettings();
+			
+			setCentralWidget(m_widgets->add<TNotebook>(g_widgetGroup, new TNotebook(this),
+													   EWidgetID::Notebook));
+			initDictionary();
+			initTranslator();
+		}
+		
+		void TWindow::connectEvents()
+		{
+			auto __confMan = getIniManager({ g_guiConfigPath });
+			m_settingsSubscriber = __confMan->subscribe([ this ](const TChangeList&)
+			{
+				// called on watcher thread, widgets are changed on the GUI one
+				QMetaObject::invokeMethod(this, [ this ] { applySettings(); }, Qt::QueuedConnection);
+			});
+			if (not __confMan->watch())
+				printerr("Settings file can't be watched, changes apply after restart")
+		}
+		
+		void TWindow::applySettings()
 		{
 			auto __confMan = getIniManager({ g_guiConfigPath });
 			auto __backgroundColour = __confMan->accessor()->getValue(NodeKey::kWinBgColourNode).asCustom();
@@ -81,16 +105,8 @@ namespace Dixter
 			__backgroundColour.prepend('#');
 			setPalette(QPalette(__backgroundColour));
 			setFont(QFont(__fontName, __fontSize));
-			
-			setCentralWidget(m_widgets->add<TNotebook>(g_widgetGroup, new TNotebook(this),
-													   EWidgetID::Notebook));
-			initDictionary();
-			initTranslator();
 		}
 		
-		void TWindow::connectEvents()
-		{ }
-		
 		void TWindow::initDictionary()
 		{
 			auto __pNotebook = m_widgets->get<TNotebook>(g_widgetGroup, EWidgetID::Notebook);
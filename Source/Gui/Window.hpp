@@ -58,6 +58,9 @@ namespace Dixter
 			void initDictionary();
 			
 			void initTranslator();
+			
+			/// Applies colours and font of settings, again whenever settings file changes
+			void applySettings();
 		
 		private:
 			TGroup<QWidget, EWidgetID>* m_widgets;
@@ -65,6 +68,9 @@ namespace Dixter
 			TDictionaryPanel* m_dictionaryPanel;
 			
 			TTranslatorPanel* m_translatorPanel;
+			
+			/// Subscription to changes of settings file
+			UInt32 m_settingsSubscriber;
 		};
 	}
 }
\ No newline at end of file
@@ -0,0 +1,358 @@
+/**
+ *  Copyright (C) 2015-2019
+ *  Author Alvin Ahmadov <alvin.dev.ahmadov@gmail.com>
+ *
+ *  This file is part of Dixter Project
+ *  License-Identifier: MIT License
+ *  See README.md for more information.
+ */
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <algorithm>
+
+#include "Exception.hpp"
+#include "JsonReader.hpp"
+#include "Transcoder.hpp"
+
+namespace Dixter
+{
+	namespace
+	{
+		constexpr std::uint64_t kOnes = 0x0101010101010101ULL;
+		constexpr std::uint64_t kHighBits = 0x8080808080808080ULL;
+		
+		/// Nonzero if any byte of word is zero
+		constexpr std::uint64_t hasZero(std::uint64_t word) noexcept
+		{
+			return ( word - kOnes ) & ~word & kHighBits;
+		}
+		
+		/// Nonzero if any byte of word is quote, backslash or control character
+		inline bool hasSpecial(const TByte* bytes) noexcept
+		{
+			std::uint64_t __word;
+			std::memcpy(&__word, bytes, sizeof(__word));
+			return hasZero(__word ^ ( kOnes * '"' )) or hasZero(__word ^ ( kOnes * '\\' ))
+				   or (( __word - kOnes * 0x20 ) & ~__word & kHighBits );
+		}
+		
+		inline bool isSpace(TByte c) noexcept
+		{
+			return c == ' ' or c == '\t' or c == '\n' or c == '\r';
+		}
+		
+		inline bool isDigit(TByte c) noexcept
+		{
+			return c >= '0' and c <= '9';
+		}
+		
+		inline Int32 hexDigit(TByte c) noexcept
+		{
+			if (c >= '0' and c <= '9')
+				return c - '0';
+			if (c >= 'a' and c <= 'f')
+				return c - 'a' + 10;
+			if (c >= 'A' and c <= 'F')
+				return c - 'A' + 10;
+			return -1;
+		}
+	} // anonymous namespace
+	
+	TJsonReader::TJsonReader(IJsonHandler& handler) noexcept
+			: m_handler(handler),
+			  m_buffer(),
+			  m_document(),
+			  m_size(),
+			  m_position(),
+			  m_containers()
+	{ }
+	
+	void TJsonReader::parse(TString& document)
+	{
+		m_document = document.data();
+		m_size = document.size();
+		m_position = 0;
+		m_containers.clear();
+		
+		// UTF-8 byte order mark
+		if (m_size >= 3 and std::memcmp(m_document, "\xEF\xBB\xBF", 3) == 0)
+			m_position = 3;
+		
+		skipSpaces();
+		if (m_position == m_size)
+			fail("Empty document");
+		
+		while (true)
+		{
+			if (parseValue())
+				continue;
+			
+			// value done, close containers it completed
+			while (not m_containers.empty())
+			{
+				skipSpaces();
+				if (m_position == m_size)
+					fail("Unexpected end of document");
+				
+				const auto __c = m_document[m_position++];
+				if (__c == ',')
+				{
+					if (not m_containers.back())
+						parseKey();
+					break;
+				}
+				if (__c == ( m_containers.back() ? ']' : '}' ))
+				{
+					const bool __array(m_containers.back());
+					m_containers.pop_back();
+					__array ? m_handler.onEndArray() : m_handler.onEndObject();
+				}
+				else
+					fail(m_containers.back() ? "Expected ',' or ']'" : "Expected ',' or '}'");
+			}
+			
+			if (m_containers.empty())
+				break;
+		}
+		
+		skipSpaces();
+		if (m_position != m_size)
+			fail("Unexpected data after document");
+	}
+	
+	void TJsonReader::parseFile(const TString& path)
+	{
+		std::ifstream __file(path, std::ios::binary);
+		if (not __file)
+			throw TNotFoundException("%s:%d Can't read \"%s\".", __FILE__, __LINE__, path);
+		
+		m_buffer.assign(std::istreambuf_iterator<TByte>(__file), std::istreambuf_iterator<TByte>());
+		parse(m_buffer);
+	}
+	
+	bool TJsonReader::parseValue()
+	{
+		skipSpaces();
+		if (m_position == m_size)
+			fail("Expected value");
+		
+		switch (m_document[m_position])
+		{
+			case '{':
+				++m_position;
+				m_handler.onStartObject();
+				skipSpaces();
+				if (m_position < m_size and m_document[m_position] == '}')
+				{
+					++m_position;
+					m_handler.onEndObject();
+					return false;
+				}
+				m_containers.push_back(false);
+				parseKey();
+				return true;
+			case '[':
+				++m_position;
+				m_handler.onStartArray();
+				skipSpaces();
+				if (m_position < m_size and m_document[m_position] == ']')
+				{
+					++m_position;
+					m_handler.onEndArray();
+					return false;
+				}
+				m_containers.push_back(true);
+				return true;
+			case '"':
+				m_handler.onValue(parseString(), EJsonType::String);
+				return false;
+			case 't':
+				parseLiteral("true");
+				m_handler.onValue("true", EJsonType::Boolean);
+				return false;
+			case 'f':
+				parseLiteral("false");
+				m_handler.onValue("false", EJsonType::Boolean);
+				return false;
+			case 'n':
+				parseLiteral("null");
+				m_handler.onValue(TStringView(), EJsonType::Null);
+				return false;
+			default:
+				m_handler.onValue(parseNumber(), EJsonType::Number);
+				return false;
+		}
+	}
+	
+	void TJsonReader::parseKey()
+	{
+		skipSpaces();
+		if (m_position == m_size or m_document[m_position] != '"')
+			fail("Expected key");
+		
+		m_handler.onKey(parseString());
+		skipSpaces();
+		expect(':');
+	}
+	
+	TStringView TJsonReader::parseString()
+	{
+		const auto __begin = ++m_position;
+		
+		// fast path, string without escapes is used as is
+		while (m_position + 8 <= m_size and not hasSpecial(m_document + m_position))
+			m_position += 8;
+		
+		auto __target = m_position;
+		while (true)
+		{
+			if (m_position == m_size)
+				fail("Unterminated string");
+			
+			const auto __c = m_document[m_position];
+			if (__c == '"')
+				break;
+			
+			if (static_cast<unsigned char>(__c) < 0x20)
+				fail("Control character in string");
+			
+			if (__c != '\\')
+			{
+				m_document[__target++] = m_document[m_position++];
+				continue;
+			}
+			
+			if (m_position + 1 == m_size)
+				fail("Unterminated string");
+			
+			const auto __escape = m_document[m_position + 1];
+			m_position += 2;
+			switch (__escape)
+			{
+				case '"': m_document[__target++] = '"'; break;
+				case '\\': m_document[__target++] = '\\'; break;
+				case '/': m_document[__target++] = '/'; break;
+				case 'b': m_document[__target++] = '\b'; break;
+				case 'f': m_document[__target++] = '\f'; break;
+				case 'n': m_document[__target++] = '\n'; break;
+				case 'r': m_document[__target++] = '\r'; break;
+				case 't': m_document[__target++] = '\t'; break;
+				case 'u':
+				{
+					auto __readUnit = [this]() -> UInt32
+					{
+						if (m_position + 4 > m_size)
+							fail("Invalid unicode escape");
+						
+						UInt32 __unit {};
+						for (TSize __index {}; __index < 4; ++__index)
+						{
+							const auto __digit = hexDigit(m_document[m_position++]);
+							if (__digit < 0)
+								fail("Invalid unicode escape");
+							
+							__unit = __unit << 4 | static_cast<UInt32>(__digit);
+						}
+						return __unit;
+					};
+					auto __codePoint = __readUnit();
+					if (__codePoint >= 0xD800 and __codePoint < 0xDC00)
+					{
+						if (m_position + 2 > m_size or m_document[m_position] != '\\'
+							or m_document[m_position + 1] != 'u')
+							fail("Unpaired surrogate");
+						
+						m_position += 2;
+						const auto __low = __readUnit();
+						if (__low < 0xDC00 or __low >= 0xE000)
+							fail("Unpaired surrogate");
+						
+						__codePoint = 0x10000 + (( __codePoint - 0xD800 ) << 10 ) + ( __low - 0xDC00 );
+					}
+					else if (__codePoint >= 0xDC00 and __codePoint < 0xE000)
+						fail("Unpaired surrogate");
+					
+					// escape is never shorter than its encoding, so target stays behind
+					__target += Unicode::encodeUtf8(__codePoint, m_document + __target);
+					break;
+				}
+				default:
+					fail("Invalid escape");
+			}
+		}
+		++m_position;
+		return TStringView(m_document + __begin, __target - __begin);
+	}
+	
+	TStringView TJsonReader::parseNumber()
+	{
+		const auto __begin = m_position;
+		if (m_position < m_size and m_document[m_position] == '-')
+			++m_position;
+		
+		if (m_position < m_size and m_document[m_position] == '0')
+			++m_position;
+		else if (m_position < m_size and isDigit(m_document[m_position]))
+			while (m_position < m_size and isDigit(m_document[m_position]))
+				++m_position;
+		else
+			fail("Expected value");
+		
+		if (m_position < m_size and m_document[m_position] == '.')
+		{
+			++m_position;
+			if (m_position == m_size or not isDigit(m_document[m_position]))
+				fail("Expected digit");
+			
+			while (m_position < m_size and isDigit(m_document[m_position]))
+				++m_position;
+		}
+		if (m_position < m_size and ( m_document[m_position] == 'e' or m_document[m_position] == 'E' ))
+		{
+			++m_position;
+			if (m_position < m_size and ( m_document[m_position] == '+' or m_document[m_position] == '-' ))
+				++m_position;
+			
+			if (m_position == m_size or not isDigit(m_document[m_position]))
+				fail("Expected digit");
+			
+			while (m_position < m_size and isDigit(m_document[m_position]))
+				++m_position;
+		}
+		return TStringView(m_document + __begin, m_position - __begin);
+	}
+	
+	void TJsonReader::parseLiteral(TStringView literal)
+	{
+		if (TStringView(m_document + m_position, std::min(literal.size(), m_size - m_position)) != literal)
+			fail("Invalid literal");
+		
+		m_position += literal.size();
+	}
+	
+	void TJsonReader::skipSpaces() noexcept
+	{
+		while (m_position < m_size and isSpace(m_document[m_position]))
+			++m_position;
+	}
+	
+	void TJsonReader::expect(TByte c)
+	{
+		if (m_position == m_size or m_document[m_position] != c)
+		{
+			const TByte __message[] = { 'E', 'x', 'p', 'e', 'c', 't', 'e', 'd', ' ', '\'', c, '\'', '\0' };
+			fail(__message);
+		}
+		++m_position;
+	}
+	
+	void TJsonReader::fail(const char* message) const
+	{
+		const auto __end = std::min(m_position, m_size);
+		const auto __line = 1 + std::count(m_document, m_document + __end, '\n');
+		throw TParseException("%s:%d %s at line %u", __FILE__, __LINE__, message, static_cast<UInt32>(__line));
+	}
+} // namespace Dixter
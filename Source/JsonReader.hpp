@@ -0,0 +1,113 @@
+/**
+ *  Copyright (C) 2015-2019
+ *  Author Alvin Ahmadov <alvin.dev.ahmadov@gmail.com>
+ *
+ *  This file is part of Dixter Project
+ *  License-Identifier: MIT License
+ *  See README.md for more information.
+ */
+#pragma once
+
+#include <vector>
+
+#include "Commons.hpp"
+
+namespace Dixter
+{
+	enum class EJsonType
+	{
+		String,
+		Number,
+		Boolean,
+		Null
+	};
+	
+	/**
+	 * \interface IJsonHandler
+	 * \brief Receives events of TJsonReader in document order.
+	 *
+	 * Views passed to handler point into document being read.
+	 * */
+	struct IJsonHandler
+	{
+		virtual void onStartObject() = 0;
+		
+		virtual void onKey(TStringView key) = 0;
+		
+		virtual void onEndObject() = 0;
+		
+		virtual void onStartArray() = 0;
+		
+		virtual void onEndArray() = 0;
+		
+		/**
+		 * Scalar value. Strings are unescaped, numbers and literals
+		 * are passed as written.
+		 * */
+		virtual void onValue(TStringView value, EJsonType type) = 0;
+		
+		virtual ~IJsonHandler() = default;
+	};
+	
+	/**
+	 * \class TJsonReader
+	 * \brief Single pass in situ JSON reader.
+	 *
+	 * Strings are unescaped in place inside document buffer, so keys and
+	 * values are reported as views without allocation. Strings are scanned
+	 * for quotes and escapes eight bytes at a time. Nesting is tracked on
+	 * explicit stack, so deep documents don't exhaust call stack.
+	 * */
+	class TJsonReader : public TNonCopyable
+	{
+	public:
+		explicit TJsonReader(IJsonHandler& handler) noexcept;
+		
+		~TJsonReader() noexcept override = default;
+		
+		/**
+		 * \param document UTF-8 document, modified while read.
+		 * \throws TParseException on malformed document.
+		 * */
+		void parse(TString& document);
+		
+		/**
+		 * Reads file into buffer kept by reader until next parse.
+		 * \throws TNotFoundException if file can't be read.
+		 * \throws TParseException on malformed document.
+		 * */
+		void parseFile(const TString& path);
+	
+	private:
+		/// Parses scalar or opens container, \returns true if container was opened
+		bool parseValue();
+		
+		void parseKey();
+		
+		TStringView parseString();
+		
+		TStringView parseNumber();
+		
+		void parseLiteral(TStringView literal);
+		
+		void skipSpaces() noexcept;
+		
+		void expect(TByte c);
+		
+		[[noreturn]] void fail(const char* message) const;
+	
+	private:
+		IJsonHandler& m_handler;
+		
+		TString m_buffer;
+		
+		TByte* m_document;
+		
+		TSize m_size;
+		
+		TSize m_position;
+		
+		/// Open containers, true for arrays
+		std::vector<bool> m_containers;
+	};
+} // namespace Dixter
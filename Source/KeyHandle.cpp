@@ -0,0 +1,86 @@
+/**
+ *  Copyright (C) 2015-2019
+ *  Author Alvin Ahmadov <alvin.dev.ahmadov@gmail.com>
+ *
+ *  This file is part of Dixter Project
+ *  License-Identifier: MIT License
+ *  See README.md for more information.
+ */
+
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+
+#include "KeyHandle.hpp"
+
+namespace Dixter
+{
+	namespace
+	{
+		/// Interned paths, which are never removed, so handles can keep pointers to them
+		struct TKeyTable
+		{
+			std::deque<TString> paths_;
+			
+			std::unordered_map<TStringView, UInt32> ids_;
+			
+			std::mutex mutex_;
+		};
+		
+		TKeyTable& keyTable()
+		{
+			static TKeyTable s_table;
+			return s_table;
+		}
+	} // anonymous namespace
+	
+	TKeyHandle::TKeyHandle() noexcept
+			: m_id(kInvalid),
+			  m_path(nullptr)
+	{ }
+	
+	TKeyHandle::TKeyHandle(UInt32 id, const TString* path) noexcept
+			: m_id(id),
+			  m_path(path)
+	{ }
+	
+	TKeyHandle TKeyHandle::compile(TStringView path)
+	{
+		auto& __table = keyTable();
+		std::lock_guard<std::mutex> __lockGuard(__table.mutex_);
+		auto __id = __table.ids_.find(path);
+		if (__id != __table.ids_.end())
+			return TKeyHandle(__id->second, &__table.paths_[__id->second]);
+		
+		const auto __newId = static_cast<UInt32>(__table.paths_.size());
+		const auto& __path = __table.paths_.emplace_back(path);
+		__table.ids_.emplace(__path, __newId);
+		return TKeyHandle(__newId, &__path);
+	}
+	
+	UInt32 TKeyHandle::id() const noexcept
+	{
+		return m_id;
+	}
+	
+	const TString& TKeyHandle::path() const noexcept
+	{
+		static const TString s_emptyPath {};
+		return m_path ? *m_path : s_emptyPath;
+	}
+	
+	bool TKeyHandle::valid() const noexcept
+	{
+		return m_id != kInvalid;
+	}
+	
+	bool TKeyHandle::operator==(const TKeyHandle& other) const noexcept
+	{
+		return m_id == other.m_id;
+	}
+	
+	bool TKeyHandle::operator!=(const TKeyHandle& other) const noexcept
+	{
+		return m_id != other.m_id;
+	}
+} // namespace Dixter
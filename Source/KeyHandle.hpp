@@ -0,0 +1,68 @@
+/**
+ *  Copyright (C) 2015-2019
+ *  Author Alvin Ahmadov <alvin.dev.ahmadov@gmail.com>
+ *
+ *  This file is part of Dixter Project
+ *  License-Identifier: MIT License
+ *  See README.md for more information.
+ */
+#pragma once
+
+#include "Types.hpp"
+
+namespace Dixter
+{
+	/**
+	 * \author Alvin Ahmadov
+	 * \class TKeyHandle
+	 * \brief Compiled configuration key.
+	 *
+	 * Dotted key path like "languages.language.name" is interned once
+	 * into a small integer, which is assigned to every node with that
+	 * name while configuration is loaded. Lookups by handle compare and
+	 * index by integer instead of hashing and comparing the path.
+	 * Handles are process wide and stay valid for the process lifetime.
+	 * \code
+	 * static const auto s_nameKey = TKeyHandle::compile("languages.language.name");
+	 * accessor->getValue(s_nameKey, languageId, "languages");
+	 * \endcode
+	 * */
+	class TKeyHandle
+	{
+	public:
+		static constexpr UInt32 kInvalid = UInt32(-1);
+	
+	public:
+		/**
+		 * Invalid handle, matching no node.
+		 * */
+		TKeyHandle() noexcept;
+		
+		/**
+		 * \brief Interns key path.
+		 * \returns Handle equal to every other handle compiled from the same path.
+		 * */
+		static TKeyHandle compile(TStringView path);
+		
+		UInt32 id() const noexcept;
+		
+		/**
+		 * Interned path of key, empty for invalid handle.
+		 * */
+		const TString& path() const noexcept;
+		
+		bool valid() const noexcept;
+		
+		bool operator==(const TKeyHandle& other) const noexcept;
+		
+		bool operator!=(const TKeyHandle& other) const noexcept;
+	
+	private:
+		TKeyHandle(UInt32 id, const TString* path) noexcept;
+	
+	private:
+		UInt32 m_id;
+		
+		const TString* m_path;
+	};
+} // namespace Dixter
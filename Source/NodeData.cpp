@@ -7,90 +7,127 @@
  *  See README.md for more information.
  */
 
+#include <algorithm>
+
 #include "Macros.hpp"
 #include "Exception.hpp"
 #include "NodeData.hpp"
 
 namespace Dixter
 {
-	// TAttribute Implementation
-	TAttribute::TAttribute(const TString& attributeName, const TUString& attributeValue) noexcept
-			: m_index(),
-			  m_name(attributeName),
-			  m_value(attributeValue)
+	// TNodeData Implementation
+	TNodeData::TNodeData() noexcept
+			: m_nodes(),
+			  m_attributes(),
+			  m_arena()
 	{ }
 	
-	// TNode Implementation
-	TNode::TNode(const TString& nodeName, const TUString& nodeValue, const TString& parent) noexcept
-			: m_index(),
-			  m_name(nodeName),
-			  m_value(nodeValue),
-			  m_parent(parent)
-	{ }
+	TNodeData::TNodeData(const TNodeData& other)
+			: m_nodes(other.m_nodes),
+			  m_attributes(other.m_attributes),
+			  m_arena()
+	{
+		TSize __size {};
+		for (const auto& __node : m_nodes)
+			__size += __node.name_.length_ + __node.value_.length_ + __node.parent_.length_;
+		for (const auto& __attr : m_attributes)
+			__size += __attr.name_.length_ + __attr.value_.length_;
+		m_arena.reserve(__size);
+		
+		// values replaced by setValue are left behind, shared parents stay shared
+		for (TSize __position {}; __position < m_nodes.size(); ++__position)
+		{
+			auto& __node = m_nodes[__position];
+			const auto& __source = other.m_nodes[__position];
+			__node.name_ = store(other.name(__source));
+			__node.value_ = store(other.value(__source));
+			
+			const auto __sharesParent = __position > 0
+											and __source.parent_.offset_ == other.m_nodes[__position - 1].parent_.offset_
+											and __source.parent_.length_ == other.m_nodes[__position - 1].parent_.length_;
+			__node.parent_ = __sharesParent ? m_nodes[__position - 1].parent_ : store(other.parent(__source));
+		}
+		for (auto& __attr : m_attributes)
+		{
+			__attr.name_ = store(other.string(__attr.name_));
+			__attr.value_ = store(other.string(__attr.value_));
+		}
+	}
 	
-	bool TNode::equal(const TNode& node) const
+	void TNodeData::insertData(const TString& nodeName, const TU8String& nodeValue,
+							   const TString& parent,
+							   const TString& attributeName, const TU8String& attributeValue)
 	{
-		return (( m_name.compare(node.m_name) == 0) and
-				( m_value.compare(node.m_value) == 0 ) and
-				( m_index == node.m_index ));
+		// index of node within data
+		const TSize __index(m_nodes.size());
+		insertNode(nodeName, nodeValue.asUTF8(), parent, __index);
+		
+		if (not attributeName.empty() and not attributeValue.empty())
+			insertAttribute(attributeName, attributeValue.asUTF8(), __index);
 	}
 	
-	bool TNode::has(const TString& name) const
+	void TNodeData::insertNode(TStringView nodeName, TStringView nodeValue,
+							   TStringView parent, TSize index)
 	{
-		return not m_name.compare(name);
+		TNode __node { TKeyHandle::compile(nodeName), store(nodeName), store(nodeValue), {},
+					   static_cast<UInt32>(index) };
+		// nodes of data mostly share parent, which is stored once
+		__node.parent_ = not m_nodes.empty() and this->parent(m_nodes.back()) == parent
+						 ? m_nodes.back().parent_ : store(parent);
+		m_nodes.push_back(__node);
 	}
 	
-	// TNodeData Implementation
-	TNodeData::TNodeData() noexcept
-			: m_nodes(),
-			  m_attributes()
-	{ }
+	void TNodeData::insertAttribute(TStringView attributeName, TStringView attributeValue, TSize index)
+	{
+		m_attributes.push_back({ store(attributeName), store(attributeValue), static_cast<UInt32>(index) });
+	}
 	
-	void TNodeData::insertData(const TString& nodeName, const TUString& nodeValue,
-							   const TString& parent,
-							   const TString& attributeName, const TUString& attributeValue)
+	void TNodeData::setValue(const TString& name, const TU8String& value)
 	{
-		static TString __parentBefore(parent);
-		static TString __startNode(nodeName);
-		static TSize __index {};
+		bool __found {};
+		const auto& __value = value.asUTF8();
+		for (TSize __position {}; __position < m_nodes.size(); ++__position)
+			if (this->name(m_nodes[__position]) == name)
+			{
+				setValue(__position, __value);
+				__found = true;
+			}
 		
-		if (parent != __parentBefore)
+		if (not __found)
+			throw TNotFoundException("%s:%d No node with name %s.", __FILE__, __LINE__, name);
+	}
+	
+	void TNodeData::setValue(TSize position, TStringView value)
+	{
+		// slices of values are never shared, unlike ones of parents
+		auto& __value = m_nodes.at(position).value_;
+		if (value.size() <= __value.length_)
 		{
-			__startNode = nodeName;
-			__parentBefore = parent;
+			std::char_traits<TByte>::move(m_arena.data() + __value.offset_, value.data(), value.size());
+			__value.length_ = static_cast<UInt32>(value.size());
 		}
-		
-		m_nodes.push_back(dxMAKE_SHARED(TNode, nodeName, nodeValue, parent));
-		if (not nodeName.compare(__startNode))
-			__index = 0;
 		else
-			__index++;
-		
-		if (not attributeName.empty() and not attributeValue.empty())
-		{
-			m_attributes.push_back(dxMAKE_SHARED(TAttribute, attributeName, attributeValue));
-			m_attributes.back()->m_index = __index;
-		}
-		m_nodes.back()->m_index = __index;
+			__value = store(value);
 	}
 	
-	void TNodeData::setValue(const TString& name, const TUString& value)
+	TU8String
+	TNodeData::getValue(const TString& name) const
 	{
-		for (const auto& __node : getNodes())
-			if (__node->has(name))
-				__node->m_value = value;
+		for (const auto& __node : m_nodes)
+			if (this->name(__node) == name)
+				return TU8String(value(__node));
 		
 		throw TNotFoundException("%s:%d No node with name %s.", __FILE__, __LINE__, name);
 	}
 	
-	TUString
-	TNodeData::getValue(const TString& name) const
+	TU8String
+	TNodeData::getValue(const TKeyHandle& key) const
 	{
-		for (const auto& __node : getNodes())
-			if (__node->has(name))
-				return __node->m_value;
+		for (const auto& __node : m_nodes)
+			if (__node.key_ == key)
+				return TU8String(value(__node));
 		
-		throw TNotFoundException("%s:%d No node with name %s.", __FILE__, __LINE__, name);
+		throw TNotFoundException("%s:%d No node with name %s.", __FILE__, __LINE__, key.path());
 	}
 	
 	const TNodeData::TNodeList&
@@ -99,9 +136,50 @@ namespace Dixter
 		return m_nodes;
 	}
 	
-	TNodeData::TNodeList&
-	TNodeData::getNodes()
+	const TNodeData::TAttributeList&
+	TNodeData::getAttributes() const
 	{
-		return m_nodes;
+		return m_attributes;
+	}
+	
+	TNodeData::TAttributeRange
+	TNodeData::getAttributes(TSize index) const
+	{
+		struct TCompare
+		{
+			bool operator()(const TAttribute& attribute, TSize index) const noexcept
+			{ return attribute.index_ < index; }
+			
+			bool operator()(TSize index, const TAttribute& attribute) const noexcept
+			{ return index < attribute.index_; }
+		};
+		return std::equal_range(m_attributes.begin(), m_attributes.end(), index, TCompare());
+	}
+	
+	TStringView TNodeData::string(const TStringRef& reference) const noexcept
+	{
+		return TStringView(m_arena.data() + reference.offset_, reference.length_);
+	}
+	
+	TStringView TNodeData::name(const TNode& node) const noexcept
+	{
+		return string(node.name_);
+	}
+	
+	TStringView TNodeData::value(const TNode& node) const noexcept
+	{
+		return string(node.value_);
+	}
+	
+	TStringView TNodeData::parent(const TNode& node) const noexcept
+	{
+		return string(node.parent_);
+	}
+	
+	TNodeData::TStringRef TNodeData::store(TStringView string)
+	{
+		const TStringRef __reference { static_cast<UInt32>(m_arena.size()), static_cast<UInt32>(string.size()) };
+		m_arena.append(string);
+		return __reference;
 	}
-} // namespace Dixter
\ No newline at end of file
+} // namespace Dixter
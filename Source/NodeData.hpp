@@ -9,87 +9,99 @@
 #pragma once
 
 #include <memory>
-#include <deque>
+#include <vector>
+#include <utility>
 #include "Types.hpp"
+#include "KeyHandle.hpp"
 
 namespace Dixter
 {
-	/**
-	 * Field of attributes in consfiguration file for specific nodes
-	 **/
-	struct TAttribute
-	{
-		TAttribute() = delete;
-		
-		explicit TAttribute(const TString& attributeName,
-							const TUString& attributeValue) noexcept;
-		
-		TAttribute(const TAttribute&) = default;
-		
-		TAttribute& operator=(const TAttribute&) = default;
-		
-		TSize m_index;
-		
-		TString m_name;
-		
-		TUString m_value;
-	};
-	
-	/**
-	 * Stores data parsed from settings file as node key and node value
-	 **/
-	struct TNode
-	{
-		TNode() = delete;
-		
-		/**
-		 * Constructor saving node's key and value
-		 * @param nodeName name of the node
-		 * @param nodeValue value of node
-		 * */
-		explicit TNode(const TString& nodeName, const TUString& nodeValue,
-					   const TString& parent = TString()) noexcept;
-		
-		TNode(const TNode&) = default;
-		
-		TNode& operator=(const TNode&) = default;
-		
-		bool equal(const TNode& node) const;
-		
-		bool has(const TString& name) const;
-		
-		TSize m_index;
-		
-		TString m_name;
-		
-		TUString m_value;
-		
-		TString m_parent;
-	};
-	
 	/**
 	 * Parses information for configuration and saves it
+	 *
+	 * Nodes and attributes are flat records in contiguous vectors, their
+	 * strings are UTF-8 slices of a single arena, so data is a handful of
+	 * allocations however many nodes it holds, and scans don't chase pointers.
+	 * Attributes are ordered by index of node they belong to.
 	 **/
 	class TNodeData final
 	{
 	public:
-		using TNodeList         = std::deque<std::shared_ptr<TNode>>;
-		using TAttributeList    = std::deque<std::shared_ptr<TAttribute>>;
+		/// Slice of string arena
+		struct TStringRef
+		{
+			UInt32 offset_;
+			
+			UInt32 length_;
+		};
+		
+		/**
+		 * Node key and node value, parsed from settings file
+		 **/
+		struct TNode
+		{
+			/// Compiled name
+			TKeyHandle key_;
+			
+			TStringRef name_;
+			
+			TStringRef value_;
+			
+			TStringRef parent_;
+			
+			/// Index of node within data as given by loader
+			UInt32 index_;
+		};
+		
+		/**
+		 * Field of attributes in configuration file for specific nodes
+		 **/
+		struct TAttribute
+		{
+			TStringRef name_;
+			
+			TStringRef value_;
+			
+			/// Index of node the attribute belongs to
+			UInt32 index_;
+		};
+		
+		using TNodeList         = std::vector<TNode>;
+		using TAttributeList    = std::vector<TAttribute>;
+		using TAttributeRange   = std::pair<TAttributeList::const_iterator, TAttributeList::const_iterator>;
 	public:
 		/**
 		 * Default constructor
 		 **/
 		TNodeData() noexcept;
 		
+		/**
+		 * Copies live strings only, into arena of their size
+		 **/
+		TNodeData(const TNodeData& other);
+		
+		TNodeData& operator=(const TNodeData& other) = delete;
+		
 		~TNodeData() noexcept = default;
 		
 		/**
 		 * Add node for configuration
 		 */
-		void insertData(const TString& nodeName, const TUString& nodeValue,
+		void insertData(const TString& nodeName, const TU8String& nodeValue,
 						const TString& parent = TString(),
 						const TString& attributeName = TString(),
-						const TUString& attributeValue = TString());
+						const TU8String& attributeValue = TString());
+		
+		/**
+		 * Add node with known index, as built by loaders or restored from cache
+		 */
+		void insertNode(TStringView nodeName, TStringView nodeValue,
+						TStringView parent, TSize index);
+		
+		/**
+		 * Add attribute with known index of node it belongs to
+		 */
+		void insertAttribute(TStringView attributeName, TStringView attributeValue, TSize index);
 		
 		/**
 		 * \class NodeData
@@ -98,7 +110,14 @@ namespace Dixter
 		 * \param value Value to set.
 		 * \throws NotFoundException
 		 * */
-		void setValue(const TString& name, const TUString& value);
+		void setValue(const TString& name, const TU8String& value);
+		
+		/**
+		 * \brief Sets value of node at position, in place of old one
+		 * if it fits there, appended to arena otherwise. Space of values
+		 * replaced is reclaimed when data is copied.
+		 * */
+		void setValue(TSize position, TStringView value);
 		
 		/**
 		 * \class NodeData
@@ -107,17 +126,35 @@ namespace Dixter
 		 * \returns Value of node.
 		 * \throws NotFoundException
 		 * */
-		TUString getValue(const TString& name) const;
+		TU8String getValue(const TString& name) const;
 		
-		template<typename TContainer>
-		void getValues(const TString& name, TContainer& values) const
+		TU8String getValue(const TKeyHandle& key) const;
+		
+		template<typename TKey, typename TContainer>
+		void getValues(const TKey& name, TContainer& values) const
 		{
 			values.push_back(getValue(name));
 		}
 		
 		const TNodeList& getNodes() const;
 		
-		TNodeList& getNodes();
+		const TAttributeList& getAttributes() const;
+		
+		/**
+		 * Attributes of node with index
+		 * */
+		TAttributeRange getAttributes(TSize index) const;
+		
+		TStringView string(const TStringRef& reference) const noexcept;
+		
+		TStringView name(const TNode& node) const noexcept;
+		
+		TStringView value(const TNode& node) const noexcept;
+		
+		TStringView parent(const TNode& node) const noexcept;
+	
+	private:
+		TStringRef store(TStringView string);
 	
 	private:
 		/**
@@ -129,5 +166,10 @@ namespace Dixter
 		 * Attributes for every node
 		 **/
 		TAttributeList m_attributes;
+		
+		/**
+		 * Strings of nodes and attributes
+		 **/
+		TString m_arena;
 	};
 } // namespace Dixter
\ No newline at end of file
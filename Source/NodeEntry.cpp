@@ -15,13 +15,143 @@
 
 using TDefaultLockGuard = std::lock_guard<std::mutex>;
 
+namespace
+{
+	inline const Dixter::TString& keyPath(const Dixter::TString& key) noexcept
+	{
+		return key;
+	}
+	
+	inline const Dixter::TString& keyPath(const Dixter::TKeyHandle& key) noexcept
+	{
+		return key.path();
+	}
+} // anonymous namespace
+
 namespace Dixter
 {
+	// TNodeEntry::TSnapshot implementation
+	const TNodeEntry::TNodeHandle*
+	TNodeEntry::TSnapshot::lookup(const TString& key) const
+	{
+		auto __handles = handles(key);
+		return __handles ? &__handles->back() : nullptr;
+	}
+	
+	const TNodeEntry::TNodeHandle*
+	TNodeEntry::TSnapshot::lookup(const TKeyHandle& key) const
+	{
+		auto __handles = handles(key);
+		return __handles ? &__handles->back() : nullptr;
+	}
+	
+	const TNodeEntry::THandleList*
+	TNodeEntry::TSnapshot::handles(const TString& key) const
+	{
+		auto __key = nameIndex_.find(key);
+		return __key != nameIndex_.end() ? handles(__key->second) : nullptr;
+	}
+	
+	const TNodeEntry::THandleList*
+	TNodeEntry::TSnapshot::handles(const TKeyHandle& key) const
+	{
+		if (key.id() >= keyIndex_.size() or keyIndex_[key.id()].empty())
+			return nullptr;
+		
+		return &keyIndex_[key.id()];
+	}
+	
+	TNodeEntry::THandleList*
+	TNodeEntry::TSnapshot::handles(const TString& key)
+	{
+		return const_cast<THandleList*>(static_cast<const TSnapshot*>(this)->handles(key));
+	}
+	
+	TNodeEntry::THandleList*
+	TNodeEntry::TSnapshot::handles(const TKeyHandle& key)
+	{
+		return const_cast<THandleList*>(static_cast<const TSnapshot*>(this)->handles(key));
+	}
+	
+	const TNodeEntry::TNodeHandle*
+	TNodeEntry::TSnapshot::lookupValue(TStringView value) const
+	{
+		auto __handles = valueIndex_.find(TString(value));
+		return __handles != valueIndex_.end() ? &__handles->second.back() : nullptr;
+	}
+	
+	const TNodeData::TNode&
+	TNodeEntry::TSnapshot::node(const TNodeHandle& handle) const
+	{
+		return entries_.at(handle.entry_)->getNodes()[handle.node_];
+	}
+	
+	TStringView TNodeEntry::TSnapshot::value(const TNodeHandle& handle) const
+	{
+		const auto& __data = entries_.at(handle.entry_);
+		return __data->value(__data->getNodes()[handle.node_]);
+	}
+	
+	void TNodeEntry::TSnapshot::insert(Int32 index, const std::shared_ptr<TNodeData>& data)
+	{
+		entries_.insert({ index, data });
+		const auto& __nodes = data->getNodes();
+		for (TSize __position {}; __position < __nodes.size(); ++__position)
+		{
+			const auto& __node = __nodes[__position];
+			const TNodeHandle __handle { index, static_cast<UInt32>(__position) };
+			const auto __id = __node.key_.id();
+			if (__id >= keyIndex_.size())
+				keyIndex_.resize(__id + 1);
+			keyIndex_[__id].push_back(__handle);
+			nameIndex_.emplace(data->name(__node), __node.key_);
+			valueIndex_[TString(data->value(__node))].push_back(__handle);
+		}
+	}
+	
+	void TNodeEntry::TSnapshot::updateValue(const TNodeHandle& handle, TStringView value)
+	{
+		if (this->value(handle) == value)
+			return;
+		
+		unindexValue(handle);
+		
+		// published data is shared with readers, so a copy is changed, unless
+		// this draft already made one and is its only owner; copy leaves out
+		// values replaced before
+		auto& __data = entries_.at(handle.entry_);
+		if (__data.use_count() != 1)
+			__data = std::make_shared<TNodeData>(*__data);
+		__data->setValue(handle.node_, value);
+		
+		indexValue(handle);
+	}
+	
+	void TNodeEntry::TSnapshot::indexValue(const TNodeHandle& handle)
+	{
+		valueIndex_[TString(value(handle))].push_back(handle);
+	}
+	
+	void TNodeEntry::TSnapshot::unindexValue(const TNodeHandle& handle)
+	{
+		auto __handles = valueIndex_.find(TString(value(handle)));
+		if (__handles == valueIndex_.end())
+			return;
+		
+		auto& __list = __handles->second;
+		__list.erase(std::remove_if(__list.begin(), __list.end(),
+									[ &handle ](const TNodeHandle& other)
+									{ return other.entry_ == handle.entry_ and other.node_ == handle.node_; }),
+					 __list.end());
+		if (__list.empty())
+			valueIndex_.erase(__handles);
+	}
+	
 	// TNodeEntry implementation
 	TNodeEntry::TNodeEntry(TNodeEntry::EException throws) noexcept
 			: m_index(),
 			  m_throw(throws),
-			  m_nodeEntries(TEntryMap {})
+			  m_snapshot(std::make_shared<const TSnapshot>())
 	{ }
 	
 	TNodeEntry::~TNodeEntry() noexcept
@@ -29,52 +159,107 @@ namespace Dixter
 	
 	bool TNodeEntry::insertEntry(TNodeData* nodeEntry)
 	{
-		TDefaultLockGuard l(m_mutex);
-		if (m_nodeEntries.find(m_index) == m_nodeEntries.end())
+		return insertEntries({ nodeEntry });
+	}
+	
+	bool TNodeEntry::insertEntries(const std::vector<TNodeData*>& nodeEntries)
+	{
+		// owned from here on, so they are released if nothing is inserted
+		std::vector<std::unique_ptr<TNodeData>> __entries;
+		__entries.reserve(nodeEntries.size());
+		for (auto __nodeEntry : nodeEntries)
+			__entries.emplace_back(__nodeEntry);
+		
+		TDefaultLockGuard l(m_writeMutex);
+		auto __draft = draft();
+		const auto __first = m_index;
+		for (Int32 __index = __first; __index < __first + static_cast<Int32>(__entries.size()); ++__index)
+			if (__draft->entries_.find(__index) != __draft->entries_.end())
+				return false;
+		
+		auto __index = __first;
+		for (auto& __entry : __entries)
+			__draft->insert(__index++, std::shared_ptr<TNodeData>(std::move(__entry)));
+		
+		publish(std::move(__draft));
+		m_index = __index;
+		return true;
+	}
+	
+	template<typename TKey>
+	bool TNodeEntry::updateEntries(const TKey& key, const TU8String& value)
+	{
+		TDefaultLockGuard l(m_writeMutex);
+		auto __draft = draft();
+		auto __handles = __draft->handles(key);
+		if (not __handles)
 		{
-			m_nodeEntries.insert({ m_index, std::shared_ptr<TNodeData>(nodeEntry) });
-			++m_index;
-			return true;
+			if (m_throw == EException::Throw)
+				throw TNotFoundException(
+						"%s:%d Node data for name \"%s\" not found.", __FILE__, __LINE__, keyPath(key));
+			return false;
 		}
-		return false;
+		
+		const auto& __value = value.asUTF8();
+		for (const auto& __handle : *__handles)
+			__draft->updateValue(__handle, __value);
+		
+		publish(std::move(__draft));
+		return true;
 	}
 	
-	bool TNodeEntry::setEntry(const TString& key, const TUString& value)
+	template<typename TKey>
+	TU8String TNodeEntry::find(const TKey& key) const
 	{
-		TDefaultLockGuard l(m_mutex);
-		bool __found { checkKey(key) };
-		if (__found)
+		const auto __snapshot = snapshot();
+		auto __handle = __snapshot->lookup(key);
+		
+		if (not __handle)
 		{
-			for (auto& __valuePair : m_nodeEntries)
-				for (auto& __node : __valuePair.second->getNodes())
-					if (__node->m_name.compare(key) == 0)
-						__node->m_value = value;
+			if (m_throw == EException::Throw)
+				throw TNotFoundException(
+						"%s:%d Node data for \"%s\" not found.", __FILE__, __LINE__, keyPath(key));
+			return TU8String();
 		}
-		else if (m_throw == EException::Throw)
-			throw TNotFoundException(
-					"%s:%d Node data for name \"%s\" not found.", __FILE__, __LINE__, key);
 		
-		return __found;
+		return TU8String(__snapshot->value(*__handle));
 	}
 	
-	bool TNodeEntry::setEntry(TSize index, const TUString& value)
+	bool TNodeEntry::setEntry(const TString& key, const TU8String& value)
 	{
-		TDefaultLockGuard l(m_mutex);
-		if (checkIndex(index))
+		return updateEntries(key, value);
+	}
+	
+	bool TNodeEntry::setEntry(const TKeyHandle& key, const TU8String& value)
+	{
+		return updateEntries(key, value);
+	}
+	
+	bool TNodeEntry::setEntry(TSize index, const TU8String& value)
+	{
+		TDefaultLockGuard l(m_writeMutex);
+		auto __draft = draft();
+		if (__draft->entries_.find(static_cast<Int32>(index)) == __draft->entries_.end())
+			return false;
+		
+		const auto& __value = value.asUTF8();
+		auto __source = __draft->lookupValue(__value);
+		if (not __source)
 		{
-			auto iter = m_nodeEntries.find(index);
-			auto& __nodes = iter->second->getNodes();
-			const auto& __nodeName = findEntry(value)->m_name;
-			
-			auto __f_pred = [ &__nodeName ](std::shared_ptr<TNode>& node)
-			{ return node->m_name.compare(__nodeName) == 0; };
-			
-			std::replace_if(
-					__nodes.begin(), __nodes.end(),
-					__f_pred, dxMAKE_SHARED(TNode, __nodeName, value));
-			return true;
+			if (m_throw == EException::Throw)
+				throw TNotFoundException(
+						"%s:%d Node data for \"%s\" not found.", __FILE__, __LINE__, __value);
+			return false;
 		}
-		return false;
+		
+		// copied, as updating value moves handles of value index
+		const TKeyHandle __key(__draft->node(*__source).key_);
+		for (const auto& __handle : *__draft->handles(__key))
+			if (__handle.entry_ == static_cast<Int32>(index))
+				__draft->updateValue(__handle, __value);
+		
+		publish(std::move(__draft));
+		return true;
 	}
 	
 	bool TNodeEntry::removeEntry()
@@ -82,110 +267,87 @@ namespace Dixter
 		return false;
 	}
 	
-	std::shared_ptr<const TNode>
-	TNodeEntry::findEntry(const TString& key) const
+	TU8String TNodeEntry::findValue(const TString& key) const
 	{
-		TDefaultLockGuard l(m_mutex);
-		std::shared_ptr<TNode> __data {};
-		for (const auto& __valuePair : m_nodeEntries)
-			for (std::shared_ptr<TNode>& __node : __valuePair.second->getNodes())
-				if (__node->m_name.compare(key) == 0)
-					__data = __node;
-		
-		if (m_throw == EException::Throw)
-			if (not __data)
-				throw TNotFoundException(
-						"%s:%d Node data for \"%s\" not found.", __FILE__, __LINE__, key);
-		
-		return __data;
+		return find(key);
 	}
 	
-	std::shared_ptr<const TNode>
-	TNodeEntry::findEntry(const TUString& value) const
+	TU8String TNodeEntry::findValue(const TKeyHandle& key) const
 	{
-		TDefaultLockGuard __lg(m_mutex);
-		std::shared_ptr<TNode> __data;
-		for (const auto& __valuePair : m_nodeEntries)
-		{
-			for (auto& __node : __valuePair.second->getNodes())
-				if (__node->m_value.compare(value) == 0)
-					__data = __node;
-		}
-		if (m_throw == EException::Throw)
-			if (not __data)
-				throw TNotFoundException(
-						"%s:%d Node data for \"%s\" not found.", __FILE__, __LINE__, value.asUTF8());
-		
-		return __data;
+		return find(key);
 	}
 	
-	std::shared_ptr<const TNodeData>
-	TNodeEntry::findEntryData(Int32 index) const
+	void TNodeEntry::select(TRecordSet& records) const
 	{
-		TDefaultLockGuard __lg(m_mutex);
-		std::shared_ptr<const TNodeData> __data;
-		if (index > 0)
+		const auto __snapshot = snapshot();
+		records.keep(__snapshot);
+		for (const auto& __data : __snapshot->entries_)
 		{
-			if (checkIndex(static_cast<TSize>(index)))
+			const auto __row = records.appendRow();
+			for (const auto& __node : __data.second->getNodes())
 			{
-				for (const auto& __p : m_nodeEntries)
-				{
-					if (__p.first == index)
-						__data = __p.second;
-				}
+				const auto __column = records.column(__node.key_);
+				// first node with name wins, as in TNodeData::getValue
+				if (__column >= 0 and not records.has(__row, static_cast<TSize>(__column)))
+					records.setCell(__row, static_cast<TSize>(__column), __data.second->value(__node));
 			}
 		}
+	}
+	
+	std::shared_ptr<const TNodeData>
+	TNodeEntry::findEntryData(Int32 index) const
+	{
+		const auto __snapshot = snapshot();
+		auto __data = __snapshot->entries_.find(index);
 		
-		if (m_throw == EException::Throw)
-			if (not __data)
+		if (__data == __snapshot->entries_.end())
+		{
+			if (m_throw == EException::Throw)
 				throw TNotFoundException("%s:%d Node data for index \'%d\' not found.", __FILE__, __LINE__, index);
+			return nullptr;
+		}
 		
-		return __data;
+		return __data->second;
 	}
 	
 	Int32 TNodeEntry::findEntryIndex(const TString& key) const
 	{
-		Int32 __index { -1 };
-		for (const auto& __p : m_nodeEntries)
-			for (const auto& __node : __p.second->getNodes())
-				if (not __node->m_name.compare(key))
-					__index = __p.first;
-		
-		return __index;
+		const auto __snapshot = snapshot();
+		auto __handle = __snapshot->lookup(key);
+		return __handle ? __handle->entry_ : -1;
 	}
 	
-	bool TNodeEntry::checkKey(const TString& key) const
+	Int32 TNodeEntry::findEntryIndex(const TU8String& value) const
 	{
-		bool __found(false);
-		if (not key.empty())
-		{
-			try
-			{
-				if (findEntry(key) != nullptr)
-					__found = true;
-			}
-			catch (std::exception& e)
-			{
-				__found = false;
-				printerr(e.what())
-			}
-		}
-		else
-			__found = false;
+		const auto __snapshot = snapshot();
+		auto __handles = __snapshot->valueIndex_.find(value.asUTF8());
+		if (__handles == __snapshot->valueIndex_.end())
+			return -1;
 		
-		return __found;
+		// handles are reordered by updates, first data is the one with lowest index
+		return std::min_element(__handles->second.begin(), __handles->second.end(),
+								[](const TNodeHandle& left, const TNodeHandle& right)
+								{ return left.entry_ < right.entry_; })->entry_;
 	}
 	
-	bool TNodeEntry::checkIndex(TSize index) const
+	bool TNodeEntry::hasEntry(const TString& key) const
 	{
-		if (index >= std::numeric_limits<TSize>::min() and index <= std::numeric_limits<TSize>::max())
-		{
-			if (index <= m_nodeEntries.size())
-			{
-				if (m_nodeEntries.find(index) != m_nodeEntries.end())
-					return true;
-			}
-		}
-		return false;
+		return snapshot()->lookup(key) != nullptr;
+	}
+	
+	bool TNodeEntry::hasEntry(const TKeyHandle& key) const
+	{
+		return snapshot()->lookup(key) != nullptr;
+	}
+	
+	std::shared_ptr<TNodeEntry::TSnapshot>
+	TNodeEntry::draft() const
+	{
+		return std::make_shared<TSnapshot>(*snapshot());
+	}
+	
+	void TNodeEntry::publish(std::shared_ptr<TSnapshot> snapshot) noexcept
+	{
+		std::atomic_store(&m_snapshot, TSnapshotPtr(std::move(snapshot)));
 	}
 } // namespace Dixter
\ No newline at end of file
@@ -10,11 +10,15 @@
 
 #include <map>
 #include <mutex>
+#include <memory>
+#include <vector>
 #include <algorithm>
+#include <unordered_map>
 
 #include "Types.hpp"
 #include "NodeData.hpp"
-#include "MethodCallback.hpp"
+#include "RecordSet.hpp"
+#include "ThreadPool.hpp"
 
 namespace Dixter
 {
@@ -25,6 +29,14 @@ namespace Dixter
 	 *
 	 * Stores data read from configuration reader/writer in an
 	 * indexed map, to simplify data access.
+	 * Nodes are also indexed by value in hash map and by compiled
+	 * name in array, see TKeyHandle.
+	 *
+	 * Data and indexes are published as immutable snapshot. Readers load
+	 * current snapshot without locking, writers copy it, apply changes to the
+	 * copy and swap it in, so a write never blocks running lookups. Changed
+	 * nodes and their data are copied as well, other nodes are shared
+	 * between snapshots.
 	 * */
 	class TNodeEntry final
 	{
@@ -32,6 +44,72 @@ namespace Dixter
 		using TEntryMap = std::map<Int32, std::shared_ptr<TNodeData>>;
 		using TIterator = TEntryMap::iterator;
 		using TConstIterator = TEntryMap::const_iterator;
+		
+		/**
+		 * Node by index of data it belongs to and its position there
+		 * */
+		struct TNodeHandle
+		{
+			Int32 entry_;
+			
+			UInt32 node_;
+		};
+		
+		/// Handles in order of insertion
+		using THandleList = std::vector<TNodeHandle>;
+		/// Handles by id of compiled name
+		using TKeyIndex = std::vector<THandleList>;
+		using TNameIndex = std::unordered_map<TString, TKeyHandle>;
+		/// Handles by UTF-8 value
+		using TValueIndex = std::unordered_map<TString, THandleList>;
+		
+		/**
+		 * Immutable state of entry, once published.
+		 * */
+		struct TSnapshot
+		{
+			/// Last inserted node with name
+			const TNodeHandle* lookup(const TString& key) const;
+			
+			const TNodeHandle* lookup(const TKeyHandle& key) const;
+			
+			/// Nodes with name or null
+			const THandleList* handles(const TString& key) const;
+			
+			const THandleList* handles(const TKeyHandle& key) const;
+			
+			THandleList* handles(const TString& key);
+			
+			THandleList* handles(const TKeyHandle& key);
+			
+			/// Last inserted node with UTF-8 value
+			const TNodeHandle* lookupValue(TStringView value) const;
+			
+			/// Node record of handle
+			const TNodeData::TNode& node(const TNodeHandle& handle) const;
+			
+			TStringView value(const TNodeHandle& handle) const;
+			
+			void insert(Int32 index, const std::shared_ptr<TNodeData>& data);
+			
+			/// Replaces data of node by copy holding new value
+			void updateValue(const TNodeHandle& handle, TStringView value);
+			
+			void indexValue(const TNodeHandle& handle);
+			
+			void unindexValue(const TNodeHandle& handle);
+			
+			TEntryMap entries_;
+			
+			TKeyIndex keyIndex_;
+			
+			/// Compiled names of nodes, so lookups by name don't intern
+			TNameIndex nameIndex_;
+			
+			TValueIndex valueIndex_;
+		};
+		
+		using TSnapshotPtr = std::shared_ptr<const TSnapshot>;
 	public:
 		/**
 		 * \namespace Dixter
@@ -61,9 +139,19 @@ namespace Dixter
 		 * */
 		bool insertEntry(TNodeData* nodeEntry);
 		
-		bool setEntry(const TString& key, const TUString& value);
+		/**
+		 * \class NodeEntry
+		 * \brief Inserts data entries publishing them at once.
+		 * \param nodeEntries Entries to insert, owned by NodeEntry afterwards.
+		 * \returns true if data was inserted, false otherwise.
+		 * */
+		bool insertEntries(const std::vector<TNodeData*>& nodeEntries);
+		
+		bool setEntry(const TString& key, const TU8String& value);
 		
-		bool setEntry(TSize index, const TUString& value);
+		bool setEntry(const TKeyHandle& key, const TU8String& value);
+		
+		bool setEntry(TSize index, const TU8String& value);
 		
 		/**
 		 * \class NodeEntry
@@ -74,28 +162,28 @@ namespace Dixter
 		
 		/**
 		 * \class NodeEntry
-		 * \brief Find matching entry by node name.
+		 * \brief Find value of matching entry by node name.
 		 * \param key Node name as a key to find corresponding node.
-		 * \returns Node.
+		 * \returns Value of node.
 		 *
 		 * Depending on \c m_throw value throws exception if node
-		 * haven't found else returns null.
+		 * haven't found else returns empty value.
 		 * */
-		std::shared_ptr<const TNode>
-		findEntry(const TString& key) const;
+		TU8String findValue(const TString& key) const;
 		
 		/**
 		 * \class NodeEntry
-		 * \brief Find matching entry by node value.
-		 * \param value Node value as a key to find corresponding
-		 * node.
-		 * \returns Node.
-		 *
-		 * Depending on \c m_throw value throws exception if node
-		 * haven't found else returns null.
+		 * \brief Find value of matching entry by compiled node name.
+		 * */
+		TU8String findValue(const TKeyHandle& key) const;
+		
+		/**
+		 * \class NodeEntry
+		 * \brief Appends row with requested fields of every data entry,
+		 * in a single pass over current snapshot.
+		 * \param records Record set with fields to select.
 		 * */
-		std::shared_ptr<const TNode>
-		findEntry(const TUString& value) const;
+		void select(TRecordSet& records) const;
 		
 		/**
 		 * \class NodeEntry
@@ -109,8 +197,28 @@ namespace Dixter
 		std::shared_ptr<const TNodeData>
 		findEntryData(Int32 index) const;
 		
+		/**
+		 * \class NodeEntry
+		 * \brief Find index of data holding node with name.
+		 * \returns Index of data or -1 if not found.
+		 * */
 		Int32 findEntryIndex(const TString& key) const;
 		
+		/**
+		 * \class NodeEntry
+		 * \brief Find index of first data holding node with value.
+		 * \returns Index of data or -1 if not found.
+		 * */
+		Int32 findEntryIndex(const TU8String& value) const;
+		
+		/**
+		 * \class NodeEntry
+		 * \brief Check if node with name exists. Never throws.
+		 * */
+		bool hasEntry(const TString& key) const;
+		
+		bool hasEntry(const TKeyHandle& key) const;
+		
 		/**
 		 * \class NodeEntry
 		 * \brief Get number of data stored in NodeEntry.
@@ -120,8 +228,15 @@ namespace Dixter
 		
 		/**
 		 * \class NodeEntry
-		 * \brief Calls NodeData methods on stored data
-		 * with arguments.
+		 * \brief Current state of entry. Never blocks.
+		 * \returns Snapshot which stays unchanged as long as it's held.
+		 * */
+		TSnapshotPtr snapshot() const noexcept;
+		
+		/**
+		 * \class NodeEntry
+		 * \brief Calls NodeData methods on data
+		 * of current snapshot with arguments.
 		 * \tparam TReturn Return type of NodeData method.
 		 * \tparam TArgs Argument types for NodeData method.
 		 * \param method NodeData method to call.
@@ -131,26 +246,42 @@ namespace Dixter
 				typename TReturn,
 				typename... TArgs
 		>
-		void forEach(TReturn(TNodeData::*method)(TArgs...), TArgs... args);
-		
-		TIterator begin();
-		
-		TIterator end();
-		
-		TConstIterator cbegin();
+		void forEach(TReturn(TNodeData::*method)(TArgs...) const, TArgs... args) const;
 		
-		TConstIterator cend();
+		/**
+		 * \class NodeEntry
+		 * \brief Calls NodeData methods on data of current snapshot with execution policy.
+		 * \param policy With EExecution::Parallel, data is split in chunks run on
+		 * shared thread pool, unless there are only a few of them.
+		 *
+		 * Data of snapshot is immutable, so parallel call only requires method
+		 * to be safe with arguments shared by all calls, like writing results
+		 * to per-data slots or through synchronised sinks.
+		 * */
+		template<
+				typename TReturn,
+				typename... TArgs
+		>
+		void forEach(EExecution policy, TReturn(TNodeData::*method)(TArgs...) const, TArgs... args) const;
 	
 	private:
-		bool checkKey(const TString& key) const;
+		/// Copy of current snapshot to apply changes to. Expects m_writeMutex to be held
+		std::shared_ptr<TSnapshot> draft() const;
 		
-		bool checkIndex(TSize index) const;
+		void publish(std::shared_ptr<TSnapshot> snapshot) noexcept;
+		
+		template<typename TKey>
+		bool updateEntries(const TKey& key, const TU8String& value);
+		
+		template<typename TKey>
+		TU8String find(const TKey& key) const;
 	
 	private:
 		Int32 m_index;
 		EException m_throw;
-		TEntryMap m_nodeEntries;
-		mutable std::mutex m_mutex;
+		TSnapshotPtr m_snapshot;
+		/// Serialises writers only
+		std::mutex m_writeMutex;
 	};
 }
 
@@ -158,44 +289,49 @@ namespace Dixter
 {
 	inline TSize TNodeEntry::getSize() const
 	{
-		return m_nodeEntries.size();
-	}
-	
-	inline TNodeEntry::TIterator
-	TNodeEntry::begin()
-	{
-		return m_nodeEntries.begin();
-	}
-	
-	inline TNodeEntry::TIterator
-	TNodeEntry::end()
-	{
-		return m_nodeEntries.end();
+		return snapshot()->entries_.size();
 	}
 	
-	inline TNodeEntry::TConstIterator
-	TNodeEntry::cbegin()
+	inline TNodeEntry::TSnapshotPtr
+	TNodeEntry::snapshot() const noexcept
 	{
-		return m_nodeEntries.cbegin();
+		return std::atomic_load(&m_snapshot);
 	}
 	
-	inline TNodeEntry::TConstIterator
-	TNodeEntry::cend()
+	template<typename TReturn, typename... TArgs>
+	void TNodeEntry::forEach(TReturn(TNodeData::*method)(TArgs... args) const,
+							 TArgs... args) const
 	{
-		return m_nodeEntries.cend();
+		const auto __snapshot = snapshot();
+		for (const auto& [__index, __data] : __snapshot->entries_)
+			if (__data)
+				( ( *__data ).*method )(args...);
 	}
 	
 	template<typename TReturn, typename... TArgs>
-	void TNodeEntry::forEach(TReturn(TNodeData::*method)(TArgs... args),
-							 TArgs... args)
+	void TNodeEntry::forEach(EExecution policy, TReturn(TNodeData::*method)(TArgs... args) const,
+							 TArgs... args) const
 	{
-		auto __methodCallback = TMethodCallback<TNodeData, TReturn, TArgs...>(method);
-		std::for_each(
-				m_nodeEntries.begin(), m_nodeEntries.end(),
-				[ &__methodCallback, &args... ](TNodeEntry::TEntryMap::value_type& pair)
+		const auto __snapshot = snapshot();
+		if (policy == EExecution::Sequenced or __snapshot->entries_.size() <= TThreadPool::kSequentialLimit)
+		{
+			for (const auto& [__index, __data] : __snapshot->entries_)
+				if (__data)
+					( ( *__data ).*method )(args...);
+			return;
+		}
+		
+		std::vector<const TNodeData*> __entries;
+		__entries.reserve(__snapshot->entries_.size());
+		for (const auto& [__index, __data] : __snapshot->entries_)
+			if (__data)
+				__entries.push_back(__data.get());
+		
+		TThreadPool::shared().parallelFor(
+				__entries.size(), [ & ](TSize begin, TSize end)
 				{
-					if (pair.second)
-						__methodCallback(pair.second, args...);
+					for (auto __index = begin; __index < end; ++__index)
+						( __entries[__index]->*method )(args...);
 				});
 	}
 } // namespace Dixter
\ No newline at end of file
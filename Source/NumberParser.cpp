@@ -0,0 +1,22 @@
+/**
+ *  Copyright (C) 2015-2019
+ *  Author Alvin Ahmadov <alvin.dev.ahmadov@gmail.com>
+ *
+ *  This file is part of Dixter
+ *  License-Identifier: MIT License
+ *  See README.md for more information.
+ */
+
+#include "NumberParser.hpp"
+#include "Exception.hpp"
+
+namespace Dixter
+{
+	void throwParseError(const TParseResult& result, const std::string& text)
+	{
+		if (result.error_ == std::errc::result_out_of_range)
+			throw TRangeException("%s:%d Number \"%s\" is out of range.", __FILE__, __LINE__, text);
+		
+		throw TParseException("%s:%d No number in \"%s\".", __FILE__, __LINE__, text);
+	}
+} // namespace Dixter
@@ -0,0 +1,123 @@
+/**
+ *  Copyright (C) 2015-2019
+ *  Author Alvin Ahmadov <alvin.dev.ahmadov@gmail.com>
+ *
+ *  This file is part of Dixter
+ *  License-Identifier: MIT License
+ *  See README.md for more information.
+ */
+#pragma once
+
+#include <charconv>
+#include <cstddef>
+#include <string>
+#include <system_error>
+#include <type_traits>
+
+namespace Dixter
+{
+	/**
+	 * \brief Outcome of parsing number, like std::from_chars_result
+	 * with position of first unparsed unit instead of pointer.
+	 * */
+	struct TParseResult
+	{
+		std::size_t position_;
+		
+		/// std::errc::invalid_argument if there is no number, result_out_of_range if it doesn't fit
+		std::errc error_;
+		
+		explicit operator bool() const noexcept
+		{
+			return error_ == std::errc();
+		}
+	};
+	
+	namespace NInternal
+	{
+		/// Longest number parsed from UTF-16, digits past it make result out of range
+		constexpr std::size_t kMaxNumberLength = 128;
+		
+		template<typename TChar>
+		inline bool isSpace(TChar unit) noexcept
+		{
+			return unit == ' ' or ( unit >= '\t' and unit <= '\r' );
+		}
+		
+		template<typename TNumber>
+		inline std::from_chars_result fromChars(const char* first, const char* last, TNumber& value, int base) noexcept
+		{
+			if constexpr (std::is_floating_point_v<TNumber>)
+			{
+				(void) base;
+				return std::from_chars(first, last, value);
+			}
+			else
+				return std::from_chars(first, last, value, base);
+		}
+	} // namespace NInternal
+	
+	/**
+	 * \brief Parses number at start of UTF-8 string without allocating or throwing.
+	 *
+	 * Like std::stoi and the rest, leading whitespace and plus sign are
+	 * skipped and characters after number are ignored. Unlike them,
+	 * unsigned types don't take negative numbers.
+	 * \param base Base of integers, ignored for floating point types.
+	 * */
+	template<typename TNumber>
+	TParseResult parseNumber(const char* first, const char* last, TNumber& value, int base = 10) noexcept
+	{
+		static_assert(std::is_arithmetic_v<TNumber>, "Only numbers can be parsed.");
+		
+		auto __position = first;
+		while (__position != last and NInternal::isSpace(*__position))
+			++__position;
+		if (__position != last and *__position == '+')
+		{
+			// sign is taken once
+			if (++__position != last and *__position == '-')
+				return { 0, std::errc::invalid_argument };
+		}
+		
+		const auto __result = NInternal::fromChars(__position, last, value, base);
+		if (__result.ec != std::errc())
+			return { 0, __result.ec };
+		return { static_cast<std::size_t>(__result.ptr - first), std::errc() };
+	}
+	
+	/**
+	 * \brief Parses number at start of UTF-16 string without allocating or throwing.
+	 *
+	 * Number is read from ASCII units copied to stack, see kMaxNumberLength.
+	 * */
+	template<typename TNumber>
+	TParseResult parseNumber(const char16_t* first, const char16_t* last, TNumber& value, int base = 10) noexcept
+	{
+		auto __position = first;
+		while (__position != last and NInternal::isSpace(*__position))
+			++__position;
+		
+		char __digits[NInternal::kMaxNumberLength];
+		std::size_t __length {};
+		while (__length < NInternal::kMaxNumberLength and __position + __length != last
+			   and __position[__length] < 0x80)
+		{
+			__digits[__length] = static_cast<char>(__position[__length]);
+			++__length;
+		}
+		
+		auto __result = parseNumber(__digits, __digits + __length, value, base);
+		if (__result and __result.position_ == NInternal::kMaxNumberLength)
+			return { 0, std::errc::result_out_of_range };
+		if (__result)
+			__result.position_ += static_cast<std::size_t>(__position - first);
+		return __result;
+	}
+	
+	/**
+	 * \brief Reports failed parse of text as TParseException, or as TRangeException
+	 * if number was out of range.
+	 * */
+	[[noreturn]] void throwParseError(const TParseResult& result, const std::string& text);
+} // namespace Dixter
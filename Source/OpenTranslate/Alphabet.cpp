@@ -14,47 +14,44 @@ namespace Dixter
 {
 	namespace OpenTranslate
 	{
-		Alphabet::Alphabet(const string_t& languageName, const code_point_t* codePoints)
+		Alphabet::Alphabet(const TString& languageName, const Unicode::TAlphabet& alphabet)
 				: m_lang { languageName },
-				  m_pCodePoints { codePoints }
+				  m_alphabet { &alphabet }
 		{ }
 		
 		Alphabet::~Alphabet()
 		{ }
 		
-		bool Alphabet::contains(const string_t& languageName)
+		bool Alphabet::contains(TCodePoint codePoint) const noexcept
 		{
-			return ((m_lang == languageName) && (!m_lang.compare(languageName)));
+			return m_alphabet->contains(codePoint);
 		}
 		
-		const string_t&
+		const TString&
 		Alphabet::getLanguageName() const
 		{
 			return m_lang;
 		}
 		
-		const code_point_t*
-		Alphabet::getCodePoints()
+		const TCodePoint*
+		Alphabet::getCodePoints() const
 		{
-			return m_pCodePoints;
+			return m_alphabet->getCodePoints();
 		}
 		
 		size_t Alphabet::getSize() const
 		{
-			size_t index { };
-			while (m_pCodePoints[++index] != '\0')
-			{ }
-			return index;
+			return m_alphabet->getSize();
 		}
 		
-		bool Alphabet::operator==(const Alphabet& othr)
+		bool Alphabet::operator==(const Alphabet& other) const
 		{
-			return (m_lang.compare(othr.m_lang) && m_pCodePoints == othr.m_pCodePoints);
+			return m_alphabet == other.m_alphabet and m_lang == other.m_lang;
 		}
 		
-		bool Alphabet::operator!=(const Alphabet& othr)
+		bool Alphabet::operator!=(const Alphabet& other) const
 		{
-			return !operator==(othr);
+			return !operator==(other);
 		}
 	}
-}
\ No newline at end of file
+}
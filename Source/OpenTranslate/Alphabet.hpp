@@ -6,7 +6,7 @@
  *  License-Identifier: MIT License
  *  See README.md for more information.
  */
- 
+
 #pragma once
 
 
@@ -17,29 +17,35 @@ namespace Dixter
 {
 	namespace OpenTranslate
 	{
+		/**
+		 * \brief Alphabet of compiled database under name of language.
+		 * */
 		class Alphabet
 		{
 		public:
-			Alphabet(const string_t& languageName, const code_point_t* codePoints);
+			Alphabet(const TString& languageName, const Unicode::TAlphabet& alphabet);
 			
 			~Alphabet();
 			
-			bool contains(const string_t& languageName);
+			/**
+			 * \brief Checks if code point is a letter of alphabet, in constant time.
+			 * */
+			bool contains(TCodePoint codePoint) const noexcept;
 			
-			const string_t& getLanguageName() const;
+			const TString& getLanguageName() const;
 			
-			const code_point_t* getCodePoints();
+			const TCodePoint* getCodePoints() const;
 			
 			size_t getSize() const;
 			
-			bool operator==(const Alphabet& other);
+			bool operator==(const Alphabet& other) const;
 			
-			bool operator!=(const Alphabet& othr);
+			bool operator!=(const Alphabet& other) const;
 		
 		private:
-			string_t m_lang;
+			TString m_lang;
 			
-			const code_point_t* m_pCodePoints;
+			const Unicode::TAlphabet* m_alphabet;
 		};
 	}
-}
\ No newline at end of file
+}
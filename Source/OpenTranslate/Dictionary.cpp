@@ -7,27 +7,79 @@
  *  See README.md for more information.
  */
 
+#include <cctype>
+#include <algorithm>
+
 #include <cppconn/resultset.h>
 #include <cppconn/exception.h>
 
 #include "Group.hpp"
 #include "Macros.hpp"
 #include "Constants.hpp"
+#include "Exception.hpp"
 #include "Dictionary.hpp"
 #include "JoinThread.hpp"
+#include "Transliterator.hpp"
+#include "Database/RowCursor.hpp"
+#include "Database/QueryBuilder.hpp"
 
 namespace Dixter
 {
 	namespace OpenTranslate
 	{
+		namespace
+		{
+			/// Append cells of first rowsNum rows to result, empty ones too, so columns stay parallel
+			void appendRows(const Database::TTextCursor& cursor, const std::vector<TString>& columns,
+							TSize rowsNum, TDictionary::TSearchResult& result)
+			{
+				// values of column, resolved on first row
+				std::vector<TDictionary::TSearchResult::mapped_type*> __results(columns.size(), nullptr);
+				
+				for (TSize __row { 0UL }; __row < rowsNum; ++__row)
+				{
+					for (TSize __i { 0UL }; __i < columns.size(); ++__i)
+					{
+						auto& __result = __results[__i];
+						if (not __result)
+						{
+							auto __pos = result.find(columns.at(__i));
+							if (__pos == result.end())
+								__pos = result.emplace(columns.at(__i), TDictionary::TSearchResult::mapped_type {});
+							__result = &__pos->second;
+						}
+						__result->emplace_back(cursor.at(__row, __i));
+					}
+				}
+			}
+			
+			/**
+			 * Tables are named by first byte of words they store, upper cased if it's ASCII,
+			 * so the key is taken from the word as it's looked up, after transliteration.
+			 * Non-ASCII lead byte is taken as it is, toupper is undefined for it.
+			 * */
+			TByte tableKey(TStringView word) noexcept
+			{
+				const auto __first = word.empty() ? 0 : static_cast<unsigned char>(word.front());
+				return static_cast<TByte>(__first < 0x80 ? std::toupper(__first) : __first);
+			}
+		} // anonymous namespace
+		
+		bool TDictionary::TPageToken::empty() const noexcept
+		{
+			return table_.empty();
+		}
+		
 		TDictionary::TDictionary(TDatabaseManagerPtr manager) noexcept
 				: m_resultMap(),
-				  m_databaseManager(manager)
+				  m_databaseManager(manager),
+				  m_transliterator(nullptr)
 		{ }
 		
 		TDictionary::TDictionary(TDictionary&& self) noexcept
 				: m_resultMap(std::move(self.m_resultMap)),
-				  m_databaseManager(std::move(self.m_databaseManager))
+				  m_databaseManager(std::move(self.m_databaseManager)),
+				  m_transliterator(self.m_transliterator.load())
 		{ }
 		
 		TDictionary&
@@ -36,21 +88,29 @@ namespace Dixter
 			return Utilities::
 			compareAssign(this, self, [&]() {
 				m_databaseManager = std::move(self.m_databaseManager);
+				m_transliterator = self.m_transliterator.load();
 			});
 		}
 		
+		void TDictionary::setTransliterator(const TTransliterator* transliterator) noexcept
+		{
+			m_transliterator = transliterator;
+		}
+		
 		const TDictionary::TSearchResult&
-		TDictionary::lookFor(TWord word, const TString& keyColumn, bool fullsearch) noexcept
+		TDictionary::lookFor(TWord word, const TString& keyColumn, bool fullsearch,
+							 const TProjection& projection) noexcept
 		{
 			if (not m_resultMap.empty())
 				m_resultMap.clear();
 			
-			auto __clause = fullsearch ? keyColumn + " LIKE \"" + word.data() + "%\""
-									   : keyColumn + "=\"" + word.data() + "\"";
 			try
 			{
-				const TByte __key = std::toupper(word[0]);
-				JoinThread jthread(&TDictionary::doSearch, this, __key, __clause);
+				const auto __word = this->queryFor(word);
+				const Database::TQueryBuilder __builder {};
+				auto __clause = fullsearch ? __builder.prefixClause(keyColumn, __word)
+										   : __builder.equalClause(keyColumn, __word);
+				JoinThread jthread(&TDictionary::doSearch, this, tableKey(__word), __clause, std::cref(projection));
 			}
 			catch (const std::exception& e)
 			{
@@ -60,47 +120,143 @@ namespace Dixter
 			return m_resultMap;
 		}
 		
-		void
-		TDictionary::doSearch(TByte key, TDatabaseManager::TClause clause)
+		TDictionary::TPage
+		TDictionary::lookForPage(TWord prefix, const TString& keyColumn, TSize limit,
+								 const TPageToken& after, const TProjection& projection) noexcept
 		{
+			TPage __page {};
+			if (prefix.empty() or not limit)
+				return __page;
+			
+			std::lock_guard<std::mutex> __lg(m_mutex);
 			try
 			{
-				auto __resultSetPtr = m_databaseManager->selectColumn(g_indexTable, g_indexColumn);
-				while (__resultSetPtr->next())
+				const auto __prefix = this->queryFor(prefix);
+				const auto __clause = Database::TQueryBuilder {}.prefixClause(keyColumn, __prefix);
+				const auto __tables = this->tablesFor(tableKey(__prefix));
+				
+				auto __table = __tables.cbegin();
+				if (not after.empty())
 				{
-					if (auto __key = __resultSetPtr->getString(1)[0];
-							__key == key)
+					if (after.prefix_ != prefix or after.keyColumn_ != keyColumn)
 					{
-						const TString table = __resultSetPtr->getString(1);
-						this->fetch(table, clause);
+						throw TIllegalArgumentException("%s:%d Page token of search for \"%s\" in %s is used for \"%s\" in %s.",
+														__FILE__, __LINE__, after.prefix_, after.keyColumn_,
+														TString(prefix), keyColumn);
 					}
+					
+					__table = std::find(__tables.cbegin(), __tables.cend(), after.table_);
+					if (__table == __tables.cend())
+						throw TNotFoundException("%s:%d Table %s of page token is gone.", __FILE__, __LINE__, after.table_);
+				}
+				
+				TStringPair __after { after.key_, after.id_ };
+				TSize __remaining(limit);
+				for (; __table != __tables.cend() and __remaining; ++__table)
+				{
+					__remaining -= this->fetchPage(*__table, __clause, projection, keyColumn,
+												   __after, __remaining, __page);
+					if (__page.hasMore_)
+						break;
+					__after = {};
+				}
+				
+				// Page is full at the end of a table, next one starts from its beginning
+				if (not __page.hasMore_)
+				{
+					__page.hasMore_ = __table != __tables.cend();
+					__page.next_ = __page.hasMore_ ? TPageToken { *__table, {}, {}, {}, {} } : TPageToken {};
+				}
+				if (__page.hasMore_)
+				{
+					__page.next_.prefix_ = TString(prefix);
+					__page.next_.keyColumn_ = keyColumn;
 				}
 			}
-			catch (sql::SQLException& e) { printerr(e.what()) }
+			catch (const std::exception& e)
+			{
+				printerr(e.what())
+			}
+			
+			return __page;
 		}
 		
-		void TDictionary::fetch(const TString& table, TDatabaseManager::TClause clause)
+		TString TDictionary::queryFor(TWord word) const
 		{
-			std::lock_guard<std::mutex> __lg(m_mutex);
-			auto __cols = m_databaseManager->getColumns(table);
-			auto __resultSetPtr = m_databaseManager->selectColumnsWhere(table, __cols, clause);
-			
-			while (__resultSetPtr->next())
+			const auto __transliterator = m_transliterator.load();
+			return __transliterator ? __transliterator->transliterate(word) : TString(word);
+		}
+		
+		std::vector<TString>
+		TDictionary::tablesFor(TByte key)
+		{
+			std::vector<TString> __tables {};
+			Database::TRowCursor<TString> __cursor(m_databaseManager->selectColumn(g_indexTable, g_indexColumn));
+			while (__cursor.fetch())
 			{
-				for (TSize __i { 0UL }; __i < __cols.size(); ++__i)
+				for (TSize __index {}; __index < __cursor.size(); ++__index)
 				{
-					auto&& __colValue = __resultSetPtr->getString(__i + 1);
-					
-					if (not __colValue.length())
-						break;
-					
-					if (auto __pos = m_resultMap.find(__cols.at(__i)); __pos != m_resultMap.end())
-						__pos->second.push_back(__colValue);
-					else
-						m_resultMap.emplace(__cols.at(__i), TSearchResult::mapped_type{ __colValue });
+					if (auto __table = __cursor.get<0>(__index); not __table.empty() and __table[0] == key)
+						__tables.emplace_back(__table);
 				}
 			}
+			
+			// index table has no order, pages rely on tables coming in the same one
+			std::sort(__tables.begin(), __tables.end());
+			return __tables;
 		}
 		
+		void
+		TDictionary::doSearch(TByte key, TDatabaseManager::TClause clause, const TProjection& projection)
+		{
+			try
+			{
+				for (const auto& __table : this->tablesFor(key))
+					this->fetch(__table, clause, projection);
+			}
+			catch (sql::SQLException& e) { printerr(e.what()) }
+		}
+		
+		void TDictionary::fetch(const TString& table, TDatabaseManager::TClause clause,
+								const TProjection& projection)
+		{
+			std::lock_guard<std::mutex> __lg(m_mutex);
+			const auto __cols = projection.empty() ? m_databaseManager->getColumns(table) : projection;
+			Database::TTextCursor __cursor(m_databaseManager->selectColumnsWhere(table, __cols, clause),
+										   __cols.size());
+			
+			while (__cursor.fetch())
+				appendRows(__cursor, __cols, __cursor.size(), m_resultMap);
+		}
+		
+		TSize TDictionary::fetchPage(const TString& table, TDatabaseManager::TClause clause,
+									 const TProjection& projection, const TString& keyColumn,
+									 const TStringPair& after, TSize limit, TPage& page)
+		{
+			const auto __cols = projection.empty() ? m_databaseManager->getColumns(table) : projection;
+			
+			// key and id close every row to make continuation token,
+			// one row over the limit tells whether table has more
+			auto __selected = __cols;
+			__selected.push_back(keyColumn);
+			__selected.push_back(g_idColumn);
+			Database::TTextCursor __cursor(
+					m_databaseManager->selectPage(table, __selected, clause, keyColumn, g_idColumn,
+												  after, static_cast<UInt32>(limit + 1)),
+					__selected.size(), limit + 1);
+			
+			if (not __cursor.fetch())
+				return 0;
+			
+			const TSize __rows(std::min(__cursor.size(), limit));
+			appendRows(__cursor, __cols, __rows, page.result_);
+			page.next_ = { table,
+						   TString(__cursor.at(__rows - 1, __cols.size())),
+						   TString(__cursor.at(__rows - 1, __cols.size() + 1)), {}, {} };
+			page.hasMore_ = __cursor.size() > limit;
+			
+			return __rows;
+		}
+	
 	} // namespace OpenTranslate
 } // namespace Dixter
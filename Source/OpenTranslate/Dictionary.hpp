@@ -8,6 +8,7 @@
  */
 #pragma once
 
+#include <atomic>
 #include <mutex>
 #include <deque>
 
@@ -24,6 +25,8 @@ namespace Dixter
 	
 	namespace OpenTranslate
 	{
+		class TTransliterator;
+		
 		inline TString toString(std::unordered_multimap<TString, std::vector<TString>>& resultMap)
 		{
 			std::ostringstream __oss{};
@@ -52,6 +55,36 @@ namespace Dixter
 		
 		public:
 			using TSearchResult = std::unordered_multimap<TString, std::vector<TString>>;
+			using TProjection   = std::vector<TString>;
+			
+			/**
+			 * Position of the last row of a page: table and key column and id values of the row,
+			 * with prefix and key column of the search it continues.
+			 * Empty token denotes the beginning of the first table.
+			 * */
+			struct TPageToken
+			{
+				bool empty() const noexcept;
+				
+				TString table_;
+				
+				TString key_;
+				
+				TString id_;
+				
+				TString prefix_;
+				
+				TString keyColumn_;
+			};
+			
+			struct TPage
+			{
+				TSearchResult result_;
+				
+				TPageToken next_;
+				
+				bool hasMore_;
+			};
 		
 		public:
 			explicit TDictionary(TDatabaseManagerPtr manager) noexcept;
@@ -62,19 +95,57 @@ namespace Dixter
 			
 			~TDictionary() noexcept = default;
 			
+			/**
+			 * Rewrite words with transliterator before looking them up, so that
+			 * words typed in Latin are found in tables of other scripts.
+			 * @param transliterator Transliterator outliving dictionary, null to look words up as typed
+			 * */
+			void setTransliterator(const TTransliterator* transliterator) noexcept;
+			
+			/**
+			 * Find word in the dictionary tables.
+			 * @param keyColumn Column compared with word
+			 * @param projection Columns to fetch, all columns of table if empty
+			 * */
 			const TSearchResult&
-			lookFor(TWord word, const TString& keyColumn, bool fullsearch = false) noexcept;
+			lookFor(TWord word, const TString& keyColumn, bool fullsearch = false,
+					const TProjection& projection = {}) noexcept;
+			
+			/**
+			 * Find words starting with prefix a page at a time. Rows are ordered by
+			 * key column within each table and read only up to the page limit.
+			 * Tokens of other searches and tokens of tables that are gone yield empty page.
+			 * @param limit Maximal number of rows in page
+			 * @param after Token of previous page, empty for the first page
+			 * */
+			TPage lookForPage(TWord prefix, const TString& keyColumn, TSize limit,
+							  const TPageToken& after = {}, const TProjection& projection = {}) noexcept;
 		
 		protected:
-			void doSearch(TByte key, TDatabaseManager::TClause clause);
+			/// Word as looked up in tables
+			TString queryFor(TWord word) const;
 			
-			void fetch(const TString& table, TDatabaseManager::TClause clause);
+			std::vector<TString> tablesFor(TByte key);
+			
+			void doSearch(TByte key, TDatabaseManager::TClause clause, const TProjection& projection);
+			
+			void fetch(const TString& table, TDatabaseManager::TClause clause, const TProjection& projection);
+			
+			/**
+			 * Fetch at most limit rows of table following after into page.
+			 * @returns Number of rows added to page
+			 * */
+			TSize fetchPage(const TString& table, TDatabaseManager::TClause clause,
+							const TProjection& projection, const TString& keyColumn,
+							const TStringPair& after, TSize limit, TPage& page);
 		
 		private:
 			TSearchResult m_resultMap;
 			
 			TDatabaseManagerPtr m_databaseManager;
 			
+			std::atomic<const TTransliterator*> m_transliterator;
+			
 			mutable std::mutex m_mutex;
 		};
 	} // namespace OpenTranslate
@@ -10,6 +10,7 @@
 
 #include "LanguageBook.hpp"
 #include "Macros.hpp"
+#include "Exception.hpp"
 
 
 namespace Dixter
@@ -17,48 +18,42 @@ namespace Dixter
 	namespace OpenTranslate
 	{
 		LanguageBook::LanguageBook()
-				: m_alphabets { },
-				  m_langdefs { Unicode::langdefs }
+				: m_alphabets { }
 		{ }
 		
 		LanguageBook::~LanguageBook()
-		{
-			for (auto& alpha : m_alphabets)
-				delete alpha;
-		}
+		{ }
 		
 		void LanguageBook::insert(const TString& language, const TString& id)
 		{
-			m_alphabets.push_back(new Alphabet(language, m_langdefs.find(id)->second));
+			const auto __alphabet = Unicode::findAlphabet(id);
+			if (not __alphabet)
+				throw TNotFoundException("%s:%d No alphabet for language id %s.", __FILE__, __LINE__, id);
+			
+			m_alphabets.insert_or_assign(language, Alphabet(language, *__alphabet));
 		}
 		
 		TUString
 		LanguageBook::getView(TString language)
 		{
 			TUString view { };
-			for (const auto& alpha : m_alphabets)
-			{
-				if (alpha->contains(language))
-				{
-					auto chrs = alpha->getCodePoints();
-					
-					for (TSize i = 0; i < alpha->getSize(); ++i)
-						view.append(chrs[i]);
-				}
-			}
+			const auto alpha = m_alphabets.find(language);
+			if (alpha != m_alphabets.end())
+				view.fromUTF32(reinterpret_cast<const UChar32*>(alpha->second.getCodePoints()),
+							   alpha->second.getSize());
 			return view;
 		}
 		
-		
 		const TCodePoint* LanguageBook::getView(TUString language)
 		{
-			for (const auto& alpha : m_alphabets)
-			{
-				if (alpha->contains(language.asUTF8()))
-				{
-					return alpha->getCodePoints();
-				}
-			}
+			const auto alpha = m_alphabets.find(language.asUTF8());
+			return alpha != m_alphabets.end() ? alpha->second.getCodePoints() : nullptr;
+		}
+		
+		bool LanguageBook::contains(const TString& language, TCodePoint codePoint) const
+		{
+			const auto alpha = m_alphabets.find(language);
+			return alpha != m_alphabets.end() and alpha->second.contains(codePoint);
 		}
 	}
 }
\ No newline at end of file
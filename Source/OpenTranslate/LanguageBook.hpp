@@ -10,6 +10,9 @@
 #pragma once
 
 
+#include <unordered_map>
+
+#include "Macros.hpp"
 #include "Alphabet.hpp"
 
 
@@ -25,16 +28,29 @@ namespace Dixter
 			
 			~LanguageBook();
 			
+			/**
+			 * \brief Adds alphabet with id under name of language.
+			 * \throws TNotFoundException if there is no alphabet with id.
+			 * */
 			void insert(const TString& language, const TString& id);
 			
+			/**
+			 * \returns Letters of language, empty if it wasn't added.
+			 * */
 			TUString getView(TString language);
 			
+			/**
+			 * \returns Zero terminated letters of language, null if it wasn't added.
+			 * */
 			const TCodePoint* getView(TUString language);
+			
+			/**
+			 * \brief Checks if code point is a letter of language, in constant time.
+			 * */
+			bool contains(const TString& language, TCodePoint codePoint) const;
 		
 		private:
-			std::list<Alphabet*> m_alphabets;
-			
-			std::map<TString, const TCodePoint*> m_langdefs;
+			std::unordered_map<TString, Alphabet> m_alphabets;
 		};
 	}
 }
@@ -0,0 +1,398 @@
+/**
+ *  Copyright (C) 2015-2019
+ *  Author Alvin Ahmadov <alvin.dev.ahmadov@gmail.com>
+ *
+ *  This file is part of Dixter Project
+ *  License-Identifier: MIT License
+ *  See README.md for more information.
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <mutex>
+
+#include <unicode/uchar.h>
+
+#include "Unicode.hpp"
+#include "Exception.hpp"
+#include "Transcoder.hpp"
+#include "Transliterator.hpp"
+
+namespace Dixter
+{
+	namespace OpenTranslate
+	{
+		namespace
+		{
+			enum : UInt8
+			{
+				kFromLatin  = 1,
+				kToLatin    = 2,
+				kBoth       = kFromLatin | kToLatin
+			};
+			
+			/// Letter of alphabet and its Latin spelling, lower case
+			struct TLetter
+			{
+				TStringView latin_;
+				
+				TStringView native_;
+				
+				UInt8 directions_;
+			};
+			
+			/*
+			 * Longer spellings need no particular order, longest match wins anyway.
+			 * Letters sharing spelling are read by the first one listed.
+			 */
+			constexpr TLetter kArmenian[] = {
+					{ "a",   "ա",  kBoth }, { "b",   "բ",  kBoth }, { "g",   "գ",  kBoth },
+					{ "d",   "դ",  kBoth }, { "e",   "ե",  kBoth }, { "z",   "զ",  kBoth },
+					{ "e'",  "է",  kBoth }, { "y'",  "ը",  kBoth }, { "t'",  "թ",  kBoth },
+					{ "zh",  "ժ",  kBoth }, { "i",   "ի",  kBoth }, { "l",   "լ",  kBoth },
+					{ "kh",  "խ",  kBoth }, { "ts",  "ծ",  kBoth }, { "k",   "կ",  kBoth },
+					{ "h",   "հ",  kBoth }, { "dz",  "ձ",  kBoth }, { "gh",  "ղ",  kBoth },
+					{ "ch",  "ճ",  kBoth }, { "m",   "մ",  kBoth }, { "y",   "յ",  kBoth },
+					{ "n",   "ն",  kBoth }, { "sh",  "շ",  kBoth }, { "u",   "ու", kBoth },
+					{ "o",   "ո",  kBoth }, { "ch'", "չ",  kBoth }, { "p",   "պ",  kBoth },
+					{ "j",   "ջ",  kBoth }, { "rr",  "ռ",  kBoth }, { "s",   "ս",  kBoth },
+					{ "v",   "վ",  kBoth }, { "t",   "տ",  kBoth }, { "r",   "ր",  kBoth },
+					{ "ts'", "ց",  kBoth }, { "w",   "ւ",  kBoth }, { "p'",  "փ",  kBoth },
+					{ "k'",  "ք",  kBoth }, { "ev",  "և",  kBoth }, { "o'",  "օ",  kBoth },
+					{ "f",   "ֆ",  kBoth }, { "x",   "խ",  kFromLatin }, { "c",   "ց",  kFromLatin },
+					{ "q",   "ք",  kFromLatin }
+			};
+			
+			constexpr TLetter kAzerbaijani[] = {
+					{ "ch", "ç", kBoth }, { "gh", "ğ", kBoth }, { "sh", "ş", kBoth },
+					{ "e",  "ə", kToLatin }, { "i",  "ı", kToLatin }, { "o",  "ö", kToLatin },
+					{ "u",  "ü", kToLatin }
+			};
+			
+			constexpr TLetter kRussian[] = {
+					{ "a",    "а", kBoth }, { "b",  "б", kBoth }, { "v",  "в", kBoth },
+					{ "g",    "г", kBoth }, { "d",  "д", kBoth }, { "e",  "е", kBoth },
+					{ "yo",   "ё", kBoth }, { "zh", "ж", kBoth }, { "z",  "з", kBoth },
+					{ "i",    "и", kBoth }, { "y",  "й", kBoth }, { "k",  "к", kBoth },
+					{ "l",    "л", kBoth }, { "m",  "м", kBoth }, { "n",  "н", kBoth },
+					{ "o",    "о", kBoth }, { "p",  "п", kBoth }, { "r",  "р", kBoth },
+					{ "s",    "с", kBoth }, { "t",  "т", kBoth }, { "u",  "у", kBoth },
+					{ "f",    "ф", kBoth }, { "kh", "х", kBoth }, { "ts", "ц", kBoth },
+					{ "ch",   "ч", kBoth }, { "sh", "ш", kBoth }, { "shch", "щ", kBoth },
+					{ "\"",   "ъ", kBoth }, { "y",  "ы", kToLatin }, { "'",  "ь", kBoth },
+					{ "e",    "э", kToLatin }, { "yu", "ю", kBoth }, { "ya", "я", kBoth },
+					{ "h",    "х", kFromLatin }, { "c",  "ц", kFromLatin }, { "j",  "й", kFromLatin },
+					{ "w",    "в", kFromLatin }, { "q",  "к", kFromLatin }
+			};
+			
+			struct TLanguage
+			{
+				TStringView id_;
+				
+				const TLetter* letters_;
+				
+				TSize size_;
+			};
+			
+			/// Sorted by id
+			constexpr TLanguage kLanguages[] = {
+					{ "am", kArmenian,    std::size(kArmenian) },
+					{ "az", kAzerbaijani, std::size(kAzerbaijani) },
+					{ "ru", kRussian,     std::size(kRussian) }
+			};
+			
+			const TLanguage* findLanguage(TStringView id) noexcept
+			{
+				const auto __language = std::lower_bound(std::begin(kLanguages), std::end(kLanguages), id,
+														 [](const TLanguage& language, TStringView id)
+														 { return language.id_ < id; });
+				return __language != std::end(kLanguages) and __language->id_ == id ? __language : nullptr;
+			}
+			
+			/// Case maps first code point, or all of them
+			std::string toUpper(TStringView text, bool firstOnly)
+			{
+				std::string __result;
+				const auto __end = text.data() + text.size();
+				for (auto __position = text.data(); __position != __end;)
+				{
+					TCodePoint __codePoint {};
+					__position += Unicode::decodeUtf8(__position, __end, __codePoint);
+					
+					const auto __upper = firstOnly ? u_totitle(static_cast<UChar32>(__codePoint))
+												   : u_toupper(static_cast<UChar32>(__codePoint));
+					TByte __bytes[4];
+					__result.append(__bytes, Unicode::encodeUtf8(static_cast<TCodePoint>(__upper), __bytes));
+					
+					if (firstOnly)
+					{
+						__result.append(__position, __end);
+						break;
+					}
+				}
+				return __result;
+			}
+		} // anonymous namespace
+		
+		TTransliterator::TTransliterator(const std::vector<TRule>& rules, bool caseVariants)
+				: m_classes(),
+				  m_starts(),
+				  m_classCount(1),
+				  m_rowShift(),
+				  m_transitions(),
+				  m_outputs(),
+				  m_targets(),
+				  m_maxExpansion(1),
+				  m_ruleCount()
+		{
+			for (const auto& __rule : rules)
+			{
+				if (__rule.source_.empty()
+					or not Unicode::validateUtf8(__rule.source_.data(), __rule.source_.size())
+					or not Unicode::validateUtf8(__rule.target_.data(), __rule.target_.size()))
+				{
+					throw TIllegalArgumentException("%s:%d Rule \"%s\" has empty or malformed source or target.",
+													__FILE__, __LINE__, TString(__rule.source_));
+				}
+			}
+			
+			// initial state, rows are 256 bytes wide until compiled
+			addState();
+			for (const auto& __rule : rules)
+				insert(__rule.source_, __rule.target_);
+			
+			// added after all rules, so that explicit ones win
+			if (caseVariants)
+			{
+				for (const auto& __rule : rules)
+				{
+					const auto __source = toUpper(__rule.source_, true);
+					insert(__source, toUpper(__rule.target_, true));
+					
+					const auto __upperSource = toUpper(__rule.source_, false);
+					if (__upperSource != __source)
+						insert(__upperSource, toUpper(__rule.target_, false));
+				}
+			}
+			compile();
+		}
+		
+		const TTransliterator&
+		TTransliterator::forLanguage(TStringView id, EDirection direction)
+		{
+			const auto __language = findLanguage(id);
+			const auto __alphabet = Unicode::findAlphabet(id);
+			if (not __language or not __alphabet)
+			{
+				throw TNotFoundException("%s:%d No transliteration for language \"%s\".",
+										 __FILE__, __LINE__, TString(id));
+			}
+			
+			static std::unique_ptr<TTransliterator> __transliterators[std::size(kLanguages)][2];
+			static std::once_flag __compiled[std::size(kLanguages)][2];
+			
+			const auto __index = static_cast<TSize>(__language - std::begin(kLanguages));
+			const auto __fromLatin = direction == EDirection::kFromLatin;
+			std::call_once(__compiled[__index][__fromLatin], [&]
+			{
+				std::vector<TRule> __rules;
+				for (auto __letter = __language->letters_; __letter != __language->letters_ + __language->size_; ++__letter)
+				{
+					if (not ( __letter->directions_ & ( __fromLatin ? kFromLatin : kToLatin )))
+						continue;
+					
+					// letters come from alphabet of language
+					const auto __end = __letter->native_.data() + __letter->native_.size();
+					for (auto __position = __letter->native_.data(); __position != __end;)
+					{
+						TCodePoint __codePoint {};
+						__position += Unicode::decodeUtf8(__position, __end, __codePoint);
+						if (not __alphabet->contains(__codePoint))
+						{
+							throw TIllegalArgumentException("%s:%d \"%s\" is not in alphabet of \"%s\".",
+															__FILE__, __LINE__, TString(__letter->native_), TString(id));
+						}
+					}
+					
+					__rules.push_back(__fromLatin ? TRule { __letter->latin_, __letter->native_ }
+												  : TRule { __letter->native_, __letter->latin_ });
+				}
+				__transliterators[__index][__fromLatin] = std::make_unique<TTransliterator>(__rules);
+			});
+			return *__transliterators[__index][__fromLatin];
+		}
+		
+		bool TTransliterator::isSupported(TStringView id) noexcept
+		{
+			return findLanguage(id) and Unicode::findAlphabet(id);
+		}
+		
+		void TTransliterator::transliterate(TStringView text, std::string& result) const
+		{
+			const auto __size = result.size();
+			// short targets are copied whole words at a time, past their end
+			result.resize(__size + text.size() * m_maxExpansion + kCopyWidth);
+			
+			const auto __classes = m_classes.data();
+			const auto __starts = m_starts.data();
+			const auto __transitions = m_transitions.data();
+			const auto __outputs = m_outputs.data();
+			const auto __targets = m_targets.data();
+			const auto __rowShift = m_rowShift;
+			
+			auto __target = result.data() + __size;
+			auto __position = text.data();
+			const auto __end = __position + text.size();
+			while (__position != __end)
+			{
+				// bytes no rule starts with are copied as they are
+				auto __run = __position;
+				while (__run != __end and not __starts[static_cast<UInt8>(*__run)])
+					++__run;
+				if (__run != __position)
+				{
+					std::memcpy(__target, __position, static_cast<TSize>(__run - __position));
+					__target += __run - __position;
+					__position = __run;
+					continue;
+				}
+				
+				// longest source starting here
+				const TOutput* __match {};
+				auto __matchEnd = __position;
+				auto __next = __position;
+				auto __state = __transitions[__classes[static_cast<UInt8>(*__next++)]];
+				while (true)
+				{
+					if (__state & kAccepting)
+					{
+						__match = &__outputs[( __state & kRowMask ) >> __rowShift];
+						__matchEnd = __next;
+					}
+					if (__state & kLeaf or __next == __end)
+						break;
+					
+					__state = __transitions[( __state & kRowMask ) + __classes[static_cast<UInt8>(*__next)]];
+					if (__state == kNone)
+						break;
+					++__next;
+				}
+				
+				if (__match)
+				{
+					if (__match->length_ <= kCopyWidth)
+						std::memcpy(__target, __targets + __match->offset_, kCopyWidth);
+					else
+						std::memcpy(__target, __targets + __match->offset_, __match->length_);
+					__target += __match->length_;
+					__position = __matchEnd;
+				}
+				else
+					*__target++ = *__position++;
+			}
+			result.resize(static_cast<TSize>(__target - result.data()));
+		}
+		
+		std::string TTransliterator::transliterate(TStringView text) const
+		{
+			std::string __result;
+			transliterate(text, __result);
+			return __result;
+		}
+		
+		TSize TTransliterator::getRuleCount() const noexcept
+		{
+			return m_ruleCount;
+		}
+		
+		void TTransliterator::insert(TStringView source, TStringView target)
+		{
+			TState __state {};
+			for (const auto __byte : source)
+			{
+				auto& __next = m_transitions[__state * 256 + static_cast<UInt8>(__byte)];
+				if (__next == kNone)
+				{
+					const auto __added = addState();
+					m_transitions[__state * 256 + static_cast<UInt8>(__byte)] = __added;
+					__state = __added;
+				}
+				else
+					__state = __next;
+			}
+			
+			auto& __output = m_outputs[__state];
+			if (__output.offset_ != kNoOutput)
+				return;
+			
+			__output = { static_cast<UInt32>(m_targets.size()), static_cast<UInt32>(target.size()) };
+			m_targets.append(target);
+			m_maxExpansion = std::max(m_maxExpansion, ( target.size() + source.size() - 1 ) / source.size());
+			++m_ruleCount;
+		}
+		
+		TTransliterator::TState TTransliterator::addState()
+		{
+			m_transitions.resize(m_transitions.size() + 256, kNone);
+			m_outputs.push_back({ kNoOutput, 0 });
+			return static_cast<TState>(m_outputs.size() - 1);
+		}
+		
+		void TTransliterator::compile()
+		{
+			const auto __stateCount = m_outputs.size();
+			
+			// bytes leading to same states from every state share class,
+			// valid UTF-8 never has 0xC0, 0xC1 and 0xF5 to 0xFF, so classes fit bytes
+			std::map<std::vector<TState>, UInt8> __columns;
+			std::vector<TState> __column(__stateCount);
+			for (TSize __byte {}; __byte < 256; ++__byte)
+			{
+				bool __used {};
+				for (TSize __state {}; __state < __stateCount; ++__state)
+				{
+					__column[__state] = m_transitions[__state * 256 + __byte];
+					__used = __used or __column[__state] != kNone;
+				}
+				
+				m_starts[__byte] = __column[0] != kNone;
+				if (not __used)
+					continue;
+				
+				const auto [__class, __added] = __columns.emplace(__column, static_cast<UInt8>(m_classCount));
+				m_classes[__byte] = __class->second;
+				if (__added)
+					++m_classCount;
+			}
+			
+			// rows are padded to power of two, so that states are shifted row offsets
+			while (( TSize(1) << m_rowShift ) < m_classCount)
+				++m_rowShift;
+			
+			std::vector<bool> __leaves(__stateCount, true);
+			for (TSize __state {}; __state < __stateCount; ++__state)
+				for (TSize __byte {}; __byte < 256 and __leaves[__state]; ++__byte)
+					__leaves[__state] = m_transitions[__state * 256 + __byte] == kNone;
+			
+			std::vector<TState> __transitions(__stateCount << m_rowShift, kNone);
+			for (TSize __state {}; __state < __stateCount; ++__state)
+			{
+				for (TSize __byte {}; __byte < 256; ++__byte)
+				{
+					const auto __next = m_transitions[__state * 256 + __byte];
+					if (__next == kNone)
+						continue;
+					
+					__transitions[( __state << m_rowShift ) + m_classes[__byte]] =
+							static_cast<TState>(__next << m_rowShift)
+							| ( m_outputs[__next].offset_ != kNoOutput ? kAccepting : 0 )
+							| ( __leaves[__next] ? kLeaf : 0 );
+				}
+			}
+			m_transitions = std::move(__transitions);
+			m_targets.append(kCopyWidth, '\0');
+		}
+	} // namespace OpenTranslate
+} // namespace Dixter
@@ -0,0 +1,142 @@
+/**
+ *  Copyright (C) 2015-2019
+ *  Author Alvin Ahmadov <alvin.dev.ahmadov@gmail.com>
+ *
+ *  This file is part of Dixter Project
+ *  License-Identifier: MIT License
+ *  See README.md for more information.
+ */
+
+#pragma once
+
+#include <array>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Types.hpp"
+
+namespace Dixter
+{
+	namespace OpenTranslate
+	{
+		/**
+		 * \brief Rewrites UTF-8 text from one script to another by table of rules.
+		 *
+		 * Rules are compiled into trie over bytes of their sources, stored as
+		 * transition table indexed by byte classes, so that rewriting is single
+		 * pass: longest source matching at current position is replaced by its
+		 * target, bytes no rule starts with are copied in runs.
+		 * \code
+		 * const auto& __latinToRussian = TTransliterator::forLanguage("ru", TTransliterator::EDirection::kFromLatin);
+		 * __dictionary->lookFor(__latinToRussian.transliterate("privet"), "word");
+		 * \endcode
+		 * */
+		class TTransliterator
+		{
+		public:
+			enum class EDirection
+			{
+				kFromLatin,
+				kToLatin
+			};
+			
+			/// Source written as target
+			struct TRule
+			{
+				TStringView source_;
+				
+				TStringView target_;
+			};
+		
+		public:
+			/**
+			 * \brief Compiles rules, first of ones with equal source wins.
+			 * \param caseVariants Adds capitalised and upper case forms of every rule
+			 * \throws TIllegalArgumentException if rule has empty source.
+			 * */
+			explicit TTransliterator(const std::vector<TRule>& rules, bool caseVariants = true);
+			
+			/**
+			 * \brief Built-in transliteration between Latin and alphabet of language,
+			 * compiled once on first use.
+			 * \param id Language id, as in languages.xml
+			 * \throws TNotFoundException if there are no rules for language.
+			 * */
+			static const TTransliterator& forLanguage(TStringView id, EDirection direction);
+			
+			/// Checks if there are built-in rules for language
+			static bool isSupported(TStringView id) noexcept;
+			
+			/// Appends transliteration of text to result
+			void transliterate(TStringView text, std::string& result) const;
+			
+			std::string transliterate(TStringView text) const;
+			
+			/// Number of compiled rules, including case variants
+			TSize getRuleCount() const noexcept;
+		
+		private:
+			using TState = UInt32;
+			
+			/// Target of state, where some source ends
+			struct TOutput
+			{
+				UInt32 offset_;
+				
+				UInt32 length_;
+			};
+			
+			/// Missing transition, no state leads back to the initial one
+			static constexpr TState kNone = 0;
+			
+			/// Compiled transitions are offsets of rows of next states, with these flags
+			static constexpr TState kAccepting = 1U << 31;
+			
+			/// State without transitions
+			static constexpr TState kLeaf = 1U << 30;
+			
+			static constexpr TState kRowMask = kLeaf - 1;
+			
+			/// Offset of output of states where no source ends
+			static constexpr UInt32 kNoOutput = static_cast<UInt32>(-1);
+			
+			/// Targets are padded to be read this many bytes at once
+			static constexpr TSize kCopyWidth = 8;
+			
+			/// Adds rule to trie, unless its source is there already
+			void insert(TStringView source, TStringView target);
+			
+			TState addState();
+			
+			/// Byte classes are assigned once trie is complete
+			void compile();
+		
+		private:
+			/// Class of every byte, 0 for bytes no source has
+			std::array<UInt8, 256> m_classes;
+			
+			/// Byte starts some source
+			std::array<bool, 256> m_starts;
+			
+			TSize m_classCount;
+			
+			/// Rows are 1 << m_rowShift wide, enough for all classes
+			TSize m_rowShift;
+			
+			/// Next state of state and byte class, row per state
+			std::vector<TState> m_transitions;
+			
+			/// Output of state, see kNoOutput
+			std::vector<TOutput> m_outputs;
+			
+			/// Targets of all rules one after another
+			std::string m_targets;
+			
+			/// Bytes of target per byte of source, at least 1
+			TSize m_maxExpansion;
+			
+			TSize m_ruleCount;
+		};
+	} // namespace OpenTranslate
+} // namespace Dixter
@@ -0,0 +1,115 @@
+/**
+ *  Copyright (C) 2015-2019
+ *  Author Alvin Ahmadov <alvin.dev.ahmadov@gmail.com>
+ *
+ *  This file is part of Dixter Project
+ *  License-Identifier: MIT License
+ *  See README.md for more information.
+ */
+
+#include "Exception.hpp"
+#include "NodeData.hpp"
+#include "RecordSet.hpp"
+
+namespace Dixter
+{
+	TRecordSet::TRecordSet(std::vector<TKeyHandle> fields)
+			: m_fields(std::move(fields)),
+			  m_columns(m_fields.size()),
+			  m_rows(),
+			  m_sources(),
+			  m_values()
+	{ }
+	
+	TSize TRecordSet::rows() const noexcept
+	{
+		return m_rows;
+	}
+	
+	TSize TRecordSet::columns() const noexcept
+	{
+		return m_fields.size();
+	}
+	
+	const std::vector<TKeyHandle>&
+	TRecordSet::getFields() const noexcept
+	{
+		return m_fields;
+	}
+	
+	Int32 TRecordSet::column(const TKeyHandle& field) const noexcept
+	{
+		for (TSize __column {}; __column < m_fields.size(); ++__column)
+			if (m_fields[__column] == field)
+				return static_cast<Int32>(__column);
+		
+		return -1;
+	}
+	
+	const TRecordSet::TColumn&
+	TRecordSet::getColumn(TSize column) const
+	{
+		if (column >= m_columns.size())
+			throw TRangeException("%s:%d Column %u out of range.", __FILE__, __LINE__, static_cast<UInt32>(column));
+		
+		return m_columns[column];
+	}
+	
+	TStringView TRecordSet::at(TSize row, TSize column) const
+	{
+		if (row >= m_rows)
+			throw TRangeException("%s:%d Row %u out of range.", __FILE__, __LINE__, static_cast<UInt32>(row));
+		
+		return getColumn(column)[row];
+	}
+	
+	TU8String TRecordSet::getValue(TSize row, TSize column) const
+	{
+		return TU8String(at(row, column));
+	}
+	
+	bool TRecordSet::has(TSize row, TSize column) const
+	{
+		return row < m_rows and getColumn(column)[row].data() != nullptr;
+	}
+	
+	void TRecordSet::clear() noexcept
+	{
+		for (auto& __column : m_columns)
+			__column.clear();
+		
+		m_rows = 0;
+		m_sources.clear();
+		m_values.clear();
+	}
+	
+	TSize TRecordSet::appendRow()
+	{
+		for (auto& __column : m_columns)
+			__column.emplace_back();
+		
+		return m_rows++;
+	}
+	
+	void TRecordSet::setCell(TSize row, TSize column, TStringView value)
+	{
+		if (row >= m_rows)
+			throw TRangeException("%s:%d Row %u out of range.", __FILE__, __LINE__, static_cast<UInt32>(row));
+		
+		if (column >= m_columns.size())
+			throw TRangeException("%s:%d Column %u out of range.", __FILE__, __LINE__, static_cast<UInt32>(column));
+		
+		m_columns[column][row] = value;
+	}
+	
+	void TRecordSet::setCell(TSize row, TSize column, TString&& value)
+	{
+		m_values.push_back(std::move(value));
+		setCell(row, column, TStringView(m_values.back()));
+	}
+	
+	void TRecordSet::keep(std::shared_ptr<const void> source)
+	{
+		m_sources.push_back(std::move(source));
+	}
+} // namespace Dixter
@@ -0,0 +1,115 @@
+/**
+ *  Copyright (C) 2015-2019
+ *  Author Alvin Ahmadov <alvin.dev.ahmadov@gmail.com>
+ *
+ *  This file is part of Dixter Project
+ *  License-Identifier: MIT License
+ *  See README.md for more information.
+ */
+#pragma once
+
+#include <deque>
+#include <memory>
+#include <vector>
+
+#include "Types.hpp"
+#include "KeyHandle.hpp"
+
+namespace Dixter
+{
+	/**
+	 * \author Alvin Ahmadov
+	 * \class TRecordSet
+	 * \brief Columnar result of record query.
+	 *
+	 * Row is single data of configuration, like one \c <language> element,
+	 * column is one of requested fields. Cells view UTF-8 values stored in
+	 * configuration snapshot, which record set keeps alive, so values aren't
+	 * copied and stay valid even if configuration changes meanwhile.
+	 * Field missing in record reads as empty value.
+	 * \code
+	 * TRecordSet __languages({ NodeHandle::kLangIdNode, NodeHandle::kLangNameNode });
+	 * accessor->select(__languages, NodeKey::kLangRoot);
+	 * for (TSize __row {}; __row < __languages.rows(); ++__row)
+	 * 	use(__languages.getValue(__row, 0), __languages.getValue(__row, 1));
+	 * \endcode
+	 * */
+	class TRecordSet
+	{
+	public:
+		/// Views of values, missing cell has null data
+		using TColumn = std::vector<TStringView>;
+	
+	public:
+		explicit TRecordSet(std::vector<TKeyHandle> fields = {});
+		
+		TRecordSet(TRecordSet&&) noexcept = default;
+		
+		TRecordSet& operator=(TRecordSet&&) noexcept = default;
+		
+		TSize rows() const noexcept;
+		
+		TSize columns() const noexcept;
+		
+		const std::vector<TKeyHandle>& getFields() const noexcept;
+		
+		/**
+		 * \returns Column of field or -1 if field wasn't requested.
+		 * */
+		Int32 column(const TKeyHandle& field) const noexcept;
+		
+		const TColumn& getColumn(TSize column) const;
+		
+		/**
+		 * \returns UTF-8 value of cell, empty if record has no such field.
+		 * \throws TRangeException if cell is out of range.
+		 * */
+		TStringView at(TSize row, TSize column) const;
+		
+		/**
+		 * \returns Copy of cell value.
+		 * \throws TRangeException if cell is out of range.
+		 * */
+		TU8String getValue(TSize row, TSize column) const;
+		
+		bool has(TSize row, TSize column) const;
+		
+		/**
+		 * \brief Removes rows, keeping fields.
+		 * */
+		void clear() noexcept;
+		
+		/**
+		 * \brief Appends row with all fields missing.
+		 * \returns Index of appended row.
+		 * */
+		TSize appendRow();
+		
+		/**
+		 * \brief Points cell to UTF-8 value owned by kept source.
+		 * */
+		void setCell(TSize row, TSize column, TStringView value);
+		
+		/**
+		 * \brief Stores UTF-8 value for backends having no snapshot to point to.
+		 * */
+		void setCell(TSize row, TSize column, TString&& value);
+		
+		/**
+		 * \brief Keeps source of cell values alive as long as record set.
+		 * */
+		void keep(std::shared_ptr<const void> source);
+	
+	private:
+		std::vector<TKeyHandle> m_fields;
+		
+		std::vector<TColumn> m_columns;
+		
+		TSize m_rows;
+		
+		std::vector<std::shared_ptr<const void>> m_sources;
+		
+		/// Stored values, deque keeps views of them valid
+		std::deque<TString> m_values;
+	};
+} // namespace Dixter
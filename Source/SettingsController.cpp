@@ -31,14 +31,14 @@ namespace Dixter
 		}
 	}
 	
-	void TSettingsController::read(const TString& key, TUString& value)
+	void TSettingsController::read(const TString& key, TU8String& value)
 	{
 		value = getManager(m_type, g_confPath)
 				->accessor()
 				->getValue(key, m_root);
 	}
 	
-	void TSettingsController::write(const TString& key, const TUString& value)
+	void TSettingsController::write(const TString& key, const TU8String& value)
 	{
 		getManager(m_type, g_confPath)
 				->mutator()
@@ -21,9 +21,9 @@ namespace Dixter
 		
 		~TSettingsController() = default;
 		
-		void read(const TString& key, TUString& value);
+		void read(const TString& key, TU8String& value);
 		
-		void write(const TString& key, const TUString& value);
+		void write(const TString& key, const TU8String& value);
 	
 	private:
 		const TString& m_root;
@@ -0,0 +1,254 @@
+/**
+ *  Copyright (C) 2015-2019
+ *  Author Alvin Ahmadov <alvin.dev.ahmadov@gmail.com>
+ *
+ *  This file is part of Dixter Project
+ *  License-Identifier: MIT License
+ *  See README.md for more information.
+ */
+#pragma once
+
+#include <bitset>
+#include <tuple>
+#include <utility>
+#include <type_traits>
+
+#include "Commons.hpp"
+
+namespace Dixter
+{
+	/**
+	 * \author Alvin Ahmadov
+	 * \class TTypedId
+	 * \brief Id of group element tagged with type of the element.
+	 * */
+	template<auto VId, class T>
+	struct TTypedId
+	{
+		using TId       = decltype(VId);
+		using TElement  = T;
+		
+		static constexpr TId kId = VId;
+	};
+	
+	/**
+	 * \author Alvin Ahmadov
+	 * \class TStaticGroup
+	 * \brief Group of elements whose ids and types are part of group type.
+	 *
+	 * Unlike TGroup, every element has its own typed slot, so lookups by
+	 * id known at compile time return pointer of registered type without
+	 * dynamic_cast and cost a member access. Using id that wasn't
+	 * registered, or registered with another type, fails to compile.
+	 * \code
+	 * using TWidgets = TStaticGroup<QWidget,
+	 * 		TTypedId<EWidgetID::TextView, TTextView>,
+	 * 		TTypedId<EWidgetID::SearchButton, TButton>>;
+	 *
+	 * __widgets.add<EWidgetID::SearchButton>(new TButton(this, tr("Search")));
+	 * TButton* __button = __widgets.get<EWidgetID::SearchButton>();
+	 * __widgets.forEach<&QWidget::setVisible>(true);
+	 * \endcode
+	 * \tparam TBase Common base of elements.
+	 * \tparam TIds Typed ids of elements, see TTypedId.
+	 * */
+	template<class TBase, class... TIds>
+	class TStaticGroup final : public TNonCopyable
+	{
+		static_assert(sizeof...(TIds) > 0, "Group needs at least one element.");
+		static_assert(( std::is_base_of_v<TBase, typename TIds::TElement> and ... ),
+					  "Elements must derive from base of group.");
+	
+	public:
+		using TObject       = TBase;
+		using EId           = typename std::tuple_element_t<0, std::tuple<TIds...>>::TId;
+		
+		static_assert(( std::is_same_v<EId, typename TIds::TId> and ... ), "Ids must have the same type.");
+		
+		static constexpr TSize kSize = sizeof...(TIds);
+		
+		/**
+		 * Position of element with id among elements of group, kSize if
+		 * there is no such element.
+		 * */
+		template<EId VId>
+		static constexpr TSize kIndex = []
+		{
+			constexpr EId __ids[] { TIds::kId... };
+			TSize __index {};
+			while (__index < kSize and __ids[__index] != VId)
+				++__index;
+			return __index;
+		}();
+		
+		template<EId VId>
+		using TElementOf = typename std::tuple_element_t<kIndex<VId>, std::tuple<TIds...>>::TElement;
+	
+	public:
+		TStaticGroup() noexcept
+				: m_elements(),
+				  m_autoDelete()
+		{ }
+		
+		~TStaticGroup() noexcept
+		{
+			clear();
+		}
+		
+		/**
+		 * \class StaticGroup
+		 * \brief Puts element to its slot.
+		 * \param element Element to be added.
+		 * \param autoDelete Automatical deletion of element with group.
+		 * \returns Element of the slot, which is existing one if slot is taken.
+		 * */
+		template<EId VId>
+		TElementOf<VId>*
+		add(TElementOf<VId>* element, bool autoDelete = false)
+		{
+			constexpr auto __index = checkedIndex<VId>();
+			auto& __slot = std::get<__index>(m_elements);
+			if (__slot)
+				return __slot;
+			
+			m_autoDelete.set(__index, autoDelete);
+			return __slot = element;
+		}
+		
+		/**
+		 * \class StaticGroup
+		 * \returns Element with id, null if it wasn't added.
+		 * */
+		template<EId VId>
+		TElementOf<VId>*
+		get() const noexcept
+		{
+			return std::get<checkedIndex<VId>()>(m_elements);
+		}
+		
+		/**
+		 * \class StaticGroup
+		 * \brief Finds element by id known at run time.
+		 * \tparam TCast Type to return element as.
+		 * \returns Element, null if there is no element with id or its
+		 * registered type doesn't derive from TCast.
+		 * */
+		template<class TCast = TObject>
+		TCast*
+		get(EId id) const noexcept
+		{
+			return find<TCast>(id, std::index_sequence_for<TIds...>());
+		}
+		
+		bool has(EId id) const noexcept
+		{
+			return get(id) != nullptr;
+		}
+		
+		/**
+		 * \class StaticGroup
+		 * \brief Removes element from its slot, deleting it if it was added so.
+		 * */
+		template<EId VId>
+		void remove() noexcept
+		{
+			constexpr auto __index = checkedIndex<VId>();
+			release<__index>();
+		}
+		
+		void clear() noexcept
+		{
+			clear(std::index_sequence_for<TIds...>());
+		}
+		
+		/**
+		 * \class StaticGroup
+		 * \brief Calls function with every added element in order of ids.
+		 *
+		 * Function is called with pointer of registered type of each
+		 * element, so it may be generic lambda.
+		 * */
+		template<class TFunction>
+		void forEach(TFunction&& function) const
+		{
+			std::apply([ &function ](auto* ... elements)
+					   {
+						   (( elements ? void(function(elements)) : void()), ...);
+					   }, m_elements);
+		}
+		
+		/**
+		 * \class StaticGroup
+		 * \brief Calls method of every added element.
+		 * \tparam FMethod Method of base, known at compile time, so the call
+		 * is made directly rather than through TMethodCallback.
+		 * */
+		template<auto FMethod, typename... TArgs>
+		void forEach(TArgs&& ... args) const
+		{
+			forEach([ & ](TObject* element) { ( element->*FMethod )(args...); });
+		}
+		
+		TSize getSize() const noexcept
+		{
+			TSize __size {};
+			forEach([ &__size ](const TObject*) { ++__size; });
+			return __size;
+		}
+		
+		bool empty() const noexcept
+		{
+			return getSize() == 0;
+		}
+	
+	private:
+		template<EId VId>
+		static constexpr TSize checkedIndex() noexcept
+		{
+			static_assert(kIndex<VId> < kSize, "Id isn't registered in group.");
+			return kIndex<VId>;
+		}
+		
+		template<class TCast, TSize... VIndex>
+		TCast* find(EId id, std::index_sequence<VIndex...>) const noexcept
+		{
+			TCast* __element {};
+			( findAt<TCast, VIndex>(id, __element) or ... );
+			return __element;
+		}
+		
+		template<class TCast, TSize VIndex>
+		bool findAt(EId id, TCast*& element) const noexcept
+		{
+			using TSlotId = std::tuple_element_t<VIndex, std::tuple<TIds...>>;
+			if (TSlotId::kId != id)
+				return false;
+			
+			if constexpr (std::is_base_of_v<TCast, typename TSlotId::TElement>)
+				element = std::get<VIndex>(m_elements);
+			return true;
+		}
+		
+		template<TSize VIndex>
+		void release() noexcept
+		{
+			auto& __slot = std::get<VIndex>(m_elements);
+			if (m_autoDelete.test(VIndex))
+				delete __slot;
+			
+			__slot = nullptr;
+			m_autoDelete.reset(VIndex);
+		}
+		
+		template<TSize... VIndex>
+		void clear(std::index_sequence<VIndex...>) noexcept
+		{
+			( release<VIndex>(), ... );
+		}
+	
+	private:
+		std::tuple<typename TIds::TElement* ...> m_elements;
+		
+		std::bitset<sizeof...(TIds)> m_autoDelete;
+	};
+} // namespace Dixter
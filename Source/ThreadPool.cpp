@@ -0,0 +1,167 @@
+/**
+ *  Copyright (C) 2015-2019
+ *  Author Alvin Ahmadov <alvin.dev.ahmadov@gmail.com>
+ *
+ *  This file is part of Dixter Project
+ *  License-Identifier: MIT License
+ *  See README.md for more information.
+ */
+
+#include <atomic>
+#include <algorithm>
+#include <exception>
+
+#include "ThreadPool.hpp"
+
+namespace Dixter
+{
+	namespace
+	{
+		/// Chunks of one parallelFor call, shared with workers that may pick it up late
+		struct TLoop
+		{
+			TLoop(TSize count, TSize chunk, const TThreadPool::TRangeBody& body) noexcept
+					: count_(count),
+					  chunk_(chunk),
+					  chunks_(( count + chunk - 1 ) / chunk),
+					  body_(body),
+					  next_(),
+					  done_(),
+					  error_(),
+					  mutex_(),
+					  finished_()
+			{ }
+			
+			/// Runs chunks until none is left to claim
+			void work()
+			{
+				for (auto __chunk = next_++; __chunk < chunks_; __chunk = next_++)
+				{
+					const auto __begin = __chunk * chunk_;
+					try
+					{
+						body_(__begin, std::min(__begin + chunk_, count_));
+					}
+					catch (...)
+					{
+						std::lock_guard<std::mutex> __lockGuard(mutex_);
+						if (not error_)
+							error_ = std::current_exception();
+					}
+					if (++done_ == chunks_)
+					{
+						std::lock_guard<std::mutex> __lockGuard(mutex_);
+						finished_.notify_all();
+					}
+				}
+			}
+			
+			const TSize count_;
+			
+			const TSize chunk_;
+			
+			const TSize chunks_;
+			
+			/// Owned by the caller, which outlives every claimed chunk
+			const TThreadPool::TRangeBody& body_;
+			
+			std::atomic<TSize> next_;
+			
+			std::atomic<TSize> done_;
+			
+			std::exception_ptr error_;
+			
+			std::mutex mutex_;
+			
+			std::condition_variable finished_;
+		};
+	} // anonymous namespace
+	
+	TThreadPool::TThreadPool(TSize threads)
+			: m_workers(),
+			  m_tasks(),
+			  m_mutex(),
+			  m_condition(),
+			  m_stop()
+	{
+		m_workers.reserve(std::max<TSize>(threads, 1));
+		for (TSize __index {}; __index < std::max<TSize>(threads, 1); ++__index)
+			m_workers.emplace_back([ this ] { run(); });
+	}
+	
+	TThreadPool::~TThreadPool() noexcept
+	{
+		{
+			std::lock_guard<std::mutex> __lockGuard(m_mutex);
+			m_stop = true;
+		}
+		m_condition.notify_all();
+		// joined before the queue they wait on goes away
+		m_workers.clear();
+	}
+	
+	TThreadPool& TThreadPool::shared()
+	{
+		static TThreadPool s_pool(std::max(std::thread::hardware_concurrency(), 2u) - 1);
+		return s_pool;
+	}
+	
+	TSize TThreadPool::getSize() const noexcept
+	{
+		return m_workers.size();
+	}
+	
+	void TThreadPool::parallelFor(TSize count, const TRangeBody& body, TSize chunk)
+	{
+		if (count <= kSequentialLimit)
+		{
+			if (count)
+				body(0, count);
+			return;
+		}
+		
+		// a few chunks per thread even out ranges of uneven cost
+		if (not chunk)
+			chunk = std::max(kSequentialLimit / 4, count / (( getSize() + 1 ) * 4));
+		
+		auto __loop = std::make_shared<TLoop>(count, chunk, body);
+		const auto __helpers = std::min(getSize(), __loop->chunks_ - 1);
+		for (TSize __index {}; __index < __helpers; ++__index)
+			submit([ __loop ] { __loop->work(); });
+		
+		__loop->work();
+		
+		std::unique_lock<std::mutex> __lock(__loop->mutex_);
+		__loop->finished_.wait(__lock, [ &__loop ] { return __loop->done_ == __loop->chunks_; });
+		// taken out, so exception isn't released by a worker dropping the loop later
+		if (auto __error = std::move(__loop->error_))
+			std::rethrow_exception(__error);
+	}
+	
+	void TThreadPool::run()
+	{
+		while (true)
+		{
+			std::function<void()> __task;
+			{
+				std::unique_lock<std::mutex> __lock(m_mutex);
+				m_condition.wait(__lock, [ this ] { return m_stop or not m_tasks.empty(); });
+				if (m_tasks.empty())
+					return;
+				
+				__task = std::move(m_tasks.front());
+				m_tasks.pop_front();
+			}
+			__task();
+		}
+	}
+	
+	void TThreadPool::submit(std::function<void()> task)
+	{
+		{
+			std::lock_guard<std::mutex> __lockGuard(m_mutex);
+			m_tasks.push_back(std::move(task));
+		}
+		m_condition.notify_one();
+	}
+} // namespace Dixter
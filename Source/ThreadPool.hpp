@@ -0,0 +1,91 @@
+/**
+ *  Copyright (C) 2015-2019
+ *  Author Alvin Ahmadov <alvin.dev.ahmadov@gmail.com>
+ *
+ *  This file is part of Dixter Project
+ *  License-Identifier: MIT License
+ *  See README.md for more information.
+ */
+#pragma once
+
+#include <deque>
+#include <vector>
+#include <functional>
+#include <condition_variable>
+
+#include "Commons.hpp"
+#include "JoinThread.hpp"
+
+namespace Dixter
+{
+	/**
+	 * \brief Execution policy of bulk operations like forEach.
+	 * */
+	enum class EExecution
+	{
+		/// Elements are visited in order on calling thread
+		Sequenced,
+		/// Elements are visited in chunks on threads of shared pool, in no particular order
+		Parallel
+	};
+	
+	/**
+	 * \author Alvin Ahmadov
+	 * \class TThreadPool
+	 * \brief Fixed set of worker threads running chunks of bulk operations.
+	 *
+	 * Calling thread takes part in the work and only waits for chunks
+	 * other threads have already started, so parallel loops may nest
+	 * without exhausting the pool.
+	 * */
+	class TThreadPool : public TNonCopyable
+	{
+	public:
+		using TRangeBody = std::function<void(TSize begin, TSize end)>;
+		
+		/// Loops with no more elements run sequentially on calling thread
+		static constexpr TSize kSequentialLimit = 64;
+	
+	public:
+		/**
+		 * \param threads Number of workers, at least one.
+		 * */
+		explicit TThreadPool(TSize threads);
+		
+		~TThreadPool() noexcept override;
+		
+		/**
+		 * Pool shared by the application, with a worker per hardware thread
+		 * besides the calling one.
+		 * */
+		static TThreadPool& shared();
+		
+		TSize getSize() const noexcept;
+		
+		/**
+		 * \brief Calls body for consecutive ranges covering [0, count).
+		 *
+		 * Ranges are run concurrently, so body must be safe to call from
+		 * several threads at once. Returns once every range was run.
+		 * \param chunk Elements per range, chosen from count and pool size if 0.
+		 * \throws Exception thrown by body, the first one if there were several.
+		 * */
+		void parallelFor(TSize count, const TRangeBody& body, TSize chunk = 0);
+	
+	private:
+		void run();
+		
+		void submit(std::function<void()> task);
+	
+	private:
+		std::vector<JoinThread> m_workers;
+		
+		std::deque<std::function<void()>> m_tasks;
+		
+		std::mutex m_mutex;
+		
+		std::condition_variable m_condition;
+		
+		bool m_stop;
+	};
+} // namespace Dixter
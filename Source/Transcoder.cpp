@@ -0,0 +1,507 @@
+/**
+ *  Copyright (C) 2015-2019
+ *  Author Alvin Ahmadov <alvin.dev.ahmadov@gmail.com>
+ *
+ *  This file is part of Dixter Project
+ *  License-Identifier: MIT License
+ *  See README.md for more information.
+ */
+
+#include <bitset>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#	include <emmintrin.h>
+#	define DX_TRANSCODER_SSE2
+#endif
+
+#include "Transcoder.hpp"
+
+namespace Dixter
+{
+	namespace Unicode
+	{
+		namespace
+		{
+			/// Bytes handled by a single block
+			constexpr TSize kBlock = 16;
+			
+			inline bool isSurrogate(TCodePoint value) noexcept
+			{
+				return value >= 0xD800 and value <= 0xDFFF;
+			}
+			
+			inline bool isHighSurrogate(TCodePoint value) noexcept
+			{
+				return value >= 0xD800 and value <= 0xDBFF;
+			}
+			
+			inline bool isLowSurrogate(TCodePoint value) noexcept
+			{
+				return value >= 0xDC00 and value <= 0xDFFF;
+			}
+			
+			inline TSize countBits(UInt32 mask) noexcept
+			{
+				return std::bitset<32>(mask).count();
+			}
+			
+			/**
+			 * Decodes UTF-16 code point.
+			 * \returns Number of units it takes, 0 if surrogate is unpaired.
+			 * */
+			inline TSize decodeUtf16(const char16_t* source, const char16_t* end, TCodePoint& codePoint) noexcept
+			{
+				const TCodePoint __unit = source[0];
+				if (not isSurrogate(__unit))
+				{
+					codePoint = __unit;
+					return 1;
+				}
+				if (not isHighSurrogate(__unit) or source + 1 == end or not isLowSurrogate(source[1]))
+					return 0;
+				
+				codePoint = 0x10000 + (( __unit - 0xD800 ) << 10 ) + ( TCodePoint(source[1]) - 0xDC00 );
+				return 2;
+			}
+			
+			inline TSize encodeUtf16(TCodePoint codePoint, char16_t* target) noexcept
+			{
+				if (codePoint < 0x10000)
+				{
+					target[0] = static_cast<char16_t>(codePoint);
+					return 1;
+				}
+				codePoint -= 0x10000;
+				target[0] = static_cast<char16_t>(0xD800 + ( codePoint >> 10 ));
+				target[1] = static_cast<char16_t>(0xDC00 + ( codePoint & 0x3FF ));
+				return 2;
+			}
+			
+			#ifdef DX_TRANSCODER_SSE2
+			
+			inline __m128i load(const void* source) noexcept
+			{
+				return _mm_loadu_si128(static_cast<const __m128i*>(source));
+			}
+			
+			inline bool isAscii(__m128i bytes) noexcept
+			{
+				return _mm_movemask_epi8(bytes) == 0;
+			}
+			
+			/// True if none of 8 UTF-16 units is above 0x7F
+			inline bool isAsciiUtf16(__m128i units) noexcept
+			{
+				return _mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(units, _mm_set1_epi16(static_cast<Int16>(0xFF80))),
+														 _mm_setzero_si128())) == 0xFFFF;
+			}
+			
+			/// True if none of 4 UTF-32 units is above 0x7F
+			inline bool isAsciiUtf32(__m128i units) noexcept
+			{
+				return _mm_movemask_epi8(_mm_cmpeq_epi32(_mm_and_si128(units, _mm_set1_epi32(~0x7F)),
+														 _mm_setzero_si128())) == 0xFFFF;
+			}
+			
+			#endif
+		} // anonymous namespace
+		
+		TSize decodeUtf8(const TByte* source, const TByte* end, TCodePoint& codePoint) noexcept
+		{
+			const auto* __bytes = reinterpret_cast<const TUByte*>(source);
+			const auto __available = static_cast<TSize>(end - source);
+			const TUByte __lead = __bytes[0];
+			if (__lead < 0x80)
+			{
+				codePoint = __lead;
+				return 1;
+			}
+			
+			TSize __length {};
+			TCodePoint __minimum {};
+			TCodePoint __value {};
+			if (( __lead & 0xE0 ) == 0xC0)
+			{
+				__length = 2;
+				__minimum = 0x80;
+				__value = __lead & 0x1F;
+			}
+			else if (( __lead & 0xF0 ) == 0xE0)
+			{
+				__length = 3;
+				__minimum = 0x800;
+				__value = __lead & 0x0F;
+			}
+			else if (( __lead & 0xF8 ) == 0xF0)
+			{
+				__length = 4;
+				__minimum = 0x10000;
+				__value = __lead & 0x07;
+			}
+			
+			if (not __length or __length > __available)
+				return 0;
+			
+			for (TSize __index = 1; __index < __length; ++__index)
+			{
+				if (( __bytes[__index] & 0xC0 ) != 0x80)
+					return 0;
+				__value = ( __value << 6 ) | ( __bytes[__index] & 0x3F );
+			}
+			
+			// overlong forms, surrogates and values past Unicode range
+			if (__value < __minimum or __value > kMaxCodePoint or isSurrogate(__value))
+				return 0;
+			
+			codePoint = __value;
+			return __length;
+		}
+		
+		TSize encodeUtf8(TCodePoint codePoint, TByte* target) noexcept
+		{
+			if (codePoint < 0x80)
+			{
+				target[0] = static_cast<TByte>(codePoint);
+				return 1;
+			}
+			if (codePoint < 0x800)
+			{
+				target[0] = static_cast<TByte>(0xC0 | ( codePoint >> 6 ));
+				target[1] = static_cast<TByte>(0x80 | ( codePoint & 0x3F ));
+				return 2;
+			}
+			if (codePoint < 0x10000)
+			{
+				target[0] = static_cast<TByte>(0xE0 | ( codePoint >> 12 ));
+				target[1] = static_cast<TByte>(0x80 | (( codePoint >> 6 ) & 0x3F ));
+				target[2] = static_cast<TByte>(0x80 | ( codePoint & 0x3F ));
+				return 3;
+			}
+			target[0] = static_cast<TByte>(0xF0 | ( codePoint >> 18 ));
+			target[1] = static_cast<TByte>(0x80 | (( codePoint >> 12 ) & 0x3F ));
+			target[2] = static_cast<TByte>(0x80 | (( codePoint >> 6 ) & 0x3F ));
+			target[3] = static_cast<TByte>(0x80 | ( codePoint & 0x3F ));
+			return 4;
+		}
+		
+		bool validateUtf8(const TByte* source, TSize length) noexcept
+		{
+			const auto __end = source + length;
+			while (source != __end)
+			{
+				#ifdef DX_TRANSCODER_SSE2
+				if (static_cast<TSize>(__end - source) >= kBlock and isAscii(load(source)))
+				{
+					source += kBlock;
+					continue;
+				}
+				#endif
+				TCodePoint __codePoint {};
+				const auto __length = decodeUtf8(source, __end, __codePoint);
+				if (not __length)
+					return false;
+				source += __length;
+			}
+			return true;
+		}
+		
+		bool validateUtf16(const char16_t* source, TSize length) noexcept
+		{
+			const auto __end = source + length;
+			while (source != __end)
+			{
+				TCodePoint __codePoint {};
+				const auto __length = decodeUtf16(source, __end, __codePoint);
+				if (not __length)
+					return false;
+				source += __length;
+			}
+			return true;
+		}
+		
+		bool validateUtf32(const TCodePoint* source, TSize length) noexcept
+		{
+			for (TSize __index {}; __index < length; ++__index)
+				if (source[__index] > kMaxCodePoint or isSurrogate(source[__index]))
+					return false;
+			return true;
+		}
+		
+		TSize utf16LengthFromUtf8(const TByte* source, TSize length) noexcept
+		{
+			// unit per lead byte, and one more for leads of 4 byte sequences
+			TSize __units {};
+			TSize __index {};
+			#ifdef DX_TRANSCODER_SSE2
+			const auto __continuation = _mm_set1_epi8(static_cast<TByte>(0xBF));
+			const auto __fourByteLead = _mm_set1_epi8(static_cast<TByte>(0xEF));
+			for (; __index + kBlock <= length; __index += kBlock)
+			{
+				const auto __bytes = load(source + __index);
+				const auto __leads = _mm_cmpgt_epi8(__bytes, __continuation);
+				const auto __fourByteLeads = _mm_and_si128(_mm_cmpgt_epi8(__bytes, __fourByteLead),
+														   _mm_cmplt_epi8(__bytes, _mm_setzero_si128()));
+				__units += countBits(static_cast<UInt32>(_mm_movemask_epi8(__leads)))
+						   + countBits(static_cast<UInt32>(_mm_movemask_epi8(__fourByteLeads)));
+			}
+			#endif
+			for (; __index < length; ++__index)
+			{
+				const auto __byte = static_cast<TUByte>(source[__index]);
+				__units += ( __byte & 0xC0 ) != 0x80;
+				__units += __byte >= 0xF0;
+			}
+			return __units;
+		}
+		
+		TSize utf32LengthFromUtf8(const TByte* source, TSize length) noexcept
+		{
+			TSize __codePoints {};
+			TSize __index {};
+			#ifdef DX_TRANSCODER_SSE2
+			const auto __continuation = _mm_set1_epi8(static_cast<TByte>(0xBF));
+			for (; __index + kBlock <= length; __index += kBlock)
+				__codePoints += countBits(static_cast<UInt32>(
+						_mm_movemask_epi8(_mm_cmpgt_epi8(load(source + __index), __continuation))));
+			#endif
+			for (; __index < length; ++__index)
+				__codePoints += ( static_cast<TUByte>(source[__index]) & 0xC0 ) != 0x80;
+			return __codePoints;
+		}
+		
+		TSize utf8LengthFromUtf16(const char16_t* source, TSize length) noexcept
+		{
+			// byte per unit, one more from 0x80 and one more from 0x800 outside surrogates,
+			// so a surrogate pair takes 4
+			TSize __bytes {};
+			TSize __index {};
+			#ifdef DX_TRANSCODER_SSE2
+			// unsigned comparisons made signed by flipping sign bits
+			const auto __sign = _mm_set1_epi16(static_cast<Int16>(0x8000));
+			const auto __twoBytes = _mm_set1_epi16(static_cast<Int16>(0x7F ^ 0x8000));
+			const auto __threeBytes = _mm_set1_epi16(static_cast<Int16>(0x7FF ^ 0x8000));
+			const auto __surrogateMask = _mm_set1_epi16(static_cast<Int16>(0xF800));
+			const auto __surrogate = _mm_set1_epi16(static_cast<Int16>(0xD800));
+			for (; __index + kBlock / 2 <= length; __index += kBlock / 2)
+			{
+				const auto __units = load(source + __index);
+				const auto __flipped = _mm_xor_si128(__units, __sign);
+				const auto __surrogates = _mm_cmpeq_epi16(_mm_and_si128(__units, __surrogateMask), __surrogate);
+				const auto __wide = _mm_andnot_si128(__surrogates, _mm_cmpgt_epi16(__flipped, __threeBytes));
+				// two mask bits per unit
+				__bytes += kBlock / 2
+						   + ( countBits(static_cast<UInt32>(_mm_movemask_epi8(_mm_cmpgt_epi16(__flipped, __twoBytes))))
+							   + countBits(static_cast<UInt32>(_mm_movemask_epi8(__wide)))) / 2;
+			}
+			#endif
+			for (; __index < length; ++__index)
+			{
+				const TCodePoint __unit = source[__index];
+				__bytes += 1 + ( __unit >= 0x80 ) + ( __unit >= 0x800 and not isSurrogate(__unit));
+			}
+			return __bytes;
+		}
+		
+		TSize utf32LengthFromUtf16(const char16_t* source, TSize length) noexcept
+		{
+			TSize __codePoints {};
+			for (TSize __index {}; __index < length; ++__index)
+				__codePoints += not isLowSurrogate(source[__index]);
+			return __codePoints;
+		}
+		
+		TSize utf8LengthFromUtf32(const TCodePoint* source, TSize length) noexcept
+		{
+			TSize __bytes {};
+			for (TSize __index {}; __index < length; ++__index)
+			{
+				const auto __codePoint = source[__index];
+				__bytes += 1 + ( __codePoint >= 0x80 ) + ( __codePoint >= 0x800 ) + ( __codePoint >= 0x10000 );
+			}
+			return __bytes;
+		}
+		
+		TSize utf16LengthFromUtf32(const TCodePoint* source, TSize length) noexcept
+		{
+			TSize __units {};
+			for (TSize __index {}; __index < length; ++__index)
+				__units += 1 + ( source[__index] >= 0x10000 );
+			return __units;
+		}
+		
+		TSize convertUtf8ToUtf16(const TByte* source, TSize length, char16_t* target) noexcept
+		{
+			const auto __end = source + length;
+			const auto __begin = target;
+			while (source != __end)
+			{
+				#ifdef DX_TRANSCODER_SSE2
+				if (static_cast<TSize>(__end - source) >= kBlock)
+				{
+					const auto __bytes = load(source);
+					if (isAscii(__bytes))
+					{
+						const auto __zero = _mm_setzero_si128();
+						_mm_storeu_si128(reinterpret_cast<__m128i*>(target), _mm_unpacklo_epi8(__bytes, __zero));
+						_mm_storeu_si128(reinterpret_cast<__m128i*>(target + 8), _mm_unpackhi_epi8(__bytes, __zero));
+						source += kBlock;
+						target += kBlock;
+						continue;
+					}
+				}
+				#endif
+				TCodePoint __codePoint {};
+				const auto __length = decodeUtf8(source, __end, __codePoint);
+				if (not __length)
+					return kInvalid;
+				source += __length;
+				target += encodeUtf16(__codePoint, target);
+			}
+			return static_cast<TSize>(target - __begin);
+		}
+		
+		TSize convertUtf8ToUtf32(const TByte* source, TSize length, TCodePoint* target) noexcept
+		{
+			const auto __end = source + length;
+			const auto __begin = target;
+			while (source != __end)
+			{
+				#ifdef DX_TRANSCODER_SSE2
+				if (static_cast<TSize>(__end - source) >= kBlock)
+				{
+					const auto __bytes = load(source);
+					if (isAscii(__bytes))
+					{
+						const auto __zero = _mm_setzero_si128();
+						const auto __low = _mm_unpacklo_epi8(__bytes, __zero);
+						const auto __high = _mm_unpackhi_epi8(__bytes, __zero);
+						auto* __target = reinterpret_cast<__m128i*>(target);
+						_mm_storeu_si128(__target, _mm_unpacklo_epi16(__low, __zero));
+						_mm_storeu_si128(__target + 1, _mm_unpackhi_epi16(__low, __zero));
+						_mm_storeu_si128(__target + 2, _mm_unpacklo_epi16(__high, __zero));
+						_mm_storeu_si128(__target + 3, _mm_unpackhi_epi16(__high, __zero));
+						source += kBlock;
+						target += kBlock;
+						continue;
+					}
+				}
+				#endif
+				const auto __length = decodeUtf8(source, __end, *target);
+				if (not __length)
+					return kInvalid;
+				source += __length;
+				++target;
+			}
+			return static_cast<TSize>(target - __begin);
+		}
+		
+		TSize convertUtf16ToUtf8(const char16_t* source, TSize length, TByte* target) noexcept
+		{
+			const auto __end = source + length;
+			const auto __begin = target;
+			while (source != __end)
+			{
+				#ifdef DX_TRANSCODER_SSE2
+				if (static_cast<TSize>(__end - source) >= kBlock)
+				{
+					const auto __low = load(source);
+					const auto __high = load(source + 8);
+					if (isAsciiUtf16(_mm_or_si128(__low, __high)))
+					{
+						_mm_storeu_si128(reinterpret_cast<__m128i*>(target), _mm_packus_epi16(__low, __high));
+						source += kBlock;
+						target += kBlock;
+						continue;
+					}
+				}
+				#endif
+				TCodePoint __codePoint {};
+				const auto __length = decodeUtf16(source, __end, __codePoint);
+				if (not __length)
+					return kInvalid;
+				source += __length;
+				target += encodeUtf8(__codePoint, target);
+			}
+			return static_cast<TSize>(target - __begin);
+		}
+		
+		TSize convertUtf16ToUtf32(const char16_t* source, TSize length, TCodePoint* target) noexcept
+		{
+			const auto __end = source + length;
+			const auto __begin = target;
+			while (source != __end)
+			{
+				#ifdef DX_TRANSCODER_SSE2
+				if (static_cast<TSize>(__end - source) >= kBlock / 2)
+				{
+					const auto __units = load(source);
+					const auto __surrogates = _mm_cmpeq_epi16(_mm_and_si128(__units, _mm_set1_epi16(static_cast<Int16>(0xF800))),
+															  _mm_set1_epi16(static_cast<Int16>(0xD800)));
+					if (isAscii(__surrogates))
+					{
+						const auto __zero = _mm_setzero_si128();
+						auto* __target = reinterpret_cast<__m128i*>(target);
+						_mm_storeu_si128(__target, _mm_unpacklo_epi16(__units, __zero));
+						_mm_storeu_si128(__target + 1, _mm_unpackhi_epi16(__units, __zero));
+						source += kBlock / 2;
+						target += kBlock / 2;
+						continue;
+					}
+				}
+				#endif
+				const auto __length = decodeUtf16(source, __end, *target);
+				if (not __length)
+					return kInvalid;
+				source += __length;
+				++target;
+			}
+			return static_cast<TSize>(target - __begin);
+		}
+		
+		TSize convertUtf32ToUtf8(const TCodePoint* source, TSize length, TByte* target) noexcept
+		{
+			const auto __begin = target;
+			TSize __index {};
+			while (__index < length)
+			{
+				#ifdef DX_TRANSCODER_SSE2
+				if (length - __index >= kBlock)
+				{
+					const auto __first = load(source + __index);
+					const auto __second = load(source + __index + 4);
+					const auto __third = load(source + __index + 8);
+					const auto __fourth = load(source + __index + 12);
+					if (isAsciiUtf32(_mm_or_si128(_mm_or_si128(__first, __second), _mm_or_si128(__third, __fourth))))
+					{
+						// values fit signed 16 bits, so saturating packs keep them
+						const auto __low = _mm_packs_epi32(__first, __second);
+						const auto __high = _mm_packs_epi32(__third, __fourth);
+						_mm_storeu_si128(reinterpret_cast<__m128i*>(target), _mm_packus_epi16(__low, __high));
+						__index += kBlock;
+						target += kBlock;
+						continue;
+					}
+				}
+				#endif
+				const auto __codePoint = source[__index++];
+				if (__codePoint > kMaxCodePoint or isSurrogate(__codePoint))
+					return kInvalid;
+				target += encodeUtf8(__codePoint, target);
+			}
+			return static_cast<TSize>(target - __begin);
+		}
+		
+		TSize convertUtf32ToUtf16(const TCodePoint* source, TSize length, char16_t* target) noexcept
+		{
+			const auto __begin = target;
+			for (TSize __index {}; __index < length; ++__index)
+			{
+				const auto __codePoint = source[__index];
+				if (__codePoint > kMaxCodePoint or isSurrogate(__codePoint))
+					return kInvalid;
+				target += encodeUtf16(__codePoint, target);
+			}
+			return static_cast<TSize>(target - __begin);
+		}
+	} // namespace Unicode
+} // namespace Dixter
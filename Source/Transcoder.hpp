@@ -0,0 +1,93 @@
+/**
+ *  Copyright (C) 2015-2019
+ *  Author Alvin Ahmadov <alvin.dev.ahmadov@gmail.com>
+ *
+ *  This file is part of Dixter Project
+ *  License-Identifier: MIT License
+ *  See README.md for more information.
+ */
+#pragma once
+
+#include "Types.hpp"
+
+namespace Dixter
+{
+	/**
+	 * \brief Conversions between UTF-8, UTF-16 and UTF-32 buffers.
+	 *
+	 * Conversions validate input and never allocate: output is written to
+	 * buffer of caller, which is sized by matching length function. Length
+	 * functions are exact for valid input and never less than what conversion
+	 * writes for invalid one, so their result is always safe to allocate.
+	 * Runs of ASCII are handled in 16 byte blocks with SSE2 where available.
+	 * \code
+	 * std::u16string __buffer(Unicode::utf16LengthFromUtf8(__data, __size), u'\0');
+	 * if (Unicode::convertUtf8ToUtf16(__data, __size, __buffer.data()) == Unicode::kInvalid)
+	 * 	throw TIllegalArgumentException("%s:%d Malformed UTF-8.", __FILE__, __LINE__);
+	 * \endcode
+	 * */
+	namespace Unicode
+	{
+		/// Returned by conversions when input is malformed
+		constexpr TSize kInvalid = static_cast<TSize>(-1);
+		
+		/// Last code point of Unicode range
+		constexpr TCodePoint kMaxCodePoint = 0x10FFFF;
+		
+		/// Substitute of malformed sequences
+		constexpr TCodePoint kReplacement = 0xFFFD;
+		
+		/**
+		 * \brief Decodes single UTF-8 sequence.
+		 * \param codePoint Decoded code point, unchanged if sequence is malformed.
+		 * \returns Length of sequence in bytes, 0 if it's malformed, overlong,
+		 * encodes surrogate or value past Unicode range, or is cut by end.
+		 * */
+		TSize decodeUtf8(const TByte* source, const TByte* end, TCodePoint& codePoint) noexcept;
+		
+		/**
+		 * \brief Encodes code point as UTF-8.
+		 * \param target Buffer of at least 4 bytes.
+		 * \returns Number of bytes written.
+		 * */
+		TSize encodeUtf8(TCodePoint codePoint, TByte* target) noexcept;
+		
+		bool validateUtf8(const TByte* source, TSize length) noexcept;
+		
+		/// Checks that surrogates are paired
+		bool validateUtf16(const char16_t* source, TSize length) noexcept;
+		
+		/// Checks that values are in Unicode range and aren't surrogates
+		bool validateUtf32(const TCodePoint* source, TSize length) noexcept;
+		
+		TSize utf16LengthFromUtf8(const TByte* source, TSize length) noexcept;
+		
+		/// Number of code points
+		TSize utf32LengthFromUtf8(const TByte* source, TSize length) noexcept;
+		
+		TSize utf8LengthFromUtf16(const char16_t* source, TSize length) noexcept;
+		
+		/// Number of code points
+		TSize utf32LengthFromUtf16(const char16_t* source, TSize length) noexcept;
+		
+		TSize utf8LengthFromUtf32(const TCodePoint* source, TSize length) noexcept;
+		
+		TSize utf16LengthFromUtf32(const TCodePoint* source, TSize length) noexcept;
+		
+		/**
+		 * \returns Number of units written, kInvalid if input is malformed,
+		 * in which case target holds conversion of valid prefix.
+		 * */
+		TSize convertUtf8ToUtf16(const TByte* source, TSize length, char16_t* target) noexcept;
+		
+		TSize convertUtf8ToUtf32(const TByte* source, TSize length, TCodePoint* target) noexcept;
+		
+		TSize convertUtf16ToUtf8(const char16_t* source, TSize length, TByte* target) noexcept;
+		
+		TSize convertUtf16ToUtf32(const char16_t* source, TSize length, TCodePoint* target) noexcept;
+		
+		TSize convertUtf32ToUtf8(const TCodePoint* source, TSize length, TByte* target) noexcept;
+		
+		TSize convertUtf32ToUtf16(const TCodePoint* source, TSize length, char16_t* target) noexcept;
+	} // namespace Unicode
+} // namespace Dixter
@@ -11,6 +11,7 @@
 #include <cstdint>
 #include <memory>
 #include "UnicodeString.hpp"
+#include "Utf8String.hpp"
 
 namespace Dixter
 {
@@ -55,6 +56,7 @@ namespace Dixter
 	using TString       = std::string;
 	using TWString      = std::wstring;
 	using TUString      = TUnicodeString;
+	using TU8String     = TUtf8String;
 	using TStringPair	= std::pair<TString, TString>;
 } // namespace Dixter
 
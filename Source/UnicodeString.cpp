@@ -13,6 +13,8 @@
 #include <QString>
 #endif
 #include <unicode/ustring.h>
+#include "Exception.hpp"
+#include "Transcoder.hpp"
 
 namespace Dixter
 {
@@ -54,8 +56,13 @@ namespace Dixter
 	
 	std::string TUnicodeString::asUTF8() const
 	{
-		std::string sc { };
-		toUTF8String(sc);
+		std::string sc(Unicode::utf8LengthFromUtf16(getBuffer(), length()), '\0');
+		if (Unicode::convertUtf16ToUtf8(getBuffer(), length(), sc.data()) == Unicode::kInvalid)
+		{
+			// unpaired surrogates are substituted by ICU
+			sc.clear();
+			toUTF8String(sc);
+		}
 		return sc;
 	}
 	
@@ -76,7 +83,7 @@ namespace Dixter
 	TUnicodeString&
 	TUnicodeString::append(const char16_t* s)
 	{
-		icu::UnicodeString::append(s, 0, u_strlen_60(s));
+		icu::UnicodeString::append(s, 0, u_strlen(s));
 		return *this;
 	}
 	
@@ -118,12 +125,14 @@ namespace Dixter
 	TUnicodeString&
 	TUnicodeString::fromUTF32(const UChar32 *src, size_t codePointLen)
 	{
-		UChar * dst = new UChar[codePointLen];
-		UErrorCode errorCode {};
-		u_strFromUTF32_60(dst, codePointLen, NULL, src, codePointLen, &errorCode);
-		const UChar* rs = dst;
-		clear();
-		replace(0, length(), rs, 0, codePointLen);
+		const auto source = reinterpret_cast<const char32_t*>(src);
+		// supplementary code points take two units
+		const auto units = Unicode::utf16LengthFromUtf32(source, codePointLen);
+		const auto written = Unicode::convertUtf32ToUtf16(source, codePointLen,
+														  getBuffer(static_cast<int32_t>(units)));
+		releaseBuffer(written == Unicode::kInvalid ? 0 : static_cast<int32_t>(written));
+		if (written == Unicode::kInvalid)
+			throw TIllegalArgumentException("%s:%d Malformed UTF-32 string.", __FILE__, __LINE__);
 		return *this;
 	}
 	
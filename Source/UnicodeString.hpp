@@ -12,6 +12,7 @@
 #include <string>
 #include <iostream>
 #include "setup.h"
+#include "NumberParser.hpp"
 
 #ifdef HAS_QSTRING
 class QString;
@@ -143,45 +144,65 @@ namespace Dixter
 			return TBase::operator>=(self);
 		}
 		
+		/**
+		 * \brief Parses number at start of string, without allocating or throwing.
+		 * \code
+		 * Int32 __fontSize {};
+		 * if (not __value.parse(__fontSize))
+		 * 	__fontSize = kDefaultFontSize;
+		 * \endcode
+		 * \see parseNumber
+		 * */
+		template<typename TNumber>
+		TParseResult parse(TNumber& value, int base = 10) const noexcept
+		{
+			return parseNumber(getBuffer(), getBuffer() + length(), value, base);
+		}
+		
 		inline operator int() const
 		{
-			int __nm(std::stoi(asUTF8()));
-			return __nm;
+			return toNumber<int>();
 		}
 		
 		inline operator long() const
 		{
-			long __nm(std::stol(asUTF8()));
-			return __nm;
+			return toNumber<long>();
 		}
 		
 		inline operator long long() const
 		{
-			long long __nm(std::stoll(asUTF8()));
-			return __nm;
+			return toNumber<long long>();
 		}
 		
 		inline operator unsigned long() const
 		{
-			unsigned long __nm(std::stoul(asUTF8()));
-			return __nm;
+			return toNumber<unsigned long>();
 		}
 		
 		inline operator unsigned long long() const
 		{
-			unsigned long long __nm(std::stoull(asUTF8()));
-			return __nm;
+			return toNumber<unsigned long long>();
 		}
 		
 		inline operator float() const
 		{
-			float __nm(std::stof(asUTF8()));
-			return __nm;
+			return toNumber<float>();
 		}
 		
 		inline operator double() const
 		{
-			double __nm(std::stod(asUTF8()));
+			return toNumber<double>();
+		}
+	
+	private:
+		/// Implicit conversions, throwing TParseException or TRangeException on failure
+		template<typename TNumber>
+		TNumber toNumber() const
+		{
+			TNumber __nm {};
+			const auto __result = parse(__nm);
+			if (not __result)
+				throwParseError(__result, asUTF8());
 			return __nm;
 		}
 	};
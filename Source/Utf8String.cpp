@@ -0,0 +1,163 @@
+/**
+ *  Copyright (C) 2015-2019
+ *  Author Alvin Ahmadov <alvin.dev.ahmadov@gmail.com>
+ *
+ *  This file is part of Dixter
+ *  License-Identifier: MIT License
+ *  See README.md for more information.
+ */
+#include "setup.h"
+#include "Utf8String.hpp"
+#include "Transcoder.hpp"
+#if __has_include(<QString>)
+#include <QString>
+#endif
+
+namespace Dixter
+{
+	// TCodePointIterator implementation
+	TUtf8String::TCodePointIterator::TCodePointIterator(const char* position, const char* end) noexcept
+			: m_position(position),
+			  m_end(end)
+	{ }
+	
+	char32_t TUtf8String::TCodePointIterator::operator*() const noexcept
+	{
+		char32_t __codePoint {};
+		decode(__codePoint);
+		return __codePoint;
+	}
+	
+	TUtf8String::TCodePointIterator&
+	TUtf8String::TCodePointIterator::operator++() noexcept
+	{
+		char32_t __codePoint {};
+		m_position += decode(__codePoint);
+		return *this;
+	}
+	
+	TUtf8String::TCodePointIterator
+	TUtf8String::TCodePointIterator::operator++(int) noexcept
+	{
+		auto __previous = *this;
+		++*this;
+		return __previous;
+	}
+	
+	TUtf8String::size_type
+	TUtf8String::TCodePointIterator::decode(char32_t& codePoint) const noexcept
+	{
+		const auto __length = Unicode::decodeUtf8(m_position, m_end, codePoint);
+		if (__length)
+			return __length;
+		
+		codePoint = Unicode::kReplacement;
+		return 1;
+	}
+	
+	// TUtf8String implementation
+	TUtf8String::TUtf8String(const std::string& string)
+			: m_string(string)
+	{ }
+	
+	TUtf8String::TUtf8String(std::string&& string) noexcept
+			: m_string(std::move(string))
+	{ }
+	
+	TUtf8String::TUtf8String(std::string_view string)
+			: m_string(string)
+	{ }
+	
+	TUtf8String::TUtf8String(const char* string)
+			: m_string(string ? string : "")
+	{ }
+	
+	TUtf8String::TUtf8String(const icu::UnicodeString& string)
+			: m_string(Unicode::utf8LengthFromUtf16(string.getBuffer(), static_cast<TSize>(string.length())), '\0')
+	{
+		if (Unicode::convertUtf16ToUtf8(string.getBuffer(), static_cast<TSize>(string.length()), m_string.data())
+			== Unicode::kInvalid)
+		{
+			// unpaired surrogates are substituted by ICU
+			m_string.clear();
+			string.toUTF8String(m_string);
+		}
+	}
+	
+	#ifdef HAS_QSTRING
+	
+	TUtf8String::TUtf8String(const QString& string)
+			: m_string(string.toStdString())
+	{ }
+	
+	QString TUtf8String::asCustom() const
+	{
+		return QString::fromUtf8(m_string.data(), static_cast<int>(m_string.size()));
+	}
+	
+	#endif
+	
+	TUtf8String::size_type TUtf8String::countCodePoints() const noexcept
+	{
+		size_type __count {};
+		for (auto __codePoint = codePointBegin(); __codePoint != codePointEnd(); ++__codePoint)
+			++__count;
+		return __count;
+	}
+	
+	TUnicodeString TUtf8String::toUnicode() const
+	{
+		TUnicodeString __string;
+		const auto __units = Unicode::utf16LengthFromUtf8(m_string.data(), m_string.size());
+		const auto __written = Unicode::convertUtf8ToUtf16(m_string.data(), m_string.size(),
+														   __string.getBuffer(static_cast<int32_t>(__units)));
+		if (__written != Unicode::kInvalid)
+		{
+			__string.releaseBuffer(static_cast<int32_t>(__written));
+			return __string;
+		}
+		
+		// malformed sequences are substituted by ICU
+		__string.releaseBuffer(0);
+		return TUnicodeString(icu::UnicodeString::fromUTF8(
+				icu::StringPiece(m_string.data(), static_cast<int32_t>(m_string.size()))));
+	}
+	
+	TUtf8String& TUtf8String::append(std::string_view string)
+	{
+		m_string.append(string);
+		return *this;
+	}
+	
+	TUtf8String& TUtf8String::append(const TSelf& self)
+	{
+		m_string.append(self.m_string);
+		return *this;
+	}
+	
+	TUtf8String& TUtf8String::append(char32_t codePoint)
+	{
+		if (codePoint > Unicode::kMaxCodePoint or ( codePoint >= 0xD800 and codePoint <= 0xDFFF ))
+			codePoint = Unicode::kReplacement;
+		
+		char __bytes[4];
+		m_string.append(__bytes, Unicode::encodeUtf8(codePoint, __bytes));
+		return *this;
+	}
+	
+	std::ostream&
+	operator<<(std::ostream& out, const TUtf8String& us)
+	{
+		out << us.view();
+		return out;
+	}
+	
+	std::istream&
+	operator>>(std::istream& in, TUtf8String& us)
+	{
+		std::string __string { };
+		in >> __string;
+		us = TUtf8String(std::move(__string));
+		return in;
+	}
+}
@@ -0,0 +1,376 @@
+/**
+ *  Copyright (C) 2015-2019
+ *  Author Alvin Ahmadov <alvin.dev.ahmadov@gmail.com>
+ *
+ *  This file is part of Dixter
+ *  License-Identifier: MIT License
+ *  See README.md for more information.
+ */
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <iterator>
+#include <iostream>
+#include "setup.h"
+#include "NumberParser.hpp"
+#include "UnicodeString.hpp"
+
+#ifdef HAS_QSTRING
+class QString;
+#endif
+
+namespace Dixter
+{
+	class TUtf8String;
+	
+	std::ostream&
+	operator<<(std::ostream& out, const TUtf8String& us);
+	
+	std::istream&
+	operator>>(std::istream& in, TUtf8String& us);
+	
+	/**
+	 * \author Alvin Ahmadov
+	 * \class TUtf8String
+	 * \brief String stored as UTF-8.
+	 *
+	 * Bytes are kept in std::string, so short strings live inside the object
+	 * without allocation, and UTF-8 or string_view access is free. ICU string
+	 * is only made when asked for, see toUnicode(). Meant for values that are
+	 * mostly read or passed on as UTF-8, like configuration values.
+	 * */
+	class TUtf8String
+	{
+	public:
+		using TSelf = TUtf8String;
+		using value_type = char;
+		using size_type = std::string::size_type;
+		
+		/**
+		 * \brief Decodes code points of UTF-8 bytes.
+		 *
+		 * Malformed sequence is read as single U+FFFD, skipping its first byte.
+		 * */
+		class TCodePointIterator
+		{
+		public:
+			using iterator_category = std::forward_iterator_tag;
+			using value_type = char32_t;
+			using difference_type = std::ptrdiff_t;
+			using pointer = const char32_t*;
+			using reference = char32_t;
+		
+		public:
+			TCodePointIterator() noexcept = default;
+			
+			TCodePointIterator(const char* position, const char* end) noexcept;
+			
+			char32_t operator*() const noexcept;
+			
+			TCodePointIterator& operator++() noexcept;
+			
+			TCodePointIterator operator++(int) noexcept;
+			
+			bool operator==(const TCodePointIterator& other) const noexcept
+			{
+				return m_position == other.m_position;
+			}
+			
+			bool operator!=(const TCodePointIterator& other) const noexcept
+			{
+				return m_position != other.m_position;
+			}
+			
+			/// Byte the current code point starts at
+			const char* base() const noexcept
+			{
+				return m_position;
+			}
+		
+		private:
+			/// Decodes code point at current position, returns length of its sequence
+			size_type decode(char32_t& codePoint) const noexcept;
+		
+		private:
+			const char* m_position {};
+			
+			const char* m_end {};
+		};
+		
+		/// Range of code points, for use in range-based for
+		struct TCodePoints
+		{
+			TCodePointIterator begin_;
+			
+			TCodePointIterator end_;
+			
+			TCodePointIterator begin() const noexcept
+			{
+				return begin_;
+			}
+			
+			TCodePointIterator end() const noexcept
+			{
+				return end_;
+			}
+		};
+	
+	public:
+		TUtf8String() = default;
+		
+		TUtf8String(const std::string& string);
+		
+		TUtf8String(std::string&& string) noexcept;
+		
+		TUtf8String(std::string_view string);
+		
+		TUtf8String(const char* string);
+		
+		/**
+		 * Transcodes UTF-16 string, so existing ICU strings may be passed where
+		 * UTF-8 ones are expected.
+		 * */
+		TUtf8String(const icu::UnicodeString& string);
+		
+		#ifdef HAS_QSTRING
+		
+		TUtf8String(const QString& string);
+		
+		QString asCustom() const;
+		
+		#endif
+		
+		std::string_view view() const noexcept
+		{
+			return m_string;
+		}
+		
+		/// Bytes of string, without conversion
+		const std::string& asUTF8() const noexcept
+		{
+			return m_string;
+		}
+		
+		const char* data() const noexcept
+		{
+			return m_string.data();
+		}
+		
+		const char* c_str() const noexcept
+		{
+			return m_string.c_str();
+		}
+		
+		/// Length in bytes
+		size_type size() const noexcept
+		{
+			return m_string.size();
+		}
+		
+		/// Length in bytes
+		size_type length() const noexcept
+		{
+			return m_string.size();
+		}
+		
+		bool empty() const noexcept
+		{
+			return m_string.empty();
+		}
+		
+		void clear() noexcept
+		{
+			m_string.clear();
+		}
+		
+		TCodePointIterator codePointBegin() const noexcept
+		{
+			return TCodePointIterator(m_string.data(), m_string.data() + m_string.size());
+		}
+		
+		TCodePointIterator codePointEnd() const noexcept
+		{
+			const auto __end = m_string.data() + m_string.size();
+			return TCodePointIterator(__end, __end);
+		}
+		
+		/**
+		 * \code
+		 * for (char32_t __codePoint : __value.codePoints())
+		 * \endcode
+		 * */
+		TCodePoints codePoints() const noexcept
+		{
+			return { codePointBegin(), codePointEnd() };
+		}
+		
+		size_type countCodePoints() const noexcept;
+		
+		/// Copy as ICU string, transcoded to UTF-16
+		TUnicodeString toUnicode() const;
+		
+		operator TUnicodeString() const
+		{
+			return toUnicode();
+		}
+		
+		TSelf& append(std::string_view string);
+		
+		TSelf& append(const std::string& string)
+		{
+			return append(std::string_view(string));
+		}
+		
+		TSelf& append(const char* string)
+		{
+			return append(std::string_view(string));
+		}
+		
+		TSelf& append(const TSelf& self);
+		
+		/// Appends encoded code point
+		TSelf& append(char32_t codePoint);
+		
+		TSelf& operator+=(std::string_view string)
+		{
+			return append(string);
+		}
+		
+		int compare(std::string_view string) const noexcept
+		{
+			return view().compare(string);
+		}
+		
+		int compare(const TSelf& self) const noexcept
+		{
+			return m_string.compare(self.m_string);
+		}
+		
+		bool operator==(const TSelf& self) const noexcept
+		{
+			return m_string == self.m_string;
+		}
+		
+		bool operator!=(const TSelf& self) const noexcept
+		{
+			return m_string != self.m_string;
+		}
+		
+		bool operator==(const std::string& string) const noexcept
+		{
+			return m_string == string;
+		}
+		
+		bool operator!=(const std::string& string) const noexcept
+		{
+			return m_string != string;
+		}
+		
+		bool operator==(std::string_view string) const noexcept
+		{
+			return view() == string;
+		}
+		
+		bool operator!=(std::string_view string) const noexcept
+		{
+			return view() != string;
+		}
+		
+		bool operator==(const char* string) const noexcept
+		{
+			return view() == string;
+		}
+		
+		bool operator!=(const char* string) const noexcept
+		{
+			return view() != string;
+		}
+		
+		/// Byte-wise, which orders UTF-8 strings by code points
+		bool operator<(const TSelf& self) const noexcept
+		{
+			return m_string < self.m_string;
+		}
+		
+		bool operator>(const TSelf& self) const noexcept
+		{
+			return m_string > self.m_string;
+		}
+		
+		bool operator<=(const TSelf& self) const noexcept
+		{
+			return m_string <= self.m_string;
+		}
+		
+		bool operator>=(const TSelf& self) const noexcept
+		{
+			return m_string >= self.m_string;
+		}
+		
+		/**
+		 * \brief Parses number at start of string, without allocating or throwing.
+		 * \code
+		 * Int32 __fontSize {};
+		 * if (not __value.parse(__fontSize))
+		 * 	__fontSize = kDefaultFontSize;
+		 * \endcode
+		 * \see parseNumber
+		 * */
+		template<typename TNumber>
+		TParseResult parse(TNumber& value, int base = 10) const noexcept
+		{
+			return parseNumber(m_string.data(), m_string.data() + m_string.size(), value, base);
+		}
+		
+		inline operator int() const
+		{
+			return toNumber<int>();
+		}
+		
+		inline operator long() const
+		{
+			return toNumber<long>();
+		}
+		
+		inline operator long long() const
+		{
+			return toNumber<long long>();
+		}
+		
+		inline operator unsigned long() const
+		{
+			return toNumber<unsigned long>();
+		}
+		
+		inline operator unsigned long long() const
+		{
+			return toNumber<unsigned long long>();
+		}
+		
+		inline operator float() const
+		{
+			return toNumber<float>();
+		}
+		
+		inline operator double() const
+		{
+			return toNumber<double>();
+		}
+	
+	private:
+		/// Implicit conversions, throwing TParseException or TRangeException on failure
+		template<typename TNumber>
+		TNumber toNumber() const
+		{
+			TNumber __nm {};
+			const auto __result = parse(__nm);
+			if (not __result)
+				throwParseError(__result, m_string);
+			return __nm;
+		}
+	
+	private:
+		std::string m_string;
+	};
+}
@@ -328,7 +328,7 @@ namespace Dixter
 				while (__pos != TString::npos)
 				{
 					__pos = str.find(separator, __start);
-					__container.push_back(str.substr(__start, __pos - __start + 1));
+					__container.push_back(str.substr(__start, __pos - __start));
 					__start = __pos + 1;
 				}
 				
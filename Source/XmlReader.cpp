@@ -0,0 +1,308 @@
+/**
+ *  Copyright (C) 2015-2019
+ *  Author Alvin Ahmadov <alvin.dev.ahmadov@gmail.com>
+ *
+ *  This file is part of Dixter Project
+ *  License-Identifier: MIT License
+ *  See README.md for more information.
+ */
+
+#include <fstream>
+#include <iterator>
+#include <algorithm>
+
+#include "Exception.hpp"
+#include "Transcoder.hpp"
+#include "XmlReader.hpp"
+
+namespace Dixter
+{
+	namespace
+	{
+		inline bool isSpace(TByte c) noexcept
+		{
+			return c == ' ' or c == '\t' or c == '\n' or c == '\r';
+		}
+		
+		inline bool isNameChar(TByte c) noexcept
+		{
+			return not isSpace(c) and c != '>' and c != '/' and c != '=' and c != '<'
+				   and c != '"' and c != '\'' and c != '\0';
+		}
+		
+		/// Char production of XML 1.0, references to anything else are errors
+		inline bool isXmlChar(UInt32 codePoint) noexcept
+		{
+			return codePoint == 0x9 or codePoint == 0xA or codePoint == 0xD
+				   or ( codePoint >= 0x20 and codePoint <= 0xD7FF )
+				   or ( codePoint >= 0xE000 and codePoint <= 0xFFFD )
+				   or ( codePoint >= 0x10000 and codePoint <= Unicode::kMaxCodePoint );
+		}
+	} // anonymous namespace
+	
+	TXmlReader::TXmlReader(IXmlHandler& handler) noexcept
+			: m_handler(handler),
+			  m_document(),
+			  m_position(),
+			  m_text(),
+			  m_values(),
+			  m_attributes(),
+			  m_elements()
+	{ }
+	
+	void TXmlReader::parse(TStringView document)
+	{
+		m_document = document;
+		m_position = 0;
+		m_text.clear();
+		m_elements.clear();
+		
+		// UTF-8 byte order mark
+		if (m_document.substr(0, 3) == "\xEF\xBB\xBF")
+			m_position = 3;
+		
+		while (m_position < m_document.size())
+		{
+			const auto __tag = m_document.find('<', m_position);
+			const auto __end = __tag == TStringView::npos ? m_document.size() : __tag;
+			if (not m_elements.empty())
+				appendText(m_text, m_document.substr(m_position, __end - m_position));
+			m_position = __end;
+			
+			if (__tag != TStringView::npos)
+				parseMarkup();
+		}
+		
+		if (not m_elements.empty())
+			fail("Unexpected end of document");
+	}
+	
+	void TXmlReader::parseFile(const TString& path)
+	{
+		std::ifstream __file(path, std::ios::binary);
+		if (not __file)
+			throw TNotFoundException("%s:%d Can't read \"%s\".", __FILE__, __LINE__, path);
+		
+		const TString __document { std::istreambuf_iterator<TByte>(__file), std::istreambuf_iterator<TByte>() };
+		parse(__document);
+	}
+	
+	void TXmlReader::parseMarkup()
+	{
+		const auto __markup = m_document.substr(m_position);
+		if (__markup.compare(0, 4, "<!--") == 0)
+			skipPast("-->");
+		else if (__markup.compare(0, 9, "<![CDATA[") == 0)
+		{
+			const auto __end = m_document.find("]]>", m_position + 9);
+			if (__end == TStringView::npos)
+				fail("Unterminated CDATA section");
+			
+			m_text.append(m_document.substr(m_position + 9, __end - m_position - 9));
+			m_position = __end + 3;
+		}
+		else if (__markup.compare(0, 2, "<?") == 0)
+			skipPast("?>");
+		else if (__markup.compare(0, 2, "<!") == 0)
+			skipDoctype();
+		else if (__markup.compare(0, 2, "</") == 0)
+			parseEndTag();
+		else
+			parseStartTag();
+	}
+	
+	void TXmlReader::parseStartTag()
+	{
+		flushText();
+		++m_position;
+		const auto __name = parseName();
+		
+		m_values.clear();
+		m_attributes.clear();
+		std::vector<TStringView> __names;
+		while (true)
+		{
+			skipSpaces();
+			if (m_position >= m_document.size())
+				fail("Unterminated start tag");
+			
+			const auto __c = m_document[m_position];
+			if (__c == '>' or __c == '/')
+				break;
+			
+			__names.push_back(parseName());
+			skipSpaces();
+			if (m_position >= m_document.size() or m_document[m_position] != '=')
+				fail("Expected '=' after attribute name");
+			
+			++m_position;
+			skipSpaces();
+			const auto __quote = m_position < m_document.size() ? m_document[m_position] : '\0';
+			if (__quote != '"' and __quote != '\'')
+				fail("Expected quoted attribute value");
+			
+			const auto __end = m_document.find(__quote, m_position + 1);
+			if (__end == TStringView::npos)
+				fail("Unterminated attribute value");
+			
+			m_values.emplace_back();
+			appendText(m_values.back(), m_document.substr(m_position + 1, __end - m_position - 1));
+			m_position = __end + 1;
+		}
+		// views are taken once values stopped growing
+		for (TSize __index {}; __index < __names.size(); ++__index)
+			m_attributes.emplace_back(__names[__index], m_values[__index]);
+		
+		const bool __empty(m_document[m_position] == '/');
+		if (__empty and ( m_position + 1 >= m_document.size() or m_document[m_position + 1] != '>' ))
+			fail("Expected '>' after '/'");
+		
+		m_position += __empty ? 2 : 1;
+		m_elements.push_back(__name);
+		m_handler.onStartElement(__name, m_attributes);
+		if (__empty)
+		{
+			m_elements.pop_back();
+			m_handler.onEndElement(__name);
+		}
+	}
+	
+	void TXmlReader::parseEndTag()
+	{
+		flushText();
+		m_position += 2;
+		const auto __name = parseName();
+		skipSpaces();
+		if (m_position >= m_document.size() or m_document[m_position] != '>')
+			fail("Expected '>' in end tag");
+		
+		++m_position;
+		if (m_elements.empty() or m_elements.back() != __name)
+			fail("Mismatched end tag");
+		
+		m_elements.pop_back();
+		m_handler.onEndElement(__name);
+	}
+	
+	void TXmlReader::skipPast(TStringView terminator)
+	{
+		const auto __end = m_document.find(terminator, m_position);
+		if (__end == TStringView::npos)
+			fail("Unterminated markup");
+		
+		m_position = __end + terminator.size();
+	}
+	
+	void TXmlReader::skipDoctype()
+	{
+		// internal subset may hold '>' inside brackets
+		TSize __depth {};
+		for (; m_position < m_document.size(); ++m_position)
+		{
+			const auto __c = m_document[m_position];
+			if (__c == '[')
+				++__depth;
+			else if (__c == ']' and __depth)
+				--__depth;
+			else if (__c == '>' and not __depth)
+			{
+				++m_position;
+				return;
+			}
+		}
+		fail("Unterminated document type declaration");
+	}
+	
+	TStringView TXmlReader::parseName()
+	{
+		const auto __begin = m_position;
+		while (m_position < m_document.size() and isNameChar(m_document[m_position]))
+			++m_position;
+		
+		if (__begin == m_position)
+			fail("Expected name");
+		
+		return m_document.substr(__begin, m_position - __begin);
+	}
+	
+	void TXmlReader::skipSpaces() noexcept
+	{
+		while (m_position < m_document.size() and isSpace(m_document[m_position]))
+			++m_position;
+	}
+	
+	void TXmlReader::flushText()
+	{
+		if (not m_text.empty())
+		{
+			m_handler.onText(m_text);
+			m_text.clear();
+		}
+	}
+	
+	void TXmlReader::appendText(TString& target, TStringView text) const
+	{
+		target.reserve(target.size() + text.size());
+		for (TSize __index {}; __index < text.size();)
+		{
+			const auto __amp = text.find('&', __index);
+			target.append(text.substr(__index, __amp - __index));
+			if (__amp == TStringView::npos)
+				break;
+			
+			const auto __semicolon = text.find(';', __amp);
+			if (__semicolon == TStringView::npos)
+				fail("Unterminated entity reference");
+			
+			const auto __entity = text.substr(__amp + 1, __semicolon - __amp - 1);
+			if (__entity == "lt")
+				target.push_back('<');
+			else if (__entity == "gt")
+				target.push_back('>');
+			else if (__entity == "amp")
+				target.push_back('&');
+			else if (__entity == "quot")
+				target.push_back('"');
+			else if (__entity == "apos")
+				target.push_back('\'');
+			else if (__entity.size() > 1 and __entity[0] == '#')
+			{
+				const bool __hex(__entity[1] == 'x' or __entity[1] == 'X');
+				const auto __digits = __entity.substr(__hex ? 2 : 1);
+				UInt32 __codePoint {};
+				for (auto __c : __digits)
+				{
+					UInt32 __digit {};
+					if (__c >= '0' and __c <= '9')
+						__digit = static_cast<UInt32>(__c - '0');
+					else if (__hex and __c >= 'a' and __c <= 'f')
+						__digit = static_cast<UInt32>(__c - 'a' + 10);
+					else if (__hex and __c >= 'A' and __c <= 'F')
+						__digit = static_cast<UInt32>(__c - 'A' + 10);
+					else
+						fail("Invalid character reference");
+					
+					__codePoint = __codePoint * ( __hex ? 16 : 10 ) + __digit;
+					if (__codePoint > 0x10FFFF)
+						fail("Invalid character reference");
+				}
+				if (__digits.empty() or not isXmlChar(__codePoint))
+					fail("Invalid character reference");
+				
+				TByte __bytes[4];
+				target.append(__bytes, Unicode::encodeUtf8(__codePoint, __bytes));
+			}
+			else
+				fail("Unknown entity reference");
+			
+			__index = __semicolon + 1;
+		}
+	}
+	
+	void TXmlReader::fail(const char* message) const
+	{
+		const auto __end = std::min(m_position, m_document.size());
+		const auto __line = 1 + std::count(m_document.begin(), m_document.begin() + __end, '\n');
+		throw TParseException("%s:%d %s at line %u", __FILE__, __LINE__, message, static_cast<UInt32>(__line));
+	}
+} // namespace Dixter
@@ -0,0 +1,107 @@
+/**
+ *  Copyright (C) 2015-2019
+ *  Author Alvin Ahmadov <alvin.dev.ahmadov@gmail.com>
+ *
+ *  This file is part of Dixter Project
+ *  License-Identifier: MIT License
+ *  See README.md for more information.
+ */
+#pragma once
+
+#include <vector>
+#include <utility>
+
+#include "Commons.hpp"
+
+namespace Dixter
+{
+	/**
+	 * \interface IXmlHandler
+	 * \brief Receives events of TXmlReader in document order.
+	 *
+	 * Views passed to handler are valid during the call only.
+	 * */
+	struct IXmlHandler
+	{
+		using TAttribute = std::pair<TStringView, TStringView>;
+		using TAttributeList = std::vector<TAttribute>;
+		
+		virtual void onStartElement(TStringView name, const TAttributeList& attributes) = 0;
+		
+		/**
+		 * Character data of element up to the next tag, with entities
+		 * decoded and CDATA sections merged in.
+		 * */
+		virtual void onText(TStringView text) = 0;
+		
+		virtual void onEndElement(TStringView name) = 0;
+		
+		virtual ~IXmlHandler() = default;
+	};
+	
+	/**
+	 * \class TXmlReader
+	 * \brief Single pass event based XML reader.
+	 *
+	 * Reports elements to handler as they are read instead of building
+	 * a tree. Reader has no shared state, so documents can be read
+	 * on several threads at once. Processing instructions, comments and
+	 * document type declaration are skipped. Text is expected to be UTF-8.
+	 * */
+	class TXmlReader : public TNonCopyable
+	{
+	public:
+		explicit TXmlReader(IXmlHandler& handler) noexcept;
+		
+		~TXmlReader() noexcept override = default;
+		
+		/**
+		 * \throws TParseException on malformed document.
+		 * */
+		void parse(TStringView document);
+		
+		/**
+		 * \throws TNotFoundException if file can't be read.
+		 * \throws TParseException on malformed document.
+		 * */
+		void parseFile(const TString& path);
+	
+	private:
+		void parseMarkup();
+		
+		void parseStartTag();
+		
+		void parseEndTag();
+		
+		void skipPast(TStringView terminator);
+		
+		void skipDoctype();
+		
+		TStringView parseName();
+		
+		void skipSpaces() noexcept;
+		
+		void flushText();
+		
+		/// Appends text decoding entities
+		void appendText(TString& target, TStringView text) const;
+		
+		[[noreturn]] void fail(const char* message) const;
+	
+	private:
+		IXmlHandler& m_handler;
+		
+		TStringView m_document;
+		
+		TSize m_position;
+		
+		TString m_text;
+		
+		/// Decoded attribute values, owned until handler returns
+		std::vector<TString> m_values;
+		
+		IXmlHandler::TAttributeList m_attributes;
+		
+		std::vector<TStringView> m_elements;
+	};
+} // namespace Dixter
@@ -0,0 +1,124 @@
+/**
+ *  Copyright (C) 2015-2019
+ *  Author Alvin Ahmadov <alvin.dev.ahmadov@gmail.com>
+ *
+ *  This file is part of Dixter Project
+ *  License-Identifier: MIT License
+ *  See README.md for more information.
+ */
+
+/**
+ * Load time of language and voice catalogues with XML and JSON backends.
+ * Usage: DixterConfig [resources_dir] [runs]
+ * Uncached loads remove binary image of the catalogue before every run,
+ * so the parser runs each time; image write after parsing is included.
+ * Exits with 1 if both formats don't give the same values.
+ * */
+
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+
+#include "Macros.hpp"
+#include "Exception.hpp"
+#include "Constants.hpp"
+#include "Configuration.hpp"
+#include "ConfigurationCache.hpp"
+
+using namespace Dixter;
+
+using TClock = std::chrono::steady_clock;
+
+template<typename TConfiguration>
+static Real32 averageLoad(const TString& path, TSize runs, bool cached)
+{
+	TClock::duration __total {};
+	for (TSize __run {}; __run < runs; ++__run)
+	{
+		if (not cached)
+			boost::filesystem::remove(TConfigurationCache(path).getPath());
+		
+		const auto __start = TClock::now();
+		TConfiguration(path).load();
+		__total += TClock::now() - __start;
+	}
+	return std::chrono::duration<Real32, std::micro>(__total).count() / static_cast<Real32>(runs);
+}
+
+template<typename TConfiguration>
+static std::vector<TU8String> valuesOf(const TString& path, const TString& key)
+{
+	std::vector<TU8String> __values {};
+	TConfiguration __configuration(path);
+	__configuration.load();
+	__configuration.get(key, __values);
+	return __values;
+}
+
+static bool compare(const TString& xmlPath, const TString& jsonPath, const std::vector<TString>& keys)
+{
+	bool __equal { true };
+	for (const auto& __key : keys)
+	{
+		const auto __xml = valuesOf<TConfigurationXML>(xmlPath, __key);
+		const auto __json = valuesOf<TConfigurationJSON>(jsonPath, __key);
+		if (__xml.size() != __json.size())
+		{
+			std::printf("%s: %zu values in XML, %zu in JSON\n", __key.c_str(), __xml.size(), __json.size());
+			__equal = false;
+			continue;
+		}
+		for (TSize __index {}; __index < __xml.size(); ++__index)
+		{
+			if (__xml[__index].asUTF8() != __json[__index].asUTF8())
+			{
+				std::printf("%s[%zu]: \"%s\" in XML, \"%s\" in JSON\n", __key.c_str(), __index,
+							__xml[__index].asUTF8().c_str(), __json[__index].asUTF8().c_str());
+				__equal = false;
+			}
+		}
+	}
+	return __equal;
+}
+
+static void benchmark(const TString& name, const TString& xmlPath, const TString& jsonPath, TSize runs)
+{
+	std::printf("%-10s uncached: %8.1f us XML, %8.1f us JSON\n", name.c_str(),
+				averageLoad<TConfigurationXML>(xmlPath, runs, false),
+				averageLoad<TConfigurationJSON>(jsonPath, runs, false));
+	std::printf("%-10s cached:   %8.1f us XML, %8.1f us JSON\n", name.c_str(),
+				averageLoad<TConfigurationXML>(xmlPath, runs, true),
+				averageLoad<TConfigurationJSON>(jsonPath, runs, true));
+}
+
+int main(int argc, char** argv)
+{
+	const TString __resources(argc > 1 ? argv[1] : "/usr/local/share/dixter/Resources");
+	const TSize __runs(argc > 2 ? std::stoul(argv[2]) : 2000UL);
+	
+	const TString __languagesXml(__resources + "/languages.xml"), __languagesJson(__resources + "/languages.json");
+	const TString __voicesXml(__resources + "/voices.xml"), __voicesJson(__resources + "/voices.json");
+	
+	try
+	{
+		const bool __equal = compare(__languagesXml, __languagesJson,
+									 { NodeKey::kLangIdNode, NodeKey::kLangNameNode, NodeKey::kLangNameDisplayNode,
+									   NodeKey::kLangStructureNode, NodeKey::kLangColumnsNode })
+							 and compare(__voicesXml, __voicesJson, { NodeKey::kVoiceNameNode, NodeKey::kVoiceValueNode });
+		if (not __equal)
+			return 1;
+		
+		std::printf("Average load time over %zu runs\n", __runs);
+		benchmark("languages", __languagesXml, __languagesJson, __runs);
+		benchmark("voices", __voicesXml, __voicesJson, __runs);
+	}
+	catch (std::exception& e)
+	{
+		printerr(e.what())
+		return 1;
+	}
+	
+	return 0;
+}
@@ -0,0 +1,398 @@
+/**
+ *  Copyright (C) 2015-2019
+ *  Author Alvin Ahmadov <alvin.dev.ahmadov@gmail.com>
+ *
+ *  This file is part of Dixter Project
+ *  License-Identifier: MIT License
+ *  See README.md for more information.
+ */
+
+/**
+ * Cross-checks Unicode transcoder against ICU.
+ * Usage: DixterTranscoder [seed] [runs]
+ * Every conversion and length function is run on random valid and malformed text
+ * of lengths that are mostly not multiples of 16, shifted against block boundaries:
+ * - valid text converts as ICU converts it, length functions give the exact size
+ * - malformed text is rejected exactly when ICU rejects it
+ * - conversion never writes past size given by length function
+ * - text converted whole, through SIMD blocks, equals text converted in pieces shorter
+ *   than a block, which take scalar path only
+ * Exits with 1 if any check fails, first failures are printed.
+ * */
+
+#include <cstdio>
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <unicode/ustring.h>
+
+#include "Transcoder.hpp"
+
+using namespace Dixter;
+
+namespace
+{
+	using TUtf8 = std::string;
+	using TUtf16 = std::u16string;
+	using TUtf32 = std::u32string;
+	
+	/// Units past the size given by length function, must stay untouched
+	constexpr TSize kGuard = 64;
+	
+	constexpr TSize kMaxReported = 20;
+	
+	TSize g_failures {};
+	
+	TSize g_checks {};
+	
+	void fail(const char* function, const char* what, const TString& input)
+	{
+		if (++g_failures > kMaxReported)
+			return;
+		std::printf("%s: %s, input:", function, what);
+		for (auto __byte : input)
+			std::printf(" %02x", static_cast<TUByte>(__byte));
+		std::printf("\n");
+	}
+	
+	template<typename TText>
+	TString bytesOf(const TText& text)
+	{
+		return TString(reinterpret_cast<const TByte*>(text.data()), text.size() * sizeof(typename TText::value_type));
+	}
+	
+	/// ICU conversions, false if input is malformed
+	bool icuUtf8ToUtf16(const TUtf8& source, TUtf16& target)
+	{
+		UErrorCode __error = U_ZERO_ERROR;
+		int32_t __length {};
+		u_strFromUTF8(nullptr, 0, &__length, source.data(), static_cast<int32_t>(source.size()), &__error);
+		if (__error != U_BUFFER_OVERFLOW_ERROR and U_FAILURE(__error))
+			return false;
+		
+		target.assign(static_cast<TSize>(__length), u'\0');
+		__error = U_ZERO_ERROR;
+		u_strFromUTF8(reinterpret_cast<UChar*>(&target[0]), __length, &__length,
+					  source.data(), static_cast<int32_t>(source.size()), &__error);
+		return U_SUCCESS(__error);
+	}
+	
+	bool icuUtf16ToUtf8(const TUtf16& source, TUtf8& target)
+	{
+		UErrorCode __error = U_ZERO_ERROR;
+		int32_t __length {};
+		const auto __source = reinterpret_cast<const UChar*>(source.data());
+		u_strToUTF8(nullptr, 0, &__length, __source, static_cast<int32_t>(source.size()), &__error);
+		if (__error != U_BUFFER_OVERFLOW_ERROR and U_FAILURE(__error))
+			return false;
+		
+		target.assign(static_cast<TSize>(__length), '\0');
+		__error = U_ZERO_ERROR;
+		u_strToUTF8(&target[0], __length, &__length, __source, static_cast<int32_t>(source.size()), &__error);
+		return U_SUCCESS(__error);
+	}
+	
+	bool icuUtf16ToUtf32(const TUtf16& source, TUtf32& target)
+	{
+		UErrorCode __error = U_ZERO_ERROR;
+		int32_t __length {};
+		const auto __source = reinterpret_cast<const UChar*>(source.data());
+		u_strToUTF32(nullptr, 0, &__length, __source, static_cast<int32_t>(source.size()), &__error);
+		if (__error != U_BUFFER_OVERFLOW_ERROR and U_FAILURE(__error))
+			return false;
+		
+		target.assign(static_cast<TSize>(__length), U'\0');
+		__error = U_ZERO_ERROR;
+		u_strToUTF32(reinterpret_cast<UChar32*>(&target[0]), __length, &__length,
+					 __source, static_cast<int32_t>(source.size()), &__error);
+		return U_SUCCESS(__error);
+	}
+	
+	bool icuUtf32ToUtf16(const TUtf32& source, TUtf16& target)
+	{
+		UErrorCode __error = U_ZERO_ERROR;
+		int32_t __length {};
+		const auto __source = reinterpret_cast<const UChar32*>(source.data());
+		u_strFromUTF32(nullptr, 0, &__length, __source, static_cast<int32_t>(source.size()), &__error);
+		if (__error != U_BUFFER_OVERFLOW_ERROR and U_FAILURE(__error))
+			return false;
+		
+		target.assign(static_cast<TSize>(__length), u'\0');
+		__error = U_ZERO_ERROR;
+		u_strFromUTF32(reinterpret_cast<UChar*>(&target[0]), __length, &__length,
+					   __source, static_cast<int32_t>(source.size()), &__error);
+		return U_SUCCESS(__error);
+	}
+	
+	template<typename TSource, typename TTarget>
+	struct TDirection
+	{
+		using TSourceUnit = typename TSource::value_type;
+		using TTargetUnit = typename TTarget::value_type;
+		
+		const char* name_;
+		
+		TSize (* length_)(const TSourceUnit*, TSize) noexcept;
+		
+		TSize (* convert_)(const TSourceUnit*, TSize, TTargetUnit*) noexcept;
+		
+		bool (* reference_)(const TSource&, TTarget&);
+	};
+	
+	template<typename TSource, typename TTarget>
+	TSize convert(const TDirection<TSource, TTarget>& direction, const TSource& source, TTarget& target)
+	{
+		const auto __length = direction.length_(source.data(), source.size());
+		const auto __sentinel = static_cast<typename TTarget::value_type>(0x5A);
+		target.assign(__length + kGuard, __sentinel);
+		const auto __written = direction.convert_(source.data(), source.size(), &target[0]);
+		
+		for (TSize __index = __length; __index < target.size(); ++__index)
+		{
+			if (target[__index] != __sentinel)
+			{
+				fail(direction.name_, "wrote past size given by length function", bytesOf(source));
+				break;
+			}
+		}
+		target.resize(__written == Unicode::kInvalid ? 0 : std::min(__written, __length));
+		return __written;
+	}
+	
+	inline bool isContinuation(TByte unit) noexcept
+	{
+		return ( static_cast<TUByte>(unit) & 0xC0 ) == 0x80;
+	}
+	
+	inline bool isContinuation(char16_t unit) noexcept
+	{
+		return unit >= 0xDC00 and unit <= 0xDFFF;
+	}
+	
+	inline bool isContinuation(TCodePoint) noexcept
+	{
+		return false;
+	}
+	
+	/// Pieces shorter than a block, not splitting code points
+	template<typename TText>
+	std::vector<TText> split(const TText& text, std::mt19937& random)
+	{
+		std::vector<TText> __pieces {};
+		TSize __begin {};
+		while (__begin < text.size())
+		{
+			// at most 3 continuation units are added to 12 units
+			auto __end = std::min(text.size(), __begin + 1 + random() % 12);
+			while (__end < text.size() and isContinuation(text[__end]))
+				++__end;
+			__pieces.push_back(text.substr(__begin, __end - __begin));
+			__begin = __end;
+		}
+		return __pieces;
+	}
+	
+	template<typename TSource, typename TTarget>
+	void check(const TDirection<TSource, TTarget>& direction, const TSource& source, std::mt19937& random)
+	{
+		++g_checks;
+		TTarget __expected {}, __actual {};
+		const bool __valid = direction.reference_(source, __expected);
+		const auto __written = convert(direction, source, __actual);
+		
+		if (not __valid)
+		{
+			if (__written != Unicode::kInvalid)
+				fail(direction.name_, "malformed input accepted", bytesOf(source));
+			return;
+		}
+		if (__written == Unicode::kInvalid)
+		{
+			fail(direction.name_, "valid input rejected", bytesOf(source));
+			return;
+		}
+		if (__actual != __expected)
+			fail(direction.name_, "differs from ICU", bytesOf(source));
+		if (direction.length_(source.data(), source.size()) != __expected.size())
+			fail(direction.name_, "length function differs from ICU", bytesOf(source));
+		
+		TTarget __joined {};
+		for (const auto& __piece : split(source, random))
+		{
+			TTarget __converted {};
+			convert(direction, __piece, __converted);
+			__joined += __converted;
+		}
+		if (__joined != __actual)
+			fail(direction.name_, "conversion in blocks differs from conversion in pieces", bytesOf(source));
+	}
+	
+	/// Code points in runs of ASCII, so blocks are taken, mixed with every UTF-8 length
+	TUtf32 randomText(std::mt19937& random, TSize length)
+	{
+		TUtf32 __text {};
+		while (__text.size() < length)
+		{
+			switch (random() % 6)
+			{
+				case 0:
+				case 1:
+				{
+					const auto __run = 1 + random() % 40;
+					for (TSize __index {}; __index < __run; ++__index)
+						__text.push_back(static_cast<TCodePoint>(random() % 0x80));
+					break;
+				}
+				case 2:
+					__text.push_back(static_cast<TCodePoint>(0x80 + random() % ( 0x800 - 0x80 )));
+					break;
+				case 3:
+				{
+					TCodePoint __codePoint {};
+					do
+						__codePoint = static_cast<TCodePoint>(0x800 + random() % ( 0x10000 - 0x800 ));
+					while (__codePoint >= 0xD800 and __codePoint <= 0xDFFF);
+					__text.push_back(__codePoint);
+					break;
+				}
+				case 4:
+					__text.push_back(static_cast<TCodePoint>(0x10000 + random() % ( Unicode::kMaxCodePoint + 1 - 0x10000 )));
+					break;
+				default:
+				{
+					// values at edges of ranges
+					static const TCodePoint s_edges[] { 0x7F, 0x80, 0x7FF, 0x800, 0xD7FF, 0xE000, 0xFFFD,
+														0xFFFF, 0x10000, Unicode::kMaxCodePoint };
+					__text.push_back(s_edges[random() % ( sizeof(s_edges) / sizeof(s_edges[0]))]);
+					break;
+				}
+			}
+		}
+		__text.resize(length);
+		return __text;
+	}
+	
+	/// Replaces random unit by random value, so text is most likely malformed
+	template<typename TText>
+	TText corrupt(TText text, std::mt19937& random, UInt32 valueMask)
+	{
+		if (not text.empty())
+			text[random() % text.size()] = static_cast<typename TText::value_type>(random() & valueMask);
+		return text;
+	}
+	
+	/// Malformed sequences ICU and transcoder are expected to reject
+	const std::vector<TUtf8> g_malformedUtf8 {
+			"\x80", "\xBF", "\xC0\x80", "\xC1\xBF", "\xE0\x80\x80", "\xE0\x9F\xBF", "\xF0\x80\x80\x80",
+			"\xF0\x8F\xBF\xBF", "\xED\xA0\x80", "\xED\xBF\xBF", "\xF4\x90\x80\x80", "\xF5\x80\x80\x80",
+			"\xF8\x88\x80\x80\x80", "\xFE", "\xFF", "\xC3", "\xE2\x82", "\xF0\x9F\x98", "\xC3\x28", "\xE2\x28\xA1"
+	};
+	
+	const std::vector<TUtf16> g_malformedUtf16 {
+			u"\xD800", u"\xDC00", u"\xDBFF\x0041", u"\xDC00\xD800", u"\xD800\xD800\xDC00"
+	};
+	
+	const std::vector<TUtf32> g_malformedUtf32 {
+			U"\xD800", U"\xDFFF", TUtf32(1, static_cast<TCodePoint>(0x110000)), TUtf32(1, static_cast<TCodePoint>(0xFFFFFFFF))
+	};
+	
+	template<typename TText>
+	TText padded(const TText& text, TSize before, TSize after)
+	{
+		using TUnit = typename TText::value_type;
+		return TText(before, static_cast<TUnit>('a')) + text + TText(after, static_cast<TUnit>('z'));
+	}
+} // anonymous namespace
+
+int main(int argc, char** argv)
+{
+	const auto __seed = static_cast<UInt32>(argc > 1 ? std::stoul(argv[1]) : 20191015UL);
+	const TSize __runs(argc > 2 ? std::stoul(argv[2]) : 2000UL);
+	std::mt19937 __random(__seed);
+	
+	const TDirection<TUtf8, TUtf16> __utf8ToUtf16 {
+			"UTF-8 to UTF-16", &Unicode::utf16LengthFromUtf8, &Unicode::convertUtf8ToUtf16, &icuUtf8ToUtf16 };
+	const TDirection<TUtf8, TUtf32> __utf8ToUtf32 {
+			"UTF-8 to UTF-32", &Unicode::utf32LengthFromUtf8, &Unicode::convertUtf8ToUtf32,
+			[](const TUtf8& source, TUtf32& target) {
+				TUtf16 __utf16 {};
+				return icuUtf8ToUtf16(source, __utf16) and icuUtf16ToUtf32(__utf16, target);
+			}};
+	const TDirection<TUtf16, TUtf8> __utf16ToUtf8 {
+			"UTF-16 to UTF-8", &Unicode::utf8LengthFromUtf16, &Unicode::convertUtf16ToUtf8, &icuUtf16ToUtf8 };
+	const TDirection<TUtf16, TUtf32> __utf16ToUtf32 {
+			"UTF-16 to UTF-32", &Unicode::utf32LengthFromUtf16, &Unicode::convertUtf16ToUtf32, &icuUtf16ToUtf32 };
+	const TDirection<TUtf32, TUtf8> __utf32ToUtf8 {
+			"UTF-32 to UTF-8", &Unicode::utf8LengthFromUtf32, &Unicode::convertUtf32ToUtf8,
+			[](const TUtf32& source, TUtf8& target) {
+				TUtf16 __utf16 {};
+				return icuUtf32ToUtf16(source, __utf16) and icuUtf16ToUtf8(__utf16, target);
+			}};
+	const TDirection<TUtf32, TUtf16> __utf32ToUtf16 {
+			"UTF-32 to UTF-16", &Unicode::utf16LengthFromUtf32, &Unicode::convertUtf32ToUtf16, &icuUtf32ToUtf16 };
+	
+	for (TSize __run {}; __run < __runs; ++__run)
+	{
+		const auto __utf32 = randomText(__random, __random() % 100);
+		TUtf16 __utf16 {};
+		TUtf8 __utf8 {};
+		icuUtf32ToUtf16(__utf32, __utf16);
+		icuUtf16ToUtf8(__utf16, __utf8);
+		
+		check(__utf8ToUtf16, __utf8, __random);
+		check(__utf8ToUtf32, __utf8, __random);
+		check(__utf16ToUtf8, __utf16, __random);
+		check(__utf16ToUtf32, __utf16, __random);
+		check(__utf32ToUtf8, __utf32, __random);
+		check(__utf32ToUtf16, __utf32, __random);
+		
+		const auto __badUtf8 = corrupt(__utf8, __random, 0xFF);
+		const auto __badUtf16 = corrupt(__utf16, __random, 0xFFFF);
+		const auto __badUtf32 = corrupt(__utf32, __random, ( __random() % 2 ) ? 0x1FFFFF : 0xFFFF);
+		check(__utf8ToUtf16, __badUtf8, __random);
+		check(__utf8ToUtf32, __badUtf8, __random);
+		check(__utf16ToUtf8, __badUtf16, __random);
+		check(__utf16ToUtf32, __badUtf16, __random);
+		check(__utf32ToUtf8, __badUtf32, __random);
+		check(__utf32ToUtf16, __badUtf32, __random);
+		
+		if (Unicode::validateUtf8(__badUtf8.data(), __badUtf8.size()) != icuUtf8ToUtf16(__badUtf8, __utf16))
+			fail("validateUtf8", "differs from ICU", __badUtf8);
+		if (Unicode::validateUtf16(__badUtf16.data(), __badUtf16.size()) != icuUtf16ToUtf8(__badUtf16, __utf8))
+			fail("validateUtf16", "differs from ICU", bytesOf(__badUtf16));
+	}
+	
+	// sequences split by block boundary, as every offset puts them at another position in block
+	for (TSize __before {}; __before < 20; ++__before)
+	{
+		for (TSize __after : { 0UL, 1UL, 15UL, 16UL, 17UL })
+		{
+			for (const auto& __malformed : g_malformedUtf8)
+			{
+				check(__utf8ToUtf16, padded(__malformed, __before, __after), __random);
+				check(__utf8ToUtf32, padded(__malformed, __before, __after), __random);
+			}
+			for (const auto& __malformed : g_malformedUtf16)
+			{
+				check(__utf16ToUtf8, padded(__malformed, __before, __after), __random);
+				check(__utf16ToUtf32, padded(__malformed, __before, __after), __random);
+			}
+			for (const auto& __malformed : g_malformedUtf32)
+			{
+				check(__utf32ToUtf8, padded(__malformed, __before, __after), __random);
+				check(__utf32ToUtf16, padded(__malformed, __before, __after), __random);
+			}
+			
+			const TUtf8 __valid("\xC3\xA5\xE2\x82\xAC\xF0\x9F\x98\x80");
+			check(__utf8ToUtf16, padded(__valid, __before, __after), __random);
+			check(__utf8ToUtf32, padded(__valid, __before, __after), __random);
+			check(__utf16ToUtf8, padded(TUtf16(u"\x00E5\x20AC\xD83D\xDE00"), __before, __after), __random);
+			check(__utf16ToUtf32, padded(TUtf16(u"\x00E5\x20AC\xD83D\xDE00"), __before, __after), __random);
+		}
+	}
+	
+	std::printf("%zu checks with seed %u, %zu failures\n", g_checks, __seed, g_failures);
+	return g_failures ? 1 : 0;
+}
@@ -20,6 +20,7 @@ operator<<(std::ostream& out, const std::stringstream& ss)
 #include "Constants.hpp"
 #include "Database/Manager.hpp"
 #include "Database/Value.hpp"
+#include "Database/RowCursor.hpp"
 #include "OpenTranslate/Dictionary.hpp"
 
 using TDatabaseManager = Dixter::Database::TManager;
@@ -143,20 +144,21 @@ void readDB(TDatabaseManagerPtr dbManager,
 										   "category_1", "category_2", "category_3", "category_4",
 										   "category_5", "category_6", "category_7", "category_8",
 										   "category_9", "category_10", "category_11", "category_12" };
-	auto res = dbManager->selectColumns(table, __columns, 0);
+	// all columns but "id" are selected
+	Dixter::Database::TTextCursor __cursor(dbManager->selectColumns(table, __columns, 0),
+										   __columns.size() - 1);
 	
-	while (res->next())
+	while (__cursor.fetch())
 	{
-		uint32_t colIndex(1);
-		while (colIndex < __columns.size())
+		for (size_t __row {}; __row < __cursor.size(); ++__row)
 		{
-			__dat << res->getString(colIndex) << g_whiteSpace;
-			++colIndex;
+			for (size_t __colIndex {}; __colIndex < __cursor.columnsNum(); ++__colIndex)
+				__dat << __cursor.at(__row, __colIndex) << g_whiteSpace;
+			println(__dat)
+			__dat.str({});
 		}
-		++__counter;
-		println(__dat)
-		__dat.clear();
 	}
+	__counter += __cursor.count();
 	
 	print_log("Read about ")
 	prints(__counter)